@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "renderer/commands/DrawCommandBuffer.h"
+
+
+
+
+/*
+Measures how long it takes to record and sort a frame's worth of quad draw commands
+
+This does not need a window or an OpenGL context, so it can be run on any machine
+
+Usage: RenderQueueBenchmark [number of quads] [number of frames]
+*/
+int main(int argc, char** argv)
+{
+	const size_t numberOfQuads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000;
+	const int numberOfFrames = argc > 2 ? std::atoi(argv[2]) : 200;
+	const int numberOfTextures = 64;
+	const int numberOfLayers = 8;
+
+	std::mt19937 random(1337);
+	std::uniform_real_distribution<float> position(0.0f, 1280.0f);
+	std::uniform_int_distribution<int> texture(-1, numberOfTextures - 1);
+	std::uniform_int_distribution<int> layer(0, numberOfLayers - 1);
+
+	// The inputs are generated up front so that only the renderer's work is measured
+	std::vector<QuadDrawCommand> commands;
+	std::vector<uint64_t> keys;
+	commands.reserve(numberOfQuads);
+	keys.reserve(numberOfQuads);
+	for (size_t i = 0; i < numberOfQuads; i++)
+	{
+		float depth = layer(random) / static_cast<float>(numberOfLayers);
+		int textureID = texture(random);
+		commands.push_back({ { position(random), position(random), depth }, { 32.0f, 32.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, textureID, 0 });
+		keys.push_back(SortKey::make(SortKey::depthToLayer(depth), 0, textureID + 1, 0));
+	}
+
+	DrawCommandBuffer buffer;
+	double submitTime = 0.0, sortTime = 0.0;
+	for (int frame = 0; frame < numberOfFrames; frame++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < numberOfQuads; i++)
+			buffer.push(keys[i], commands[i]);
+
+		auto submitted = std::chrono::steady_clock::now();
+		buffer.sort();
+
+		auto sorted = std::chrono::steady_clock::now();
+		submitTime += std::chrono::duration<double, std::milli>(submitted - start).count();
+		sortTime += std::chrono::duration<double, std::milli>(sorted - submitted).count();
+
+		for (size_t i = 1; i < buffer.entries().size(); i++)
+		{
+			if (buffer.entries()[i - 1].key > buffer.entries()[i].key)
+			{
+				std::printf("Draw commands were not sorted correctly\n");
+				return EXIT_FAILURE;
+			}
+		}
+
+		buffer.clear();
+	}
+
+	double frameTime = (submitTime + sortTime) / numberOfFrames;
+	std::printf("Quads per frame:  %zu\n", numberOfQuads);
+	std::printf("Frames:           %d\n", numberOfFrames);
+	std::printf("Submit:           %.3f ms/frame\n", submitTime / numberOfFrames);
+	std::printf("Sort:             %.3f ms/frame\n", sortTime / numberOfFrames);
+	std::printf("Submit + sort:    %.3f ms/frame (%.1f million quads/s)\n", frameTime, numberOfQuads / (frameTime * 1000.0));
+
+	return EXIT_SUCCESS;
+}
+
+
+
@@ -0,0 +1,27 @@
+project "RenderQueueBenchmark"
+	kind "ConsoleApp"
+	language "C++"
+
+	targetdir ("%{wks.location}/dist/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/imt/" .. outputdir .. "/%{prj.name}")
+
+	files 
+	{ 
+		"RenderQueueBenchmark.cpp",
+		"%{wks.location}/GameFramework/src/renderer/commands/DrawCommandBuffer.h",
+		"%{wks.location}/GameFramework/src/renderer/commands/DrawCommandBuffer.cpp"
+	}
+
+	includedirs
+	{ 
+		"%{includes.GameFramework}",
+		"%{includes.glm}"
+	}
+
+	filter "system:windows"
+		cppdialect "C++17"
+		staticruntime "On"
+		systemversion "latest"
+
+	filter "configurations:Release"
+		optimize "On"
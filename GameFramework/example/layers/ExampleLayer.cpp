@@ -30,11 +30,10 @@ void ExampleLayer::onAttach(Application& app)
 {
 	app.worldStack().pushMap("tiletest", "data/map/test.map");
 
-	app.assetLibrarian().addTexture("data/gfx/Mario.png");
-	app.assetLibrarian().addTexture("data/gfx/flappy_bird_sprite_sheet.png");
-	app.assetLibrarian().addTexture("data/gfx/null.png");
-	app.assetLibrarian().addTexture("data/gfx/tile_test.png", { 16, 16 });
-	app.assetLibrarian().addTexture("data/gfx/overworld sheet.png", { 16, 16 });
+	app.assetLibrarian().enableTexturePacking();
+	app.assetLibrarian().loadTexturesAsync({ "data/gfx/Mario.png", "data/gfx/flappy_bird_sprite_sheet.png", "data/gfx/null.png" });
+	app.assetLibrarian().loadTextureAsync("data/gfx/tile_test.png", { 16, 16 });
+	app.assetLibrarian().loadTextureAsync("data/gfx/overworld sheet.png", { 16, 16 });
 
 	app.audioMixer().registerSample("hit01", "./data/sfx/hit01.wav");
 	app.audioMixer().setSampleVolume("hit01", 0.75f);
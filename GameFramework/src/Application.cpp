@@ -1,3 +1,4 @@
+#include <cmath>
 #include <iostream>
 
 #include <SDL.h>
@@ -10,12 +11,15 @@
 #include "events/KeyboardEvent.h"
 #include "audiomixer/AudioMixer.h"
 #include "entities/EntityJournal.hpp"
+#include "physics/PhysicsWorld.hpp"
 #include "renderer/Renderer.h"
+#include "renderer/RenderThread.h"
 #include "world/TileMap.h"
 #include "renderer/screen/Camera.h"
 #include "renderer/screen/Window.h"
 #include "world/WorldStack.h"
 #include "utilities/Assertions.h"
+#include "utilities/AssetCache.h"
 
 #include "events/MouseEvent.h"
 
@@ -23,7 +27,8 @@
 
 
 ApplicationBuilder::ApplicationBuilder()
-	: windowTitle(""), windowSize(640, 480), windowFlags(0), logFileLocation("./log.txt"), logLevel(spdlog::level::trace), tickRate(20)
+	: windowTitle(""), windowSize(640, 480), windowFlags(0), logFileLocation("./log.txt"), logLevel(spdlog::level::trace), tickRate(20), 
+	maxTicksPerFrame(5), rendererValidation(Renderer::DEFAULT_VALIDATION), renderThread(false), assetCacheDirectory("./cache")
 {}
 
 
@@ -56,8 +61,40 @@ ApplicationBuilder& ApplicationBuilder::setTickRate(unsigned int ticksIn)
 
 
 
+ApplicationBuilder& ApplicationBuilder::setMaxTicksPerFrame(unsigned int ticksIn)
+{
+	maxTicksPerFrame = ticksIn;
+	return *this;
+}
+
+
+
+ApplicationBuilder& ApplicationBuilder::setRendererValidation(Renderer::Validation validationIn)
+{
+	rendererValidation = validationIn;
+	return *this;
+}
+
+
+
+ApplicationBuilder& ApplicationBuilder::setRenderThread(bool enabledIn)
+{
+	renderThread = enabledIn;
+	return *this;
+}
+
+
+
+ApplicationBuilder& ApplicationBuilder::setAssetCache(const std::string& directoryIn)
+{
+	assetCacheDirectory = directoryIn;
+	return *this;
+}
+
+
+
 Application::Application(const ApplicationBuilder& builderIn)
-	: m_gameOver(false), m_tickRate(20) 
+	: m_gameOver(false), m_tickRate(builderIn.tickRate), m_maxTicksPerFrame(builderIn.maxTicksPerFrame), m_tickLength(0.0)
 {
 	spdlog::set_pattern("%^[%l] %n: %v - %x %T%$");
 	auto fileLogger = spdlog::basic_logger_mt("Core", "logs/log.txt");
@@ -70,9 +107,18 @@ Application::Application(const ApplicationBuilder& builderIn)
 
 	m_logger->info("Logging started");
 
+	GAME_ASSERT(m_tickRate > 0 && m_maxTicksPerFrame > 0);
+	m_tickLength = 1.0 / m_tickRate;
+
 	m_audioManager = std::make_unique<AudioMixer>();
 	m_worlds = std::make_unique<WorldStack>();
 	m_entities = std::make_unique<EntityJournal>();
+	m_physics = std::make_unique<PhysicsWorld>();
+	if (!builderIn.assetCacheDirectory.empty())
+	{
+		m_assetCache = std::make_shared<AssetCache>(builderIn.assetCacheDirectory);
+		m_worlds->setAssetCache(m_assetCache);
+	}
 
 	m_logger->info("Initializing SDL Video and Audio");
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0)
@@ -80,8 +126,15 @@ Application::Application(const ApplicationBuilder& builderIn)
 
 	SDL_GL_LoadLibrary(NULL);
 
+	// Debug messages are only guaranteed to be reported by a debug context
+	if (builderIn.rendererValidation == Renderer::Validation::Full)
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
+
 	GAME_ASSERT(builderIn.windowSize.w > 0 && builderIn.windowSize.h > 0);
 	this->initWindow(builderIn.windowTitle, builderIn.windowSize.w, builderIn.windowSize.h, builderIn.windowFlags);
+	this->renderer().setValidation(builderIn.rendererValidation);
+	if (builderIn.renderThread)
+		m_renderThread = std::make_unique<RenderThread>();
 
 	this->audioMixer().init();
 
@@ -104,8 +157,14 @@ Application::Application(const ApplicationBuilder& builderIn)
 Application::~Application() 
 {
 	EventBus::unsubscribe<WindowEvent>(m_onWindowEvent);
+	m_renderThread.reset();
 	renderer().shutdown();
 	m_window->shutdown();
+	if (m_assetCache)
+	{
+		const AssetCache::Statistics statistics = m_assetCache->getStatistics();
+		m_logger->info("Asset cache: {0} hits, {1} misses, {2} stores", statistics.hits, statistics.misses, statistics.stores);
+	}
 	m_logger->info("Terminating SDL");
 	SDL_Quit();
 }
@@ -116,6 +175,9 @@ void Application::initWindow(const std::string& titleIn, int widthIn, int height
 {
 	m_window = std::make_unique<Window>(titleIn, Pos2N(widthIn, heightIn), flags);
 	m_renderer = std::make_unique<Renderer>();
+
+	// The cache has to be in place before the renderer's shaders are compiled
+	this->renderer().assetLibrarian().setAssetCache(m_assetCache);
 	this->renderer().init(1000);
 	m_camera = std::make_shared<Camera>(static_cast<float>(widthIn), static_cast<float>(heightIn));
 }
@@ -125,6 +187,11 @@ void Application::initWindow(const std::string& titleIn, int widthIn, int height
 void Application::run() 
 {
 	m_timer.start();
+	m_tickAccumulator = 0.0;
+
+	// Layers have set up all of their OpenGL resources by now, so the context can be given to the render thread
+	if (m_renderThread)
+		m_renderThread->start(*m_window, *m_renderer);
 
 	while (!this->isDone())
 	{
@@ -144,32 +211,58 @@ void Application::run()
 				break;
 			}
 		}
-		
+
+		//Logic loop for all layers, ticks always advance by the same amount so they play out the same at any frame rate
+		m_tickAccumulator += m_timer.lap();
+		const float deltaTime = static_cast<float>(m_tickLength);
+		unsigned int ticks = 0;
+		while (m_tickAccumulator >= m_tickLength && ticks < m_maxTicksPerFrame)
+		{
+			m_entities->updateSystems(deltaTime);
+			m_physics->step(*m_entities, deltaTime);
+			for (auto& layer : m_layerStack)
+			{
+				if (layer->isActive())
+					layer->onTick(*m_camera.get(), deltaTime);
+			}
+			m_tickAccumulator -= m_tickLength;
+			ticks++;
+		}
+
+		// Catching up on every missed tick would only make the next frame later still, so time past the cap is dropped
+		if (m_tickAccumulator >= m_tickLength)
+		{
+			const double droppedTicks = std::floor(m_tickAccumulator / m_tickLength);
+			m_logger->debug("Running behind, dropped {0} ticks", droppedTicks);
+			m_tickAccumulator -= droppedTicks * m_tickLength;
+		}
+
 		m_camera->update();
+		m_worlds->update(*m_camera);
 
 		//Render loop for all layers
+		const float alpha = getTickAlpha();
 		for (auto& layer : m_layerStack)
 		{
 			if (layer->isActive())
-				layer->onRender(m_camera, *m_renderer.get());
+				layer->onRender(m_camera, *m_renderer.get(), alpha);
 		}
 
-		m_window->update();
-
-		//Logic loop for all layers
-		if (m_timer.getMil() >= m_tickRate)
+		// With a render thread, the frame is drawn and presented while the logic loop runs
+		if (m_renderThread)
+			m_renderThread->submitFrame();
+		else
 		{
-			for (auto& layer : m_layerStack)
-			{
-				if (layer->isActive())
-					layer->onTick(*m_camera.get(), m_timer.getSec());
-			}
-			m_timer.start();
+			m_renderer->endFrame();
+			m_window->update();
 		}
 
 		EventBus::dispatchAllEvents();
 	}
 
+	if (m_renderThread)
+		m_renderThread->stop();
+
 	m_timer.stop();
 }
 
@@ -211,6 +304,20 @@ glm::ivec2 Application::getMouseLocation()
 
 
 
+float Application::getTickLength() const
+{
+	return static_cast<float>(m_tickLength);
+}
+
+
+
+float Application::getTickAlpha() const
+{
+	return static_cast<float>(m_tickAccumulator / m_tickLength);
+}
+
+
+
 Renderer& Application::renderer()
 {
 	return *m_renderer.get();
@@ -253,6 +360,13 @@ EntityJournal& Application::entities()
 
 
 
+PhysicsWorld& Application::physicsWorld()
+{
+	return *m_physics.get();
+}
+
+
+
 const Window* Application::getWindow() const 
 {
 	return m_window.get();
@@ -267,3 +381,10 @@ Camera* Application::getCamera()
 
 
 
+const RenderThread* Application::getRenderThread() const
+{
+	return m_renderThread.get();
+}
+
+
+
@@ -12,6 +12,7 @@
 #include "utilities/math/Pos2.hpp"
 #include "layers/LayerStack.hpp"
 #include "renderer/AssetLibrarian.h"
+#include "renderer/Renderer.h"
 #include "utilities/Timer.h"
 
 
@@ -57,6 +58,47 @@ struct ApplicationBuilder
 
 
 
+	/// <summary>
+	/// Sets the most ticks that can run before a frame is rendered, when the application falls further behind than this the rest of the lag is dropped
+	/// </summary>
+	/// <param name="ticksIn">Specifies the maximum number of ticks per frame</param>
+	/// <returns>A referance to this ApplicationBuilder</returns>
+	ApplicationBuilder& setMaxTicksPerFrame(unsigned int ticksIn);
+
+
+
+	/// <summary>
+	/// Sets how often the renderer validates shader programs
+	/// <para>By default programs are fully validated in debug builds and validated once per state in release builds</para>
+	/// </summary>
+	/// <param name="validationIn">Specifies the renderer's validation mode</param>
+	/// <returns>A referance to this ApplicationBuilder</returns>
+	ApplicationBuilder& setRendererValidation(Renderer::Validation validationIn);
+
+
+
+	/// <summary>
+	/// Sets if frames are drawn on a dedicated render thread that owns the OpenGL context
+	/// <para>
+	/// When enabled, layers must not make OpenGL calls from Application::run's loop, any work that needs the context has to be 
+	/// queued with Renderer::enqueueTask
+	/// </para>
+	/// </summary>
+	/// <param name="enabledIn">Specifies if the render thread is used, by default it is not</param>
+	/// <returns>A referance to this ApplicationBuilder</returns>
+	ApplicationBuilder& setRenderThread(bool enabledIn);
+
+
+
+	/// <summary>
+	/// Sets where decoded textures, linked shader programs, and converted maps are cached between launches
+	/// </summary>
+	/// <param name="directoryIn">Specifies the cache's directory, when empty nothing is cached</param>
+	/// <returns>A referance to this ApplicationBuilder</returns>
+	ApplicationBuilder& setAssetCache(const std::string& directoryIn);
+
+
+
 	/// <summary>
 	/// Determines the name of the application's window
 	/// </summary>
@@ -98,6 +140,36 @@ struct ApplicationBuilder
 	/// <para>By default it is 20 ticks per second</para>
 	/// </summary>
 	unsigned int tickRate;
+
+
+
+	/// <summary>
+	/// Determines the most ticks that can run before a frame is rendered
+	/// <para>By default it is 5 ticks</para>
+	/// </summary>
+	unsigned int maxTicksPerFrame;
+
+
+
+	/// <summary>
+	/// Determines how often the renderer validates shader programs
+	/// </summary>
+	Renderer::Validation rendererValidation;
+
+
+
+	/// <summary>
+	/// Determines if frames are drawn on a dedicated render thread
+	/// </summary>
+	bool renderThread;
+
+
+
+	/// <summary>
+	/// Determines where assets are cached between launches, when empty nothing is cached
+	/// <para>By default assets are cached in './cache'</para>
+	/// </summary>
+	std::string assetCacheDirectory;
 };
 
 
@@ -127,6 +199,9 @@ public:
 	
 	/// <summary>
 	/// Starts the application loop which will continue running until Application::markOver is called
+	/// <para>
+	/// Layers, entity systems, and physics are ticked at a fixed rate however long each frame takes, and frames are rendered as often as possible in between
+	/// </para>
 	/// </summary>
 	void run();
 
@@ -164,6 +239,22 @@ public:
 
 
 
+	/// <summary>
+	/// Gets the number of seconds between ticks
+	/// </summary>
+	/// <returns></returns>
+	float getTickLength() const;
+
+
+
+	/// <summary>
+	/// Gets how far the current frame is from the last tick to the next one, from 0 to 1
+	/// </summary>
+	/// <returns></returns>
+	float getTickAlpha() const;
+
+
+
 	/// <summary>
 	/// Gets this application's renderer
 	/// </summary>
@@ -208,6 +299,13 @@ public:
 
 
 
+	/// <summary>
+	/// Gets this application's physics world, it moves every entity with a RigidbodyCapability once per tick
+	/// </summary>
+	class PhysicsWorld& physicsWorld();
+
+
+
 	/// <summary>
 	/// <para>nullable</para>
 	/// Gets this application's Window
@@ -224,6 +322,15 @@ public:
 
 
 
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets this application's render thread, which only exists when it was enabled by the ApplicationBuilder
+	/// </summary>
+	/// <returns></returns>
+	const class RenderThread* getRenderThread() const;
+
+
+
 private:
 
 	/// <summary>
@@ -252,8 +359,14 @@ private:
 
 	std::unique_ptr<class EntityJournal> m_entities;
 
+	std::unique_ptr<class PhysicsWorld> m_physics;
+
 	std::unique_ptr<class Window> m_window;
 
+	std::unique_ptr<class RenderThread> m_renderThread;
+
+	std::shared_ptr<class AssetCache> m_assetCache;
+
 	std::shared_ptr<class Camera> m_camera;
 
 	Timer m_timer;
@@ -262,6 +375,12 @@ private:
 
 	unsigned int m_tickRate;
 
+	unsigned int m_maxTicksPerFrame;
+
+	double m_tickLength;
+
+	double m_tickAccumulator = 0.0;
+
 	int m_onWindowEvent = 0;
 };
 
@@ -3,6 +3,7 @@
 
 
 #include <memory>
+#include <type_traits>
 
 #include <entt/entt.hpp>
 
@@ -62,6 +63,7 @@ public:
 	template<typename Capability>
 	Capability& get()
 	{
+		static_assert(!std::is_same_v<Capability, PositionCapability>, "Positions are changed with setPos or move so the journal's spatial index follows them");
 		GAME_ASSERT(has<Capability>());
 		return m_registry.lock()->get<Capability>(m_id);
 	}
@@ -71,7 +73,7 @@ public:
 	template<typename Capability>
 	const Capability& get() const
 	{
-		GAME_ASSERT(!has<Capability>());
+		GAME_ASSERT(has<Capability>());
 		return m_registry.lock()->get<Capability>(m_id);
 	}
 
@@ -113,16 +115,31 @@ public:
 	/// 
 	/// </summary>
 	/// <returns></returns>
-	inline Pos2D& pos()
+	inline const Pos2D& pos() const
 	{
 		return get<PositionCapability>().pos;
 	}
 
 
 
-	inline const Pos2D& pos() const
+	/// <summary>
+	/// Moves this entity to the given position, patching it so that the journal's spatial index follows the entity
+	/// </summary>
+	/// <param name="posIn"></param>
+	inline void setPos(const Pos2D& posIn)
 	{
-		return get<PositionCapability>().pos;
+		m_registry.lock()->patch<PositionCapability>(m_id, [&posIn](PositionCapability& positionIn) { positionIn.pos = posIn; });
+	}
+
+
+
+	/// <summary>
+	/// Moves this entity by the given offset, patching it so that the journal's spatial index follows the entity
+	/// </summary>
+	/// <param name="offsetIn"></param>
+	inline void move(const Pos2D& offsetIn)
+	{
+		m_registry.lock()->patch<PositionCapability>(m_id, [&offsetIn](PositionCapability& positionIn) { positionIn.pos += offsetIn; });
 	}
 
 
@@ -138,6 +155,17 @@ public:
 
 
 
+	/// <summary>
+	/// Gets the interned identifier of this entity's tag
+	/// </summary>
+	/// <returns></returns>
+	inline TagId tagId() const
+	{
+		return get<TagCapability>().id();
+	}
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -185,11 +213,11 @@ public:
 				deltaFrict = 1.0f;
 
 			Pos2D& vec = get<KinematicCapability>().velocity;
-			Pos2D& pos = this->pos();
 			Pos2D deltaPos = vec * deltaTime;
-			pos += deltaPos;
 			vec *= deltaFrict;
 
+			move(deltaPos);
+
 			if (has<ColliderCapability>())
 			{
 				AxisAlignedBB& aabb = get<ColliderCapability>().aabb;
@@ -1,12 +1,24 @@
 #include "EntityJournal.hpp"
-#include "utilities/physics/Collisions.h"
 
 
 
 
+static size_t s_slot(entt::entity entityIn) 
+{ 
+	return static_cast<size_t>(entt::to_integral(entityIn) & entt::entt_traits<entt::entity>::entity_mask); 
+}
+
+
+
 EntityJournal::EntityJournal()
 {
 	m_entityRegistry = std::make_shared<entt::registry>();
+	m_entityRegistry->on_construct<PositionCapability>().connect<&EntityJournal::onPositionChanged>(*this);
+	m_entityRegistry->on_update<PositionCapability>().connect<&EntityJournal::onPositionChanged>(*this);
+	m_entityRegistry->on_destroy<PositionCapability>().connect<&EntityJournal::onPositionRemoved>(*this);
+	m_entityRegistry->on_construct<TagCapability>().connect<&EntityJournal::onTagAdded>(*this);
+	m_entityRegistry->on_update<TagCapability>().connect<&EntityJournal::onTagChanged>(*this);
+	m_entityRegistry->on_destroy<TagCapability>().connect<&EntityJournal::onTagRemoved>(*this);
 	m_logger = Loggers::getLog();
 	m_logger->info("Entity Journal has been initialized");
 }
@@ -15,22 +27,38 @@ EntityJournal::EntityJournal()
 
 EntityJournal::~EntityJournal()
 {
+	// Entities can outlive the journal, so the registry must not call back into it
+	m_entityRegistry->on_construct<PositionCapability>().disconnect<&EntityJournal::onPositionChanged>(*this);
+	m_entityRegistry->on_update<PositionCapability>().disconnect<&EntityJournal::onPositionChanged>(*this);
+	m_entityRegistry->on_destroy<PositionCapability>().disconnect<&EntityJournal::onPositionRemoved>(*this);
+	m_entityRegistry->on_construct<TagCapability>().disconnect<&EntityJournal::onTagAdded>(*this);
+	m_entityRegistry->on_update<TagCapability>().disconnect<&EntityJournal::onTagChanged>(*this);
+	m_entityRegistry->on_destroy<TagCapability>().disconnect<&EntityJournal::onTagRemoved>(*this);
 	m_logger->info("Entity Journal stopped");
 }
 
 
 
 Entity EntityJournal::spawn(std::string tag, const Pos2D& pos)
+{
+	return spawn(TagRegistry::intern(tag), pos);
+}
+
+
+
+Entity EntityJournal::spawn(TagId tagIn, const Pos2D& pos)
 {
 	Entity entity(m_entityRegistry, m_entityRegistry->create());
 	m_entityRegistry->emplace<PositionCapability>(entity.guid(), pos.x, pos.y);
-	m_entityRegistry->emplace<TagCapability>(entity.guid(), tag);
+	m_entityRegistry->emplace<TagCapability>(entity.guid(), tagIn);
 
-	if (m_entityFactoryRegistry.find(tag) != m_entityFactoryRegistry.end())
-		m_entityFactoryRegistry[tag](entity);
+	// Every tag that is spawned has an entry by now, since adding the tag capability indexed the entity
+	const TagEntry& entry = m_tags[tagIn];
+	if (entry.spawner)
+		entry.spawner(entity);
 
-	if (m_onSpawnRegistry.find(tag) != m_onSpawnRegistry.end())
-		m_onSpawnRegistry[tag](entity);
+	if (entry.onSpawn)
+		entry.onSpawn(entity);
 
 	return entity;
 }
@@ -41,7 +69,7 @@ Entity EntityJournal::spawn(const Pos2D& pos)
 {
 	Entity entity(m_entityRegistry, m_entityRegistry->create());
 	m_entityRegistry->emplace<PositionCapability>(entity.guid(), pos.x, pos.y);
-	m_entityRegistry->emplace<TagCapability>(entity.guid(), "unknown");
+	m_entityRegistry->emplace<TagCapability>(entity.guid(), TagRegistry::UNKNOWN);
 	return entity;
 }
 
@@ -49,8 +77,9 @@ Entity EntityJournal::spawn(const Pos2D& pos)
 
 void EntityJournal::despawn(Entity& entity)
 {
-	if (m_onDespawnRegistry.find(entity.tag()) != m_onDespawnRegistry.end())
-		m_onDespawnRegistry[entity.tag()](entity);
+	const TagEntry& entry = m_tags[m_entityRegistry->get<TagCapability>(entity.guid()).id()];
+	if (entry.onDespawn)
+		entry.onDespawn(entity);
 
 	m_entityRegistry->destroy(entity.guid());
 }
@@ -60,10 +89,7 @@ void EntityJournal::despawn(Entity& entity)
 void EntityJournal::despawn(entt::entity entity)
 {
 	Entity temp(m_entityRegistry, entity);
-	if (m_onDespawnRegistry.find(temp.tag()) != m_onDespawnRegistry.end())
-		m_onDespawnRegistry[temp.tag()](temp);
-
-	m_entityRegistry->destroy(entity);
+	despawn(temp);
 }
 
 
@@ -71,14 +97,121 @@ void EntityJournal::despawn(entt::entity entity)
 std::vector<Entity> EntityJournal::getEntities(const AxisAlignedBB& area)
 {
 	std::vector<Entity> entities;
-	auto views = m_entityRegistry->view<PositionCapability>();
-	for (auto entity : views)
+	m_spatialGrid.query(area, [this, &entities](entt::entity entity) { entities.emplace_back(m_entityRegistry, entity); });
+	return entities;
+}
+
+
+
+void EntityJournal::getEntities(const AxisAlignedBB& areaIn, std::vector<entt::entity>& entitiesOut) const
+{
+	m_spatialGrid.query(areaIn, entitiesOut);
+}
+
+
+
+void EntityJournal::updateSystems(float deltaTime)
+{
+	const size_t numberOfSystems = m_systems.size();
+	if (numberOfSystems == 0)
+		return;
+
+	// Each system depends on the systems before it that it conflicts with, so conflicting systems keep the order they were added in
+	std::vector<std::vector<size_t>> dependents(numberOfSystems);
+	std::unique_ptr<std::atomic<size_t>[]> remaining(new std::atomic<size_t>[numberOfSystems]);
+	for (size_t system = 0; system < numberOfSystems; system++)
 	{
-		PositionCapability& pos = views.get<PositionCapability>(entity);
-		if (Collision::RectVsPt(area, pos))
-			entities.emplace_back(m_entityRegistry, entity);
+		size_t dependencies = 0;
+		for (size_t before = 0; before < system; before++)
+		{
+			if (m_systems[system]->conflictsWith(*m_systems[before]))
+			{
+				dependents[before].push_back(system);
+				dependencies++;
+			}
+		}
+		remaining[system] = dependencies;
 	}
-	return entities;
+
+	// Views make their pools the first time they are used, which must not happen on several threads at once
+	for (const auto& system : m_systems)
+		system->preparePools(*m_entityRegistry);
+
+	WorkStealingPool& workers = getWorkers();
+	deferSpatialIndex();
+	std::atomic<size_t> unfinished{ numberOfSystems };
+	std::function<void(size_t)> run = [&](size_t systemIn)
+	{
+		m_systems[systemIn]->onUpdate(*this, deltaTime);
+		for (size_t dependent : dependents[systemIn])
+		{
+			if (--remaining[dependent] == 0)
+				workers.submit([&run, dependent]() { run(dependent); });
+		}
+		unfinished--;
+	};
+
+	// The systems without dependencies are found before any are started, since a running system can bring a later system's 
+	// count to zero and submit it itself
+	std::vector<size_t> roots;
+	for (size_t system = 0; system < numberOfSystems; system++)
+	{
+		if (remaining[system] == 0)
+			roots.push_back(system);
+	}
+
+	for (size_t system : roots)
+		workers.submit([&run, system]() { run(system); });
+	workers.wait(unfinished);
+	resumeSpatialIndex();
+}
+
+
+
+WorkStealingPool& EntityJournal::getWorkers()
+{
+	if (!m_workers)
+		m_workers = std::make_unique<WorkStealingPool>();
+	return *m_workers;
+}
+
+
+
+void EntityJournal::deferSpatialIndex()
+{
+	m_spatialIndexDeferrals++;
+}
+
+
+
+void EntityJournal::resumeSpatialIndex()
+{
+	if (--m_spatialIndexDeferrals > 0)
+		return;
+
+	// An entity may have been moved more than once, or destroyed, since it was queued
+	for (entt::entity entity : m_movedEntities)
+	{
+		if (m_entityRegistry->valid(entity) && m_entityRegistry->has<PositionCapability>(entity))
+			m_spatialGrid.insert(entity, m_entityRegistry->get<PositionCapability>(entity).pos);
+	}
+	m_movedEntities.clear();
+}
+
+
+
+void EntityJournal::markMoved(const std::vector<entt::entity>& entitiesIn)
+{
+	GAME_ASSERT(m_spatialIndexDeferrals > 0);
+	std::lock_guard<std::mutex> lock(m_movedEntitiesLock);
+	m_movedEntities.insert(m_movedEntities.end(), entitiesIn.begin(), entitiesIn.end());
+}
+
+
+
+void EntityJournal::setSpatialCellSize(double cellSizeIn)
+{
+	m_spatialGrid.setCellSize(cellSizeIn);
 }
 
 
@@ -92,21 +225,113 @@ size_t EntityJournal::count() const
 
 void EntityJournal::registerSpawner(const std::string& tagIn, Callback callbackIn)
 {
-	m_entityFactoryRegistry.insert({ tagIn, callbackIn });
+	TagEntry& entry = getTagEntry(TagRegistry::intern(tagIn));
+	if (!entry.spawner)
+		entry.spawner = std::move(callbackIn);
 }
 
 
 
 void EntityJournal::registerOnSpawn(const std::string& tagIn, Callback callbackIn)
 {
-	m_onSpawnRegistry.insert({ tagIn, callbackIn });
+	TagEntry& entry = getTagEntry(TagRegistry::intern(tagIn));
+	if (!entry.onSpawn)
+		entry.onSpawn = std::move(callbackIn);
 }
 
 
 
 void EntityJournal::registerOnDespawn(const std::string& tagIn, Callback callbackIn)
 {
-	m_onDespawnRegistry.insert({ tagIn, callbackIn });
+	TagEntry& entry = getTagEntry(TagRegistry::intern(tagIn));
+	if (!entry.onDespawn)
+		entry.onDespawn = std::move(callbackIn);
+}
+
+
+
+const std::vector<entt::entity>& EntityJournal::getEntitiesWithTag(TagId tagIn) const
+{
+	static const std::vector<entt::entity> s_none;
+	return tagIn < m_tags.size() ? m_tags[tagIn].entities : s_none;
+}
+
+
+
+const std::vector<entt::entity>& EntityJournal::getEntitiesWithTag(const std::string& tagIn) const
+{
+	return getEntitiesWithTag(TagRegistry::find(tagIn));
+}
+
+
+
+void EntityJournal::onPositionChanged(entt::registry& registryIn, entt::entity entityIn)
+{
+	if (m_spatialIndexDeferrals > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_movedEntitiesLock);
+		m_movedEntities.push_back(entityIn);
+		return;
+	}
+
+	m_spatialGrid.insert(entityIn, registryIn.get<PositionCapability>(entityIn).pos);
+}
+
+
+
+void EntityJournal::onPositionRemoved(entt::registry&, entt::entity entityIn)
+{
+	m_spatialGrid.remove(entityIn);
+}
+
+
+
+void EntityJournal::onTagAdded(entt::registry& registryIn, entt::entity entityIn)
+{
+	const TagId tag = registryIn.get<TagCapability>(entityIn).id();
+	TagEntry& entry = getTagEntry(tag);
+	const size_t index = s_slot(entityIn);
+	if (index >= m_tagSlots.size())
+		m_tagSlots.resize(index + 1);
+
+	m_tagSlots[index] = { tag, static_cast<uint32_t>(entry.entities.size()) };
+	entry.entities.push_back(entityIn);
+}
+
+
+
+void EntityJournal::onTagChanged(entt::registry& registryIn, entt::entity entityIn)
+{
+	onTagRemoved(registryIn, entityIn);
+	onTagAdded(registryIn, entityIn);
+}
+
+
+
+void EntityJournal::onTagRemoved(entt::registry&, entt::entity entityIn)
+{
+	const size_t index = s_slot(entityIn);
+	if (index >= m_tagSlots.size() || m_tagSlots[index].tag == TagRegistry::INVALID)
+		return;
+
+	// The last entity with the tag takes the removed entity's place
+	TagSlot& slot = m_tagSlots[index];
+	std::vector<entt::entity>& entities = m_tags[slot.tag].entities;
+	entities[slot.index] = entities.back();
+	m_tagSlots[s_slot(entities[slot.index])].index = slot.index;
+	entities.pop_back();
+	slot.tag = TagRegistry::INVALID;
+}
+
+
+
+EntityJournal::TagEntry& EntityJournal::getTagEntry(TagId tagIn)
+{
+	GAME_ASSERT(tagIn != TagRegistry::INVALID);
+	if (tagIn >= m_tags.size())
+		m_tags.resize(static_cast<size_t>(tagIn) + 1);
+
+	return m_tags[tagIn];
 }
 
 
@@ -6,12 +6,19 @@
 #include <functional>
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <type_traits>
 
 #include <entt/entt.hpp>
 
 #include "utilities/Loggers.hpp"
 #include "entities/Entity.hpp"
+#include "entities/SpatialGrid.h"
+#include "entities/TagRegistry.h"
+#include "entities/EntitySystem.hpp"
+#include "utilities/WorkStealingPool.h"
 
 
 
@@ -40,6 +47,16 @@ public:
 
 
 
+	/// <summary>
+	/// Spawns an entity with an already interned tag, which skips looking the tag's text up
+	/// </summary>
+	/// <param name="tagIn">Specifies an identifier returned by TagRegistry::intern</param>
+	/// <param name="pos"></param>
+	/// <returns></returns>
+	Entity spawn(TagId tagIn, const struct Pos2D& pos);
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -87,6 +104,21 @@ public:
 
 
 
+	/// <summary>
+	/// Changes an entity's capability in place and lets everything that is listening for changes to it know
+	/// </summary>
+	/// <typeparam name="Capability"></typeparam>
+	/// <typeparam name="...Func">void(Capability&)</typeparam>
+	/// <param name="entity"></param>
+	/// <param name="...func">Specifies the changes to make</param>
+	template<typename Capability, typename... Func>
+	void patch(entt::entity entity, Func&&... func)
+	{
+		m_entityRegistry->patch<Capability>(entity, std::forward<Func>(func)...);
+	}
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -110,7 +142,7 @@ public:
 	template<typename... Capability, typename... Exclude>
 	entt::basic_view<entt::entity, entt::exclude_t<Exclude...>, Capability...> view(entt::exclude_t<Exclude...> = {})
 	{
-		return m_entityRegistry->view<Capability...>(entt::exclude_t<Exclude...>);
+		return m_entityRegistry->view<Capability...>(entt::exclude_t<Exclude...>{});
 	}
 
 
@@ -118,13 +150,14 @@ public:
 	template<typename... Capability, typename... Exclude>
 	entt::basic_view<entt::entity, entt::exclude_t<Exclude...>, Capability...> view(entt::exclude_t<Exclude...> = {}) const
 	{
-		return m_entityRegistry->view<Capability...>(entt::exclude_t<Exclude...>);
+		return m_entityRegistry->view<Capability...>(entt::exclude_t<Exclude...>{});
 	}
 
 
 
 	/// <summary>
-	/// 
+	/// Gets every entity whose position is inside of the given area
+	/// <para>Prefer the overload that fills a list, or forEachEntity, when querying often</para>
 	/// </summary>
 	/// <param name="area"></param>
 	/// <returns></returns>
@@ -132,6 +165,124 @@ public:
 
 
 
+	/// <summary>
+	/// Fills the given list with every entity whose position is inside of the given area
+	/// </summary>
+	/// <param name="areaIn"></param>
+	/// <param name="entitiesOut">Cleared and then filled, its memory is reused between queries</param>
+	void getEntities(const class AxisAlignedBB& areaIn, std::vector<entt::entity>& entitiesOut) const;
+
+
+
+	/// <summary>
+	/// Visits every entity whose position is inside of the given area, without allocating
+	/// </summary>
+	/// <typeparam name="Function">void(entt::entity)</typeparam>
+	/// <param name="areaIn"></param>
+	/// <param name="functionIn">Called once for each entity inside of the area, it must not spawn, despawn, or move entities</param>
+	template<typename Function>
+	void forEachEntity(const class AxisAlignedBB& areaIn, Function&& functionIn) const
+	{
+		m_spatialGrid.query(areaIn, std::forward<Function>(functionIn));
+	}
+
+
+
+	/// <summary>
+	/// Gets every entity with the given tag, without searching the registry
+	/// <para>The list changes as entities are spawned and despawned, so copy it before doing either while going through it</para>
+	/// </summary>
+	/// <param name="tagIn"></param>
+	/// <returns></returns>
+	const std::vector<entt::entity>& getEntitiesWithTag(TagId tagIn) const;
+
+
+
+	/// <summary>
+	/// Gets every entity with the given tag, without searching the registry
+	/// </summary>
+	/// <param name="tagIn"></param>
+	/// <returns></returns>
+	const std::vector<entt::entity>& getEntitiesWithTag(const std::string& tagIn) const;
+
+
+
+	/// <summary>
+	/// Adds a system to the end of the journal's systems, it is run by every call to updateSystems from then on
+	/// </summary>
+	/// <typeparam name="SystemType"></typeparam>
+	/// <typeparam name="...Args"></typeparam>
+	/// <param name="...args">Specifies constructor arguments</param>
+	/// <returns>The new system</returns>
+	template<class SystemType, typename... Args>
+	SystemType& addSystem(Args&&... args)
+	{
+		m_systems.emplace_back(std::make_unique<SystemType>(std::forward<Args>(args)...));
+		return static_cast<SystemType&>(*m_systems.back());
+	}
+
+
+
+	/// <summary>
+	/// Runs every system once, systems that do not conflict are run at the same time on the worker threads
+	/// <para>
+	/// A system waits for every system that was added before it and conflicts with it. The calling thread works on 
+	/// the systems as well and returns once all of them have finished
+	/// </para>
+	/// </summary>
+	/// <param name="deltaTime"></param>
+	void updateSystems(float deltaTime);
+
+
+
+	/// <summary>
+	/// Calls the given function for every entity with all of the given capabilities, spread across the worker threads in chunks
+	/// <para>The function is called from several threads at once, so it must only touch the entity it is given</para>
+	/// <para>
+	/// Asking for a PositionCapability queues every visited entity to be put back into the spatial index afterwards, ask 
+	/// for a const PositionCapability when positions are only read
+	/// </para>
+	/// </summary>
+	/// <typeparam name="...Capability">A capability can be const, it is then handed to the function as const</typeparam>
+	/// <typeparam name="Function">void(entt::entity, Capability&...)</typeparam>
+	/// <param name="functionIn"></param>
+	/// <param name="chunkSizeIn">Specifies the smallest number of entities that are given to a thread at once</param>
+	template<typename... Capability, typename Function>
+	void parallelEach(Function&& functionIn, size_t chunkSizeIn = 256)
+	{
+		auto entities = m_entityRegistry->view<std::remove_const_t<Capability>...>();
+		std::vector<entt::entity> list(entities.begin(), entities.end());
+		deferSpatialIndex();
+		getWorkers().parallelFor(list.size(), chunkSizeIn, [&entities, &list, &functionIn](size_t beginIn, size_t endIn)
+			{
+				for (size_t i = beginIn; i < endIn; i++)
+					functionIn(list[i], static_cast<Capability&>(entities.template get<std::remove_const_t<Capability>>(list[i]))...);
+			});
+
+		// Positions were handed out to be written directly, so they can not be followed through patch
+		if constexpr ((std::is_same_v<Capability, PositionCapability> || ...))
+			markMoved(list);
+		resumeSpatialIndex();
+	}
+
+
+
+	/// <summary>
+	/// Gets the worker threads that systems are run on, they are started the first time they are needed
+	/// </summary>
+	/// <returns></returns>
+	WorkStealingPool& getWorkers();
+
+
+
+	/// <summary>
+	/// Changes the size of the spatial index's cells, they should be about the size of the areas that are queried most often
+	/// </summary>
+	/// <param name="cellSizeIn">Specifies the width and height of each cell measured in pixels</param>
+	void setSpatialCellSize(double cellSizeIn);
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -169,15 +320,116 @@ public:
 
 private:
 
+	/// <summary>
+	/// Queues moved entities instead of indexing them straight away, since the spatial index is not safe to change from 
+	/// several worker threads at once
+	/// </summary>
+	void deferSpatialIndex();
+
+
+
+	/// <summary>
+	/// Indexes the entities that were moved since the matching call to EntityJournal::deferSpatialIndex, once the outermost 
+	/// deferral has ended
+	/// </summary>
+	void resumeSpatialIndex();
+
+
+
+	/// <summary>
+	/// Queues the given entities to be put back into the spatial index, the index must be deferred
+	/// </summary>
+	/// <param name="entitiesIn"></param>
+	void markMoved(const std::vector<entt::entity>& entitiesIn);
+
+
+
+	void onPositionChanged(entt::registry& registryIn, entt::entity entityIn);
+
+
+
+	void onPositionRemoved(entt::registry& registryIn, entt::entity entityIn);
+
+
+
+	void onTagAdded(entt::registry& registryIn, entt::entity entityIn);
+
+
+
+	void onTagChanged(entt::registry& registryIn, entt::entity entityIn);
+
+
+
+	void onTagRemoved(entt::registry& registryIn, entt::entity entityIn);
+
+
+
+	/// <summary>
+	/// Everything that is kept for one tag
+	/// </summary>
+	struct TagEntry
+	{
+		Callback spawner;
+
+		Callback onSpawn;
+
+		Callback onDespawn;
+
+		std::vector<entt::entity> entities;
+	};
+
+
+
+	/// <summary>
+	/// Where an entity is in its tag's list of entities
+	/// </summary>
+	struct TagSlot
+	{
+		TagId tag = TagRegistry::INVALID;
+
+		uint32_t index = 0;
+	};
+
+
+
+	TagEntry& getTagEntry(TagId tagIn);
+
+
+
 	std::shared_ptr<spdlog::logger> m_logger;
 
 	std::shared_ptr<entt::registry> m_entityRegistry;
 
-	std::unordered_map<std::string, Callback> m_entityFactoryRegistry;
+	/// <summary>
+	/// Each tag's callbacks and entities by its TagId, a deque so that callbacks can register new tags while they are being called
+	/// </summary>
+	std::deque<TagEntry> m_tags;
+
+	/// <summary>
+	/// Where each entity is in its tag's list, by the entity's index
+	/// </summary>
+	std::vector<TagSlot> m_tagSlots;
+
+	/// <summary>
+	/// Every entity with a position, by its position
+	/// </summary>
+	SpatialGrid m_spatialGrid;
+
+	/// <summary>
+	/// The number of updates that are running on the worker threads, entities moved while it is not zero are queued
+	/// </summary>
+	std::atomic<int> m_spatialIndexDeferrals{ 0 };
+
+	std::mutex m_movedEntitiesLock;
+
+	/// <summary>
+	/// Entities that were moved while the spatial index was deferred, only these are indexed afterwards
+	/// </summary>
+	std::vector<entt::entity> m_movedEntities;
 
-	std::unordered_map<std::string, Callback> m_onSpawnRegistry;
+	std::vector<std::unique_ptr<EntitySystem>> m_systems;
 
-	std::unordered_map<std::string, Callback> m_onDespawnRegistry;
+	std::unique_ptr<WorkStealingPool> m_workers;
 };
 
 
@@ -0,0 +1,145 @@
+#ifndef EntitySystem_HPP_
+#define EntitySystem_HPP_
+
+
+#include <vector>
+#include <algorithm>
+
+#include <entt/entt.hpp>
+
+
+
+
+/// <summary>
+/// A piece of per-entity logic that is run by the EntityJournal once per tick
+/// <para>
+/// Each system declares which capabilities it reads and which it writes, normally in its constructor. Systems that do 
+/// not write anything the other reads or writes are run at the same time on different threads, the rest are run in the 
+/// order they were added
+/// </para>
+/// <para>
+/// While systems are running, entities must not be spawned or despawned and capabilities must not be added or removed. 
+/// A system must only view the capabilities it declares, their pools are made before any system starts so systems never 
+/// add to the registry's pools at the same time. Positions are changed with patch, Entity::move, or through a 
+/// PositionCapability handed out by EntityJournal::parallelEach, moved entities are put back into the spatial index once 
+/// every system has finished
+/// </para>
+/// </summary>
+class EntitySystem
+{
+public:
+
+	virtual ~EntitySystem() = default;
+
+
+
+	EntitySystem(const EntitySystem& other) = delete;
+
+
+
+	/// <summary>
+	/// This method is called each tick so that this system can update the entities it works on
+	/// <para>EntityJournal::parallelEach spreads the entities of a view across the worker threads</para>
+	/// </summary>
+	/// <param name="entitiesIn"></param>
+	/// <param name="deltaTime"></param>
+	virtual void onUpdate(class EntityJournal& entitiesIn, float deltaTime) = 0;
+
+
+
+	/// <summary>
+	/// Checks if this system and the given system must not run at the same time
+	/// </summary>
+	/// <param name="other"></param>
+	/// <returns>True if either system writes a capability that the other reads or writes</returns>
+	bool conflictsWith(const EntitySystem& other) const
+	{
+		if (m_exclusive || other.m_exclusive)
+			return true;
+
+		auto overlaps = [](const std::vector<Access>& a, const std::vector<Access>& b)
+		{
+			return std::any_of(a.begin(), a.end(), [&b](const Access& access)
+				{
+					return std::any_of(b.begin(), b.end(), [&access](const Access& other) { return other.id == access.id; });
+				});
+		};
+		return overlaps(m_writes, other.m_writes) || overlaps(m_writes, other.m_reads) || overlaps(other.m_writes, m_reads);
+	}
+
+
+
+	/// <summary>
+	/// Makes the registry's pool for every capability this system reads or writes, this must be called before systems are run
+	/// </summary>
+	/// <param name="registryIn"></param>
+	void preparePools(entt::registry& registryIn) const
+	{
+		for (const Access& access : m_reads)
+			access.prepare(registryIn);
+		for (const Access& access : m_writes)
+			access.prepare(registryIn);
+	}
+
+
+
+protected:
+
+	EntitySystem() = default;
+
+
+
+	/// <summary>
+	/// Declares the capabilities that this system reads
+	/// </summary>
+	template<typename... Capability>
+	void reads() { (m_reads.push_back({ entt::type_info<Capability>::id(), &preparePool<Capability> }), ...); }
+
+
+
+	/// <summary>
+	/// Declares the capabilities that this system writes, a capability that is written does not need to be declared as read
+	/// </summary>
+	template<typename... Capability>
+	void writes() { (m_writes.push_back({ entt::type_info<Capability>::id(), &preparePool<Capability> }), ...); }
+
+
+
+	/// <summary>
+	/// Declares that this system touches more than capabilities, so it is never run at the same time as another system
+	/// </summary>
+	void exclusive() { m_exclusive = true; }
+
+
+
+private:
+
+	/// <summary>
+	/// A declared capability, with the function that makes its pool
+	/// </summary>
+	struct Access
+	{
+		entt::id_type id;
+
+		void (*prepare)(entt::registry&);
+	};
+
+
+
+	template<typename Capability>
+	static void preparePool(entt::registry& registryIn) { registryIn.prepare<Capability>(); }
+
+
+
+	std::vector<Access> m_reads;
+
+	std::vector<Access> m_writes;
+
+	bool m_exclusive = false;
+};
+
+
+#endif /* EntitySystem_HPP_ */
+
+
+
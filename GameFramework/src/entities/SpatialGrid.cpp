@@ -0,0 +1,108 @@
+#include "entities/SpatialGrid.h"
+#include "utilities/Assertions.h"
+
+
+
+
+SpatialGrid::SpatialGrid(double cellSizeIn)
+{
+	GAME_ASSERT(cellSizeIn > 0.0);
+	m_cellSize = cellSizeIn;
+	m_inverseCellSize = 1.0 / cellSizeIn;
+}
+
+
+
+void SpatialGrid::insert(entt::entity entityIn, const Pos2D& posIn)
+{
+	const size_t index = slot(entityIn);
+	if (index >= m_locations.size())
+		m_locations.resize(index + 1);
+
+	const uint64_t key = cellKey(toCell(posIn.x), toCell(posIn.y));
+	Location& location = m_locations[index];
+	if (location.present)
+	{
+		if (location.cell == key)
+		{
+			m_cells[key][location.index].pos = posIn;
+			return;
+		}
+		remove(entityIn);
+	}
+
+	std::vector<Item>& cell = m_cells[key];
+	location.cell = key;
+	location.index = static_cast<uint32_t>(cell.size());
+	location.present = true;
+	cell.push_back({ entityIn, posIn });
+	m_size++;
+}
+
+
+
+void SpatialGrid::remove(entt::entity entityIn)
+{
+	const size_t index = slot(entityIn);
+	if (index >= m_locations.size() || !m_locations[index].present)
+		return;
+
+	// The last entity in the cell takes the removed entity's place
+	Location& location = m_locations[index];
+	std::vector<Item>& cell = m_cells[location.cell];
+	if (location.index + 1 != cell.size())
+	{
+		cell[location.index] = cell.back();
+		m_locations[slot(cell[location.index].entity)].index = location.index;
+	}
+	cell.pop_back();
+	if (cell.empty())
+		m_cells.erase(location.cell);
+	location.present = false;
+	m_size--;
+}
+
+
+
+bool SpatialGrid::contains(entt::entity entityIn) const
+{
+	const size_t index = slot(entityIn);
+	return index < m_locations.size() && m_locations[index].present;
+}
+
+
+
+void SpatialGrid::clear()
+{
+	m_cells.clear();
+	m_locations.clear();
+	m_size = 0;
+}
+
+
+
+void SpatialGrid::setCellSize(double cellSizeIn)
+{
+	GAME_ASSERT(cellSizeIn > 0.0);
+	std::vector<Item> items;
+	items.reserve(m_size);
+	for (const auto& cell : m_cells)
+		items.insert(items.end(), cell.second.begin(), cell.second.end());
+
+	clear();
+	m_cellSize = cellSizeIn;
+	m_inverseCellSize = 1.0 / cellSizeIn;
+	for (const Item& item : items)
+		insert(item.entity, item.pos);
+}
+
+
+
+void SpatialGrid::query(const AxisAlignedBB& areaIn, std::vector<entt::entity>& entitiesOut) const
+{
+	entitiesOut.clear();
+	query(areaIn, [&entitiesOut](entt::entity entityIn) { entitiesOut.push_back(entityIn); });
+}
+
+
+
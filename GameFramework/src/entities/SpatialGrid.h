@@ -0,0 +1,204 @@
+#ifndef SpatialGrid_H_
+#define SpatialGrid_H_
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+
+#include <entt/entt.hpp>
+
+#include "utilities/math/Pos2.hpp"
+#include "utilities/physics/AxisAlignedBB.h"
+
+
+
+
+/// <summary>
+/// A uniform grid of square cells that indexes entities by their position, so an area query only looks at the cells it covers
+/// <para>
+/// Each cell keeps a copy of its entities' positions, so a query never has to look an entity up in the registry to test it.
+/// Entities are moved between cells as their positions change, an entity that stays inside of its cell only has its copy updated
+/// </para>
+/// </summary>
+class SpatialGrid
+{
+public:
+
+	/// <param name="cellSizeIn">Specifies the width and height of each cell measured in pixels</param>
+	explicit SpatialGrid(double cellSizeIn = 64.0);
+
+
+
+	/// <summary>
+	/// Adds an entity to the grid, or moves it if it is already in the grid
+	/// </summary>
+	/// <param name="entityIn"></param>
+	/// <param name="posIn"></param>
+	void insert(entt::entity entityIn, const Pos2D& posIn);
+
+
+
+	/// <summary>
+	/// Removes an entity from the grid, this does nothing if the entity is not in the grid
+	/// </summary>
+	/// <param name="entityIn"></param>
+	void remove(entt::entity entityIn);
+
+
+
+	/// <summary>
+	/// Checks if the given entity is in the grid
+	/// </summary>
+	/// <param name="entityIn"></param>
+	/// <returns></returns>
+	bool contains(entt::entity entityIn) const;
+
+
+
+	/// <summary>
+	/// Removes every entity from the grid
+	/// </summary>
+	void clear();
+
+
+
+	/// <summary>
+	/// Changes the size of the cells, every entity is sorted into the new cells
+	/// <para>Cells should be about the size of the areas that are queried most often</para>
+	/// </summary>
+	/// <param name="cellSizeIn">Specifies the width and height of each cell measured in pixels</param>
+	void setCellSize(double cellSizeIn);
+
+
+
+	double getCellSize() const { return m_cellSize; }
+
+
+
+	/// <summary>
+	/// Gets the number of entities in the grid
+	/// </summary>
+	/// <returns></returns>
+	size_t size() const { return m_size; }
+
+
+
+	/// <summary>
+	/// Visits every entity whose position is inside of the given area, including its edges
+	/// </summary>
+	/// <typeparam name="Function">void(entt::entity)</typeparam>
+	/// <param name="areaIn"></param>
+	/// <param name="functionIn">Called once for each entity inside of the area, it must not add or remove entities from the grid</param>
+	template<typename Function>
+	void query(const AxisAlignedBB& areaIn, Function&& functionIn) const
+	{
+		const double minX = areaIn.getPos().x;
+		const double minY = areaIn.getPos().y;
+		const double maxX = minX + areaIn.width();
+		const double maxY = minY + areaIn.height();
+		const int64_t firstX = toCell(minX);
+		const int64_t firstY = toCell(minY);
+		const int64_t lastX = toCell(maxX);
+		const int64_t lastY = toCell(maxY);
+
+		// An area that covers more cells than are in use is answered by going over the cells that are in use
+		const double numberOfCells = static_cast<double>(lastX - firstX + 1) * static_cast<double>(lastY - firstY + 1);
+		if (numberOfCells > static_cast<double>(m_cells.size()))
+		{
+			for (const auto& cell : m_cells)
+				visit(cell.second, minX, minY, maxX, maxY, true, functionIn);
+			return;
+		}
+
+		for (int64_t y = firstY; y <= lastY; y++)
+		{
+			for (int64_t x = firstX; x <= lastX; x++)
+			{
+				auto cell = m_cells.find(cellKey(x, y));
+				if (cell == m_cells.end())
+					continue;
+
+				// Cells that are not on the edge of the area are inside of it, so their entities do not need to be tested
+				const bool edge = x == firstX || x == lastX || y == firstY || y == lastY;
+				visit(cell->second, minX, minY, maxX, maxY, edge, functionIn);
+			}
+		}
+	}
+
+
+
+	/// <summary>
+	/// Fills the given list with every entity whose position is inside of the given area, including its edges
+	/// </summary>
+	/// <param name="areaIn"></param>
+	/// <param name="entitiesOut">Cleared and then filled, its memory is reused between queries</param>
+	void query(const AxisAlignedBB& areaIn, std::vector<entt::entity>& entitiesOut) const;
+
+
+
+private:
+
+	struct Item
+	{
+		entt::entity entity = entt::null;
+
+		Pos2D pos;
+	};
+
+
+
+	struct Location
+	{
+		uint64_t cell = 0;
+
+		uint32_t index = 0;
+
+		bool present = false;
+	};
+
+
+
+	template<typename Function>
+	static void visit(const std::vector<Item>& itemsIn, double minX, double minY, double maxX, double maxY, bool testIn, Function& functionIn)
+	{
+		for (const Item& item : itemsIn)
+		{
+			if (!testIn || (item.pos.x >= minX && item.pos.x <= maxX && item.pos.y >= minY && item.pos.y <= maxY))
+				functionIn(item.entity);
+		}
+	}
+
+
+
+	int64_t toCell(double valueIn) const { return static_cast<int64_t>(std::floor(valueIn * m_inverseCellSize)); }
+
+
+
+	static uint64_t cellKey(int64_t x, int64_t y) { return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y); }
+
+
+
+	static size_t slot(entt::entity entityIn) { return static_cast<size_t>(entt::to_integral(entityIn) & entt::entt_traits<entt::entity>::entity_mask); }
+
+
+
+	double m_cellSize = 64.0;
+
+	double m_inverseCellSize = 1.0 / 64.0;
+
+	size_t m_size = 0;
+
+	std::unordered_map<uint64_t, std::vector<Item>> m_cells;
+
+	/// <summary>
+	/// Where each entity is in its cell, by the entity's index
+	/// </summary>
+	std::vector<Location> m_locations;
+};
+
+
+#endif /* SpatialGrid_H_ */
+
+
+
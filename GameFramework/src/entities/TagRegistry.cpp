@@ -0,0 +1,78 @@
+#include <mutex>
+
+#include "TagRegistry.h"
+#include "utilities/Assertions.h"
+
+
+
+
+TagRegistry::TagRegistry()
+{
+	m_names.emplace_back("unknown");
+	m_ids.emplace(m_names.back(), UNKNOWN);
+}
+
+
+
+TagRegistry& TagRegistry::getInstance()
+{
+	static TagRegistry s_instance;
+	return s_instance;
+}
+
+
+
+TagId TagRegistry::intern(std::string_view tagIn)
+{
+	TagRegistry& registry = getInstance();
+	{
+		std::shared_lock<std::shared_mutex> lock(registry.m_mutex);
+		auto found = registry.m_ids.find(tagIn);
+		if (found != registry.m_ids.end())
+			return found->second;
+	}
+
+	// Another thread may have added the tag between the two locks
+	std::unique_lock<std::shared_mutex> lock(registry.m_mutex);
+	auto found = registry.m_ids.find(tagIn);
+	if (found != registry.m_ids.end())
+		return found->second;
+
+	GAME_ASSERT(registry.m_names.size() < INVALID);
+	const TagId id = static_cast<TagId>(registry.m_names.size());
+	registry.m_names.emplace_back(tagIn);
+	registry.m_ids.emplace(registry.m_names.back(), id);
+	return id;
+}
+
+
+
+TagId TagRegistry::find(std::string_view tagIn)
+{
+	TagRegistry& registry = getInstance();
+	std::shared_lock<std::shared_mutex> lock(registry.m_mutex);
+	auto found = registry.m_ids.find(tagIn);
+	return found != registry.m_ids.end() ? found->second : INVALID;
+}
+
+
+
+const std::string& TagRegistry::name(TagId idIn)
+{
+	TagRegistry& registry = getInstance();
+	std::shared_lock<std::shared_mutex> lock(registry.m_mutex);
+	GAME_ASSERT(idIn < registry.m_names.size());
+	return registry.m_names[idIn];
+}
+
+
+
+size_t TagRegistry::size()
+{
+	TagRegistry& registry = getInstance();
+	std::shared_lock<std::shared_mutex> lock(registry.m_mutex);
+	return registry.m_names.size();
+}
+
+
+
@@ -0,0 +1,111 @@
+#ifndef TagRegistry_H_
+#define TagRegistry_H_
+
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+
+
+/// <summary>
+/// A compact identifier for an entity tag, two tags are the same only if their identifiers are equal
+/// </summary>
+using TagId = uint32_t;
+
+
+
+
+/// <summary>
+/// The global symbol table of entity tags, every tag's text is stored once and entities only hold its TagId
+/// <para>
+/// Identifiers are handed out in the order tags are first seen and are never reused, so they can index tables directly. 
+/// All methods are safe to call from any thread
+/// </para>
+/// </summary>
+class TagRegistry
+{
+public:
+
+	/// <summary>
+	/// The identifier of entities that were spawned without a tag
+	/// </summary>
+	static constexpr TagId UNKNOWN = 0;
+
+
+
+	/// <summary>
+	/// Returned by TagRegistry::find when a tag has never been interned
+	/// </summary>
+	static constexpr TagId INVALID = UINT32_MAX;
+
+
+
+	TagRegistry(const TagRegistry& other) = delete;
+
+
+
+	/// <summary>
+	/// Gets the identifier of the given tag, adding it to the table if this is the first time it has been seen
+	/// </summary>
+	/// <param name="tagIn"></param>
+	/// <returns></returns>
+	static TagId intern(std::string_view tagIn);
+
+
+
+	/// <summary>
+	/// Gets the identifier of the given tag without adding it to the table
+	/// </summary>
+	/// <param name="tagIn"></param>
+	/// <returns>The tag's identifier, or TagRegistry::INVALID if it has never been interned</returns>
+	static TagId find(std::string_view tagIn);
+
+
+
+	/// <summary>
+	/// Gets the text of the given tag, it stays valid for as long as the program runs
+	/// </summary>
+	/// <param name="idIn">Specifies an identifier returned by TagRegistry::intern</param>
+	/// <returns></returns>
+	static const std::string& name(TagId idIn);
+
+
+
+	/// <summary>
+	/// Gets the number of tags that have been interned
+	/// </summary>
+	/// <returns></returns>
+	static size_t size();
+
+
+
+private:
+
+	TagRegistry();
+
+
+
+	static TagRegistry& getInstance();
+
+
+
+	mutable std::shared_mutex m_mutex;
+
+	/// <summary>
+	/// Every tag's text by its identifier, a deque never moves its elements so the keys below stay valid
+	/// </summary>
+	std::deque<std::string> m_names;
+
+	std::unordered_map<std::string_view, TagId> m_ids;
+};
+
+
+#endif /* TagRegistry_H_ */
+
+
+
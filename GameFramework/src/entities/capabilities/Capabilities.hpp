@@ -5,6 +5,7 @@
 #include <string>
 
 #include "entities/capabilities/ICapability.hpp"
+#include "entities/TagRegistry.h"
 #include "utilities/math/Pos2.hpp"
 #include "utilities/physics/AxisAlignedBB.h"
 #include "utilities/physics/EnumSide.h"
@@ -43,7 +44,7 @@ public:
 
 
 /// <summary>
-/// This Capability gives an Entity the ability to have a text unique identifier
+/// This Capability gives an Entity the ability to have a text unique identifier, which is interned by the TagRegistry
 /// <para>
 /// Note: this Capability is required for all Entities, and if removed will cause undefined behavior
 /// </para>
@@ -52,8 +53,14 @@ class TagCapability : public ICapability<TagCapability>
 {
 public:
 
+	TagCapability(TagId idIn)
+		: ICapability(), m_id(idIn)
+	{}
+
+
+
 	TagCapability(const std::string& tagIn)
-		: ICapability(), m_tag(tagIn)
+		: ICapability(), m_id(TagRegistry::intern(tagIn))
 	{}
 
 
@@ -62,13 +69,21 @@ public:
 	/// Gets this Entity's text unique identifier
 	/// </summary>
 	/// <returns></returns>
-	const std::string& tag() const { return m_tag; }
+	const std::string& tag() const { return TagRegistry::name(m_id); }
+
+
+
+	/// <summary>
+	/// Gets the interned identifier of this Entity's tag
+	/// </summary>
+	/// <returns></returns>
+	TagId id() const { return m_id; }
 
 
 
 private:
 
-	std::string m_tag;
+	TagId m_id;
 };
 
 
@@ -206,7 +221,11 @@ public:
 
 
 	/// <summary>
-	/// The Axis-Aligned Bounding Box for this Entity
+	/// The Axis-Aligned Bounding Box for this Entity, relative to the Entity's position
+	/// <para>
+	/// Entity::updatePos moves ColliderCapability::aabb along with the Entity, so that box ends up in Global-Space. This box 
+	/// is never moved, PhysicsWorld adds the Entity's position to it each step
+	/// </para>
 	/// </summary>
 	AxisAlignedBB aabb;
 
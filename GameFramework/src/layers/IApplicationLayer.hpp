@@ -57,6 +57,19 @@ public:
 
 
 
+	/// <summary>
+	/// This method is called each frame so that this GameLayer can render itself between its last two ticks
+	/// <para>
+	/// By default it ignores the blend and calls the overload without one
+	/// </para>
+	/// </summary>
+	/// <param name="cameraIn"></param>
+	/// <param name="rendererIn"></param>
+	/// <param name="alphaIn">Specifies how far the frame is from the last tick to the next one, from 0 to 1</param>
+	virtual void onRender(const std::shared_ptr<class Camera>& cameraIn, class Renderer& rendererIn, float alphaIn) { onRender(cameraIn, rendererIn); }
+
+
+
 	/// <summary>
 	/// Sets this GameLayer to be active
 	/// <para>
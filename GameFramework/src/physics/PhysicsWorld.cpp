@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <cmath>
+
+// The bodies are stored as doubles, so the narrowphase needs SSE2 rather than the SSE the renderer's culling uses
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PHYSICS_SSE_NARROWPHASE
+#endif
+
+#include "physics/PhysicsWorld.hpp"
+#include "entities/EntityJournal.hpp"
+
+
+
+
+PhysicsWorld::PhysicsWorld()
+	: PhysicsWorld(Settings())
+{}
+
+
+
+PhysicsWorld::PhysicsWorld(const Settings& settingsIn)
+	: m_settings(settingsIn)
+{}
+
+
+
+void PhysicsWorld::step(EntityJournal& entitiesIn, float deltaTimeIn)
+{
+	const double deltaTime = static_cast<double>(deltaTimeIn);
+	m_statistics = Statistics();
+	gatherBodies(entitiesIn, deltaTime);
+	broadphase();
+	narrowphase();
+	solveVelocities();
+	integratePositions(entitiesIn, deltaTime);
+}
+
+
+
+void PhysicsWorld::gatherBodies(EntityJournal& entitiesIn, double deltaTimeIn)
+{
+	for (entt::entity entity : m_entities)
+		m_bodyIndex[slot(entity)] = -1;
+
+	m_entities.clear();
+	m_minX.clear();
+	m_minY.clear();
+	m_maxX.clear();
+	m_maxY.clear();
+	m_velocityX.clear();
+	m_velocityY.clear();
+	m_inverseMass.clear();
+	m_friction.clear();
+
+	auto bodies = entitiesIn.view<PositionCapability, RigidbodyCapability>();
+	for (auto entity : bodies)
+	{
+		const Pos2D& pos = bodies.get<PositionCapability>(entity).pos;
+		RigidbodyCapability& body = bodies.get<RigidbodyCapability>(entity);
+
+		// The bounding box is relative to the entity's position
+		const double minX = pos.x + body.aabb.getPos().x;
+		const double minY = pos.y + body.aabb.getPos().y;
+		double velocityX = body.velocity.x;
+		double velocityY = body.velocity.y;
+		if (body.inverseMass > 0.0f)
+		{
+			velocityX += (body.acceleration.x + m_settings.gravity.x) * deltaTimeIn;
+			velocityY += (body.acceleration.y + m_settings.gravity.y) * deltaTimeIn;
+		}
+
+		const size_t index = slot(entity);
+		if (index >= m_bodyIndex.size())
+			m_bodyIndex.resize(index + 1, -1);
+		m_bodyIndex[index] = static_cast<int32_t>(m_entities.size());
+
+		m_entities.push_back(entity);
+		m_minX.push_back(minX);
+		m_minY.push_back(minY);
+		m_maxX.push_back(minX + body.aabb.width());
+		m_maxY.push_back(minY + body.aabb.height());
+		m_velocityX.push_back(velocityX);
+		m_velocityY.push_back(velocityY);
+		m_inverseMass.push_back(body.inverseMass);
+		m_friction.push_back(body.friction);
+	}
+	m_statistics.bodies = m_entities.size();
+}
+
+
+
+void PhysicsWorld::broadphase()
+{
+	const size_t numberOfBodies = m_entities.size();
+	std::vector<uint8_t> sorted(numberOfBodies, 0);
+	m_sorted.clear();
+	m_sorted.reserve(numberOfBodies);
+
+	// Bodies that were in last step's order keep their place, bodies that are new go on the end
+	for (entt::entity entity : m_order)
+	{
+		const size_t index = slot(entity);
+		if (index >= m_bodyIndex.size() || m_bodyIndex[index] < 0 || m_entities[m_bodyIndex[index]] != entity)
+			continue;
+
+		m_sorted.push_back(static_cast<uint32_t>(m_bodyIndex[index]));
+		sorted[m_bodyIndex[index]] = 1;
+	}
+
+	const size_t numberOfKept = m_sorted.size();
+	for (uint32_t body = 0; body < numberOfBodies; body++)
+	{
+		if (!sorted[body])
+			m_sorted.push_back(body);
+	}
+
+	// The sweep runs along the axis the bodies' centers are most spread out on, so a column of stacked bodies is swept along Y 
+	// instead of every body in it overlapping every other on X
+	double sumX = 0.0;
+	double sumY = 0.0;
+	double sumSquaresX = 0.0;
+	double sumSquaresY = 0.0;
+	for (size_t i = 0; i < numberOfBodies; i++)
+	{
+		const double centerX = m_minX[i] + m_maxX[i];
+		const double centerY = m_minY[i] + m_maxY[i];
+		sumX += centerX;
+		sumY += centerY;
+		sumSquaresX += centerX * centerX;
+		sumSquaresY += centerY * centerY;
+	}
+	const double count = static_cast<double>(std::max(numberOfBodies, static_cast<size_t>(1)));
+	const bool sweepY = sumSquaresY - sumY * sumY / count > sumSquaresX - sumX * sumX / count;
+	const bool axisChanged = sweepY != m_sweepY;
+	m_sweepY = sweepY;
+
+	const std::vector<double>& sweepMin = sweepY ? m_minY : m_minX;
+	const std::vector<double>& sweepMax = sweepY ? m_maxY : m_maxX;
+	const std::vector<double>& otherMin = sweepY ? m_minX : m_minY;
+	const std::vector<double>& otherMax = sweepY ? m_maxX : m_maxY;
+
+	// An order that is nearly sorted only needs a few swaps, so insertion sort is close to linear, unless many bodies are new 
+	// or the order was sorted along the other axis
+	auto leftEdge = [&sweepMin](uint32_t a, uint32_t b) { return sweepMin[a] < sweepMin[b]; };
+	if (axisChanged || numberOfBodies - numberOfKept > numberOfBodies / 4)
+		std::sort(m_sorted.begin(), m_sorted.end(), leftEdge);
+	else
+	{
+		for (size_t i = 1; i < numberOfBodies; i++)
+		{
+			const uint32_t body = m_sorted[i];
+			size_t j = i;
+			for (; j > 0 && leftEdge(body, m_sorted[j - 1]); j--)
+				m_sorted[j] = m_sorted[j - 1];
+			m_sorted[j] = body;
+		}
+	}
+
+	m_order.resize(numberOfBodies);
+	for (size_t i = 0; i < numberOfBodies; i++)
+		m_order[i] = m_entities[m_sorted[i]];
+
+	// Only bodies whose near edge is before the current body's far edge can overlap it along the sweep's axis
+	m_pairA.clear();
+	m_pairB.clear();
+	for (size_t i = 0; i < numberOfBodies; i++)
+	{
+		const uint32_t a = m_sorted[i];
+		const double maxEdge = sweepMax[a];
+		for (size_t j = i + 1; j < numberOfBodies && sweepMin[m_sorted[j]] <= maxEdge; j++)
+		{
+			const uint32_t b = m_sorted[j];
+			m_statistics.pairsTested++;
+			if (otherMin[a] > otherMax[b] || otherMin[b] > otherMax[a])
+				continue;
+
+			// Two bodies that cannot move never need to be pushed apart
+			if (m_inverseMass[a] <= 0.0 && m_inverseMass[b] <= 0.0)
+				continue;
+
+			m_pairA.push_back(a);
+			m_pairB.push_back(b);
+		}
+	}
+}
+
+
+
+void PhysicsWorld::narrowphase()
+{
+	m_previousImpulses.swap(m_impulses);
+	m_impulses.clear();
+
+	const size_t numberOfPairs = m_pairA.size();
+	m_contacts.resize(numberOfPairs);
+	m_bias.resize(numberOfPairs);
+	for (size_t i = 0; i < numberOfPairs; i++)
+	{
+		const uint32_t a = m_pairA[i];
+		const uint32_t b = m_pairB[i];
+#ifdef PHYSICS_SSE_NARROWPHASE
+		// Both axes are worked out at once, each box is packed as { min x, min y } and { max x, max y }
+		const __m128d minA = _mm_set_pd(m_minY[a], m_minX[a]);
+		const __m128d maxA = _mm_set_pd(m_maxY[a], m_maxX[a]);
+		const __m128d minB = _mm_set_pd(m_minY[b], m_minX[b]);
+		const __m128d maxB = _mm_set_pd(m_maxY[b], m_maxX[b]);
+		const __m128d low = _mm_max_pd(minA, minB);
+		const __m128d high = _mm_min_pd(maxA, maxB);
+
+		double overlap[2];
+		double point[2];
+		_mm_storeu_pd(overlap, _mm_sub_pd(high, low));
+		_mm_storeu_pd(point, _mm_mul_pd(_mm_add_pd(low, high), _mm_set1_pd(0.5)));
+
+		// Bit 0 is set if A's center is left of B's and bit 1 if it is above
+		const int aIsBefore = _mm_movemask_pd(_mm_cmplt_pd(_mm_add_pd(minA, maxA), _mm_add_pd(minB, maxB)));
+		const double overlapX = overlap[0];
+		const double overlapY = overlap[1];
+		const bool aIsLeft = (aIsBefore & 1) != 0;
+		const bool aIsAbove = (aIsBefore & 2) != 0;
+		const Pos2D center(point[0], point[1]);
+#else
+		const double left = std::max(m_minX[a], m_minX[b]);
+		const double right = std::min(m_maxX[a], m_maxX[b]);
+		const double top = std::max(m_minY[a], m_minY[b]);
+		const double bottom = std::min(m_maxY[a], m_maxY[b]);
+		const double overlapX = right - left;
+		const double overlapY = bottom - top;
+		const bool aIsLeft = m_minX[a] + m_maxX[a] < m_minX[b] + m_maxX[b];
+		const bool aIsAbove = m_minY[a] + m_maxY[a] < m_minY[b] + m_maxY[b];
+		const Pos2D center((left + right) * 0.5, (top + bottom) * 0.5);
+#endif
+
+		// Boxes are pushed apart along the axis they overlap the least on
+		Contact& contact = m_contacts[i];
+		contact.a = m_entities[a];
+		contact.b = m_entities[b];
+		contact.point = center;
+		if (overlapX < overlapY)
+		{
+			contact.normal = Pos2D(aIsLeft ? 1.0 : -1.0, 0.0);
+			contact.penetration = overlapX;
+		}
+		else
+		{
+			contact.normal = Pos2D(0.0, aIsAbove ? 1.0 : -1.0);
+			contact.penetration = overlapY;
+		}
+
+		const double normalSpeed = (m_velocityX[b] - m_velocityX[a]) * contact.normal.x + (m_velocityY[b] - m_velocityY[a]) * contact.normal.y;
+		m_bias[i] = normalSpeed < -1.0 ? -m_settings.restitution * normalSpeed : 0.0;
+
+		// Pairs that were touching last step start from the impulses they ended on
+		contact.normalImpulse = 0.0;
+		contact.tangentImpulse = 0.0;
+		auto cached = m_previousImpulses.find(pairKey(contact.a, contact.b));
+		if (cached != m_previousImpulses.end())
+		{
+			contact.normalImpulse = cached->second.normalImpulse;
+			contact.tangentImpulse = cached->second.tangentImpulse;
+			const double impulseX = contact.normal.x * contact.normalImpulse - contact.normal.y * contact.tangentImpulse;
+			const double impulseY = contact.normal.y * contact.normalImpulse + contact.normal.x * contact.tangentImpulse;
+			m_velocityX[a] -= impulseX * m_inverseMass[a];
+			m_velocityY[a] -= impulseY * m_inverseMass[a];
+			m_velocityX[b] += impulseX * m_inverseMass[b];
+			m_velocityY[b] += impulseY * m_inverseMass[b];
+			m_statistics.contactsKept++;
+		}
+	}
+	m_statistics.contacts = numberOfPairs;
+}
+
+
+
+void PhysicsWorld::solveVelocities()
+{
+	const size_t numberOfContacts = m_contacts.size();
+	for (int iteration = 0; iteration < m_settings.iterations; iteration++)
+	{
+		for (size_t i = 0; i < numberOfContacts; i++)
+		{
+			Contact& contact = m_contacts[i];
+			const uint32_t a = m_pairA[i];
+			const uint32_t b = m_pairB[i];
+			const double inverseMassA = m_inverseMass[a];
+			const double inverseMassB = m_inverseMass[b];
+			const double inverseMassSum = inverseMassA + inverseMassB;
+
+			// The total impulse is clamped rather than each step's impulse, so impulses can be taken back in later iterations
+			double relativeX = m_velocityX[b] - m_velocityX[a];
+			double relativeY = m_velocityY[b] - m_velocityY[a];
+			const double normalSpeed = relativeX * contact.normal.x + relativeY * contact.normal.y;
+			const double normalImpulse = std::max(contact.normalImpulse + (m_bias[i] - normalSpeed) / inverseMassSum, 0.0);
+			double impulse = normalImpulse - contact.normalImpulse;
+			contact.normalImpulse = normalImpulse;
+			m_velocityX[a] -= contact.normal.x * impulse * inverseMassA;
+			m_velocityY[a] -= contact.normal.y * impulse * inverseMassA;
+			m_velocityX[b] += contact.normal.x * impulse * inverseMassB;
+			m_velocityY[b] += contact.normal.y * impulse * inverseMassB;
+
+			// Friction works along the contact's surface and is limited by how hard the bodies are pressed together
+			const double tangentX = -contact.normal.y;
+			const double tangentY = contact.normal.x;
+			relativeX = m_velocityX[b] - m_velocityX[a];
+			relativeY = m_velocityY[b] - m_velocityY[a];
+			const double tangentSpeed = relativeX * tangentX + relativeY * tangentY;
+			const double maxFriction = std::sqrt(m_friction[a] * m_friction[b]) * contact.normalImpulse;
+			const double tangentImpulse = std::clamp(contact.tangentImpulse - tangentSpeed / inverseMassSum, -maxFriction, maxFriction);
+			impulse = tangentImpulse - contact.tangentImpulse;
+			contact.tangentImpulse = tangentImpulse;
+			m_velocityX[a] -= tangentX * impulse * inverseMassA;
+			m_velocityY[a] -= tangentY * impulse * inverseMassA;
+			m_velocityX[b] += tangentX * impulse * inverseMassB;
+			m_velocityY[b] += tangentY * impulse * inverseMassB;
+		}
+	}
+
+	for (const Contact& contact : m_contacts)
+		m_impulses[pairKey(contact.a, contact.b)] = { contact.normalImpulse, contact.tangentImpulse };
+}
+
+
+
+void PhysicsWorld::integratePositions(EntityJournal& entitiesIn, double deltaTimeIn)
+{
+	const size_t numberOfBodies = m_entities.size();
+	std::vector<double> moveX(numberOfBodies), moveY(numberOfBodies);
+	for (size_t body = 0; body < numberOfBodies; body++)
+	{
+		moveX[body] = m_velocityX[body] * deltaTimeIn;
+		moveY[body] = m_velocityY[body] * deltaTimeIn;
+	}
+
+	// Overlap that the impulses did not remove is pushed out directly, shared between the bodies by their inverse mass
+	for (size_t i = 0; i < m_contacts.size(); i++)
+	{
+		const Contact& contact = m_contacts[i];
+		const uint32_t a = m_pairA[i];
+		const uint32_t b = m_pairB[i];
+		const double inverseMassSum = m_inverseMass[a] + m_inverseMass[b];
+		const double push = std::max(contact.penetration - m_settings.slop, 0.0) / inverseMassSum * m_settings.correction;
+		moveX[a] -= contact.normal.x * push * m_inverseMass[a];
+		moveY[a] -= contact.normal.y * push * m_inverseMass[a];
+		moveX[b] += contact.normal.x * push * m_inverseMass[b];
+		moveY[b] += contact.normal.y * push * m_inverseMass[b];
+	}
+
+	for (size_t body = 0; body < numberOfBodies; body++)
+	{
+		const entt::entity entity = m_entities[body];
+		RigidbodyCapability* rigidbody = entitiesIn.get<RigidbodyCapability>(entity);
+		rigidbody->velocity = Pos2D(m_velocityX[body], m_velocityY[body]);
+		if (moveX[body] != 0.0 || moveY[body] != 0.0)
+		{
+			const double x = moveX[body], y = moveY[body];
+			entitiesIn.patch<PositionCapability>(entity, [x, y](PositionCapability& posIn) { posIn.pos += Pos2D(x, y); });
+		}
+	}
+}
+
+
+
+uint64_t PhysicsWorld::pairKey(entt::entity a, entt::entity b)
+{
+	const uint64_t first = static_cast<uint64_t>(entt::to_integral(a));
+	const uint64_t second = static_cast<uint64_t>(entt::to_integral(b));
+	return first < second ? (first << 32) | second : (second << 32) | first;
+}
+
+
+
@@ -0,0 +1,269 @@
+#ifndef PhysicsWorld_HPP_
+#define PhysicsWorld_HPP_
+
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+#include <entt/entt.hpp>
+
+#include "utilities/math/Pos2.hpp"
+
+
+
+
+/// <summary>
+/// Moves every entity that has both a PositionCapability and a RigidbodyCapability, and pushes apart the bodies that overlap
+/// <para>
+/// Each step the bodies' velocities are integrated, overlapping pairs are found with a sweep and prune, each pair is turned 
+/// into a contact, and the contacts are resolved with sequential impulses weighted by each body's inverse mass. A body whose 
+/// inverse mass is 0 never moves
+/// </para>
+/// <para>
+/// A body's RigidbodyCapability::aabb is relative to the entity's position and is never moved itself. This differs from a 
+/// ColliderCapability's box, which Entity::updatePos keeps in Global-Space, so a box made for a collider must not be reused as is
+/// </para>
+/// <para>
+/// The sweep runs along whichever axis the bodies' centers are most spread out on that step. Bodies that overlap on that 
+/// axis are still all tested against each other, so a pile that is as tall as it is wide is tested in close to O(N^2)
+/// </para>
+/// <para>
+/// The order of the sweep and the impulses of each pair are kept between steps. Bodies barely move from one step to the next, 
+/// so the sweep's order only needs a few swaps to be sorted again, and pairs that are still touching start from last step's
+/// impulses, which lets stacks settle in fewer iterations
+/// </para>
+/// </summary>
+class PhysicsWorld
+{
+public:
+
+	struct Settings
+	{
+		/// <summary>
+		/// The acceleration applied to every body that can move, measured in pixels per second squared
+		/// </summary>
+		Pos2D gravity = { 0.0, 0.0 };
+
+		/// <summary>
+		/// The number of times each contact is resolved per step, more iterations give stiffer stacks
+		/// </summary>
+		int iterations = 8;
+
+		/// <summary>
+		/// How much of a collision's speed is kept as bounce, from 0 for none to 1 for all of it
+		/// </summary>
+		double restitution = 0.0;
+
+		/// <summary>
+		/// How far bodies may sink into each other before they are pushed apart, measured in pixels
+		/// </summary>
+		double slop = 0.05;
+
+		/// <summary>
+		/// The fraction of the remaining overlap that is removed each step
+		/// </summary>
+		double correction = 0.8;
+	};
+
+
+
+	struct Contact
+	{
+		entt::entity a = entt::null;
+
+		entt::entity b = entt::null;
+
+		/// <summary>
+		/// Points from body A towards body B
+		/// </summary>
+		Pos2D normal;
+
+		/// <summary>
+		/// The center of the area where the bodies overlap, in Global-Space
+		/// </summary>
+		Pos2D point;
+
+		double penetration = 0.0;
+
+		/// <summary>
+		/// The total impulse along the normal this step
+		/// </summary>
+		double normalImpulse = 0.0;
+
+		/// <summary>
+		/// The total friction impulse this step
+		/// </summary>
+		double tangentImpulse = 0.0;
+	};
+
+
+
+	struct Statistics
+	{
+		size_t bodies = 0;
+
+		/// <summary>
+		/// The number of pairs whose bounds overlap along the sweep's axis, which are the only pairs that are tested
+		/// </summary>
+		size_t pairsTested = 0;
+
+		size_t contacts = 0;
+
+		/// <summary>
+		/// The number of contacts that started from the impulses of the step before
+		/// </summary>
+		size_t contactsKept = 0;
+	};
+
+
+
+	PhysicsWorld();
+
+
+
+	explicit PhysicsWorld(const Settings& settingsIn);
+
+
+
+	/// <summary>
+	/// Moves every rigid-body forward by the given amount of time
+	/// <para>Positions are changed with patch, so the entity journal's spatial index follows the bodies</para>
+	/// </summary>
+	/// <param name="entitiesIn"></param>
+	/// <param name="deltaTimeIn">Specifies the length of the step measured in seconds</param>
+	void step(class EntityJournal& entitiesIn, float deltaTimeIn);
+
+
+
+	/// <summary>
+	/// Gets the contacts that were resolved by the last step
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<Contact>& getContacts() const { return m_contacts; }
+
+
+
+	const Statistics& getStatistics() const { return m_statistics; }
+
+
+
+	Settings& getSettings() { return m_settings; }
+
+
+
+	const Settings& getSettings() const { return m_settings; }
+
+
+
+private:
+
+	struct CachedImpulse
+	{
+		double normalImpulse = 0.0;
+
+		double tangentImpulse = 0.0;
+	};
+
+
+
+	/// <summary>
+	/// Copies every rigid-body into the body lists and integrates their velocities
+	/// </summary>
+	void gatherBodies(class EntityJournal& entitiesIn, double deltaTimeIn);
+
+
+
+	/// <summary>
+	/// Sorts the bodies by their near edge along the sweep's axis, starting from last step's order, then collects the pairs that 
+	/// overlap on both axes
+	/// </summary>
+	void broadphase();
+
+
+
+	/// <summary>
+	/// Turns each overlapping pair into a contact and applies last step's impulses to the pairs that are still touching
+	/// </summary>
+	void narrowphase();
+
+
+
+	void solveVelocities();
+
+
+
+	void integratePositions(class EntityJournal& entitiesIn, double deltaTimeIn);
+
+
+
+	static uint64_t pairKey(entt::entity a, entt::entity b);
+
+
+
+	static size_t slot(entt::entity entityIn) { return static_cast<size_t>(entt::to_integral(entityIn) & entt::entt_traits<entt::entity>::entity_mask); }
+
+
+
+	Settings m_settings;
+
+	Statistics m_statistics;
+
+	// The bodies of the current step, one entry per body in each list so the hot loops only touch what they need
+
+	std::vector<entt::entity> m_entities;
+
+	std::vector<double> m_minX;
+
+	std::vector<double> m_minY;
+
+	std::vector<double> m_maxX;
+
+	std::vector<double> m_maxY;
+
+	std::vector<double> m_velocityX;
+
+	std::vector<double> m_velocityY;
+
+	std::vector<double> m_inverseMass;
+
+	std::vector<double> m_friction;
+
+	/// <summary>
+	/// Each body's index in the body lists, by the entity's index, or -1 if the entity is not a body
+	/// </summary>
+	std::vector<int32_t> m_bodyIndex;
+
+	/// <summary>
+	/// The bodies sorted by their near edge along the sweep's axis, kept between steps
+	/// </summary>
+	std::vector<entt::entity> m_order;
+
+	/// <summary>
+	/// True if the last step swept along the Y axis rather than the X axis
+	/// </summary>
+	bool m_sweepY = false;
+
+	std::vector<uint32_t> m_sorted;
+
+	std::vector<uint32_t> m_pairA;
+
+	std::vector<uint32_t> m_pairB;
+
+	std::vector<Contact> m_contacts;
+
+	/// <summary>
+	/// The restitution target speed of each contact along its normal
+	/// </summary>
+	std::vector<double> m_bias;
+
+	std::unordered_map<uint64_t, CachedImpulse> m_previousImpulses;
+
+	std::unordered_map<uint64_t, CachedImpulse> m_impulses;
+};
+
+
+#endif /* PhysicsWorld_HPP_ */
+
+
+
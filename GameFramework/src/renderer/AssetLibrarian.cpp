@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
 #include "AssetLibrarian.h"
 #include "renderer/shaders/Shader.h"
 #include "renderer/texture/Texture.h"
 #include "renderer/texture/TextureAtlas.h"
+#include "renderer/FrameData.h"
 #include "utilities/Assertions.h"
 
 
@@ -19,8 +24,13 @@ void AssetLibrarian::addShader(const std::string& nameIn, const std::filesystem:
 	GAME_ASSERT(m_shaders.find(nameIn) == m_shaders.end());
 
 	m_logger->trace("Loading shader: '{0}' vertex shader at '{1}' and pixel shader at '{2}'", nameIn, vertexFilepath.string(), pixelFilepath.string());
-	m_shaders[nameIn] = std::make_shared<Shader>();
-	m_shaders[nameIn]->create(vertexFilepath, pixelFilepath);
+	auto shader = std::make_shared<Shader>();
+	onContext([&]()
+		{
+			shader->create(vertexFilepath, pixelFilepath, m_assetCache.get());
+			shader->bindUniformBlock(FrameData::BLOCK_NAME, FrameData::BINDING);
+		});
+	m_shaders[nameIn] = std::move(shader);
 	m_logger->trace("Shader '{0}' has been Loaded", nameIn);
 }
 
@@ -31,8 +41,13 @@ void AssetLibrarian::addShaderFromString(const std::string& nameIn, const std::s
 	GAME_ASSERT(m_shaders.find(nameIn) == m_shaders.end());
 
 	m_logger->trace("Loading shader: '{0}' from strings", nameIn);
-	m_shaders[nameIn] = std::make_shared<Shader>();
-	m_shaders[nameIn]->createFromString(vertexSrc, pixelSrc);
+	auto shader = std::make_shared<Shader>();
+	onContext([&]()
+		{
+			shader->createFromString(vertexSrc, pixelSrc, m_assetCache.get());
+			shader->bindUniformBlock(FrameData::BLOCK_NAME, FrameData::BINDING);
+		});
+	m_shaders[nameIn] = std::move(shader);
 	m_logger->trace("Shader '{0}' has been Loaded", nameIn);
 }
 
@@ -64,7 +79,17 @@ void AssetLibrarian::addTexture(const std::filesystem::path& filepathIn)
 		return;
 	}
 
-	m_textures[name] = std::make_shared<Texture>(filepathIn, m_nextTextureID++);
+	// The image is decoded on the calling thread, only the upload waits for the thread that owns the context
+	const Image image = loadImage(filepathIn, m_assetCache.get());
+	const unsigned int textureID = m_nextTextureID++;
+	std::shared_ptr<Texture> texture;
+	onContext([&]()
+		{
+			texture = createTexture(filepathIn, image, false, { 0, 0 }, { 0, 0 }, textureID);
+			if (m_useTextureArrays)
+				packTexture(*texture);
+		});
+	storeTexture(name, std::move(texture));
 	m_logger->trace("Texture '{0}' has been loaded", name);
 }
 
@@ -87,12 +112,197 @@ void AssetLibrarian::addTexture(const std::filesystem::path& filepathIn, const g
 		return;
 	}
 
-	m_textures[name] = std::make_shared<TextureAtlas>(filepathIn, spriteSizeIn, spritePaddingIn, m_nextTextureID++);
+	const Image image = loadImage(filepathIn, m_assetCache.get());
+	const unsigned int textureID = m_nextTextureID++;
+	std::shared_ptr<Texture> texture;
+	onContext([&]()
+		{
+			texture = createTexture(filepathIn, image, true, spriteSizeIn, spritePaddingIn, textureID);
+			if (m_useTextureArrays)
+				packTexture(*texture);
+		});
+	storeTexture(name, std::move(texture));
 	m_logger->trace("Texture atlas '{0}' has been loaded", name);
 }
 
 
 
+TextureHandle AssetLibrarian::loadTextureAsync(const std::filesystem::path& filepathIn)
+{
+	return queueTexture(filepathIn, false, { 0, 0 }, { 0, 0 });
+}
+
+
+
+TextureHandle AssetLibrarian::loadTextureAsync(const std::filesystem::path& filepathIn, const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn)
+{
+	return queueTexture(filepathIn, true, spriteSizeIn, spritePaddingIn);
+}
+
+
+
+std::vector<TextureHandle> AssetLibrarian::loadTexturesAsync(const std::vector<std::filesystem::path>& filepathsIn)
+{
+	std::vector<TextureHandle> handles;
+	handles.reserve(filepathsIn.size());
+	for (const auto& filepath : filepathsIn)
+		handles.push_back(loadTextureAsync(filepath));
+	return handles;
+}
+
+
+
+bool AssetLibrarian::isTextureLoaded(TextureHandle handleIn) const
+{
+	if (!hasTexture(handleIn))
+		return false;
+
+	for (const PendingTexture& pending : m_pendingTextures)
+	{
+		if (pending.handle == handleIn)
+			return false;
+	}
+	return true;
+}
+
+
+
+void AssetLibrarian::updateTextureLoads(const std::function<void(std::function<void()>)>& uploadIn)
+{
+	for (size_t i = 0; i < m_pendingTextures.size();)
+	{
+		PendingTexture& pending = m_pendingTextures[i];
+
+		// Decoded images are handed to the OpenGL thread, only the upload and the copy into a texture array happen there
+		if (!pending.upload)
+		{
+			if (pending.image.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				i++;
+				continue;
+			}
+
+			auto image = std::make_shared<Image>(pending.image.get());
+			if (!image->isValid())
+			{
+				m_logger->error("Unable to decode texture '{0}' at '{1}', it will keep showing the placeholder", pending.name, pending.filepath.string());
+				m_pendingTextures.erase(m_pendingTextures.begin() + i);
+				continue;
+			}
+
+			pending.upload = std::make_shared<TextureUpload>();
+			auto upload = pending.upload;
+			const std::filesystem::path filepath = pending.filepath;
+			const bool atlas = pending.atlas;
+			const glm::uvec2 spriteSize = pending.spriteSize;
+			const glm::uvec2 spritePadding = pending.spritePadding;
+			const unsigned int textureID = m_nextTextureID++;
+			uploadIn([this, upload, image, filepath, atlas, spriteSize, spritePadding, textureID]()
+			{
+				// The texture pages and arrays are only changed here and by other work on the thread that owns the context, the 
+				// main thread only records where the texture ended up once it is done
+				upload->texture = createTexture(filepath, *image, atlas, spriteSize, spritePadding, textureID);
+				if (m_useTextureArrays)
+					addToTextureArray(*upload->texture, upload->layer);
+				upload->done = true;
+			});
+		}
+
+		if (!pending.upload->done)
+		{
+			i++;
+			continue;
+		}
+
+		// The texture may have been removed, or replaced under the same name, while it was loading
+		auto handle = m_textures.find(pending.name);
+		if (handle != m_textures.end() && handle->second == pending.handle)
+		{
+			TextureSlot& slot = m_textureSlots[pending.handle.index()];
+			slot.texture = std::move(pending.upload->texture);
+			if (pending.upload->layer.array >= 0)
+				m_textureLayers[slot.texture->getID()] = pending.upload->layer;
+			else if (m_useTextureArrays)
+			{
+				// Texture arrays were enabled after the upload, so it is packed on the thread that owns the arrays
+				const Texture& texture = *slot.texture;
+				onContext([this, &texture]() { packTexture(texture); });
+			}
+			m_logger->trace("Texture '{0}' has been loaded", pending.name);
+		}
+		else
+		{
+			// Nothing uses the finished texture, so its last reference is dropped by the thread that owns the context
+			releaseTexture(std::move(pending.upload->texture), pending.upload->layer);
+		}
+		m_pendingTextures.erase(m_pendingTextures.begin() + i);
+	}
+}
+
+
+
+void AssetLibrarian::createPlaceholderTexture()
+{
+	if (m_placeholderTexture)
+		return;
+
+	// A magenta and black checkerboard stands out while a texture is loading
+	Image image(2, 2, 4);
+	unsigned char* pixels = image.data();
+	for (int i = 0; i < 4; i++)
+	{
+		const bool magenta = (i == 0 || i == 3);
+		pixels[i * 4 + 0] = magenta ? 255 : 0;
+		pixels[i * 4 + 1] = 0;
+		pixels[i * 4 + 2] = magenta ? 255 : 0;
+		pixels[i * 4 + 3] = 255;
+	}
+
+	const unsigned int textureID = m_nextTextureID++;
+	onContext([&]()
+		{
+			m_placeholderTexture = std::make_shared<Texture>("placeholder", image, textureID);
+			if (m_useTextureArrays)
+				packTexture(*m_placeholderTexture);
+		});
+}
+
+
+
+TextureHandle AssetLibrarian::queueTexture(const std::filesystem::path& filepathIn, bool atlasIn, const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn)
+{
+	std::string name = filepathIn.stem().string();
+	m_logger->trace("Loading texture in the background: '{0}' at '{1}'", name, filepathIn.string());
+	if (m_textures.find(name) != m_textures.end())
+	{
+		m_logger->warn("Unable to load texture: '{0}', file name is not unique", name);
+		return TextureHandle();
+	}
+
+	if (!m_placeholderTexture)
+	{
+		m_logger->critical("Unable to load texture '{0}' in the background, there is no placeholder texture", name);
+		__debugbreak();
+		return TextureHandle();
+	}
+
+	if (!m_loader)
+		m_loader = std::make_unique<ThreadPool>();
+
+	PendingTexture pending;
+	pending.name = name;
+	pending.handle = storeTexture(name, m_placeholderTexture);
+	pending.filepath = filepathIn;
+	pending.atlas = atlasIn;
+	pending.spriteSize = spriteSizeIn;
+	pending.spritePadding = spritePaddingIn;
+	pending.image = m_loader->submit([filepathIn, cache = m_assetCache]() { return loadImage(filepathIn, cache.get()); });
+	m_pendingTextures.push_back(std::move(pending));
+	return m_pendingTextures.back().handle;
+}
+
+
+
 bool AssetLibrarian::hasTexture(const std::string& nameIn)
 {
 	return m_textures.find(nameIn) != m_textures.end();
@@ -104,7 +314,351 @@ std::weak_ptr<Texture> AssetLibrarian::getTexture(const std::string& nameIn)
 {
 	GAME_ASSERT(m_textures.find(nameIn) != m_textures.end());
 
-	return m_textures[nameIn];
+	return m_textureSlots[m_textures[nameIn].index()].texture;
+}
+
+
+
+TextureHandle AssetLibrarian::getTextureHandle(const std::string& nameIn) const
+{
+	auto handle = m_textures.find(nameIn);
+	if (handle == m_textures.end())
+	{
+		m_logger->warn("Unable to find texture '{0}'", nameIn);
+		return TextureHandle();
+	}
+
+	return handle->second;
+}
+
+
+
+bool AssetLibrarian::hasTexture(TextureHandle handleIn) const
+{
+	return handleIn.isValid() 
+		&& handleIn.index() < m_textureSlots.size() 
+		&& m_textureSlots[handleIn.index()].generation == handleIn.generation();
+}
+
+
+
+std::weak_ptr<Texture> AssetLibrarian::getTexture(TextureHandle handleIn) const
+{
+	if (!hasTexture(handleIn))
+		return std::weak_ptr<Texture>();
+
+	return m_textureSlots[handleIn.index()].texture;
+}
+
+
+
+void AssetLibrarian::removeTexture(const std::string& nameIn)
+{
+	auto handle = m_textures.find(nameIn);
+	if (handle == m_textures.end())
+	{
+		m_logger->warn("Unable to remove texture '{0}', it has not been loaded", nameIn);
+		return;
+	}
+
+	// A texture that is still loading only holds the placeholder, which stays packed
+	TextureSlot& slot = m_textureSlots[handle->second.index()];
+	TextureArrayLayer layer = { -1, 0 };
+	if (slot.texture != m_placeholderTexture)
+	{
+		auto packed = m_textureLayers.find(slot.texture->getID());
+		if (packed != m_textureLayers.end())
+		{
+			layer = packed->second;
+			m_textureLayers.erase(packed);
+		}
+	}
+
+	// The last reference is dropped by the thread that owns the context, unless a pass that is being drawn still holds it
+	releaseTexture(std::move(slot.texture), layer);
+	slot.texture.reset();
+	m_freeTextureSlots.push_back(handle->second.index());
+	m_textures.erase(handle);
+	m_logger->trace("Texture '{0}' has been removed", nameIn);
+}
+
+
+
+Image AssetLibrarian::loadImage(const std::filesystem::path& filepathIn, AssetCache* cacheIn)
+{
+	std::vector<unsigned char> file;
+	if (!cacheIn || TextureFile::isCooked(filepathIn) || !AssetCache::readFile(filepathIn, file))
+		return Image::load(filepathIn);
+
+	// Entries are a small header followed by the decoded pixels, which are copied straight into the image
+	struct Header
+	{
+		uint32_t width = 0;
+
+		uint32_t height = 0;
+
+		uint32_t channels = 0;
+
+		uint32_t reserved = 0;
+	};
+
+	const uint64_t key = AssetCache::hash(file.data(), file.size());
+	std::vector<unsigned char> entry;
+	Header header;
+	if (cacheIn->read("textures", key, entry) && entry.size() >= sizeof(Header))
+	{
+		std::memcpy(&header, entry.data(), sizeof(header));
+		const size_t size = static_cast<size_t>(header.width) * header.height * header.channels;
+		if (size > 0 && entry.size() == sizeof(Header) + size)
+		{
+			Image image(header.width, header.height, header.channels);
+			if (image.isValid())
+			{
+				std::memcpy(image.data(), entry.data() + sizeof(Header), size);
+				return image;
+			}
+		}
+	}
+
+	Image image = Image::decode(file.data(), file.size());
+	if (image.isValid())
+	{
+		header.width = image.width();
+		header.height = image.height();
+		header.channels = image.channels();
+		const size_t size = static_cast<size_t>(header.width) * header.height * header.channels;
+		cacheIn->store("textures", key, [&header, &image, size](const std::filesystem::path& entryIn)
+			{
+				std::ofstream entryFile(entryIn, std::ios::out | std::ios::binary | std::ios::trunc);
+				entryFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				entryFile.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(size));
+				return entryFile.good();
+			});
+	}
+	return image;
+}
+
+
+
+TextureHandle AssetLibrarian::storeTexture(const std::string& nameIn, std::shared_ptr<Texture> textureIn)
+{
+	uint32_t index = 0;
+	if (!m_freeTextureSlots.empty())
+	{
+		index = m_freeTextureSlots.back();
+		m_freeTextureSlots.pop_back();
+	}
+	else
+	{
+		GAME_ASSERT(m_textureSlots.size() <= TextureHandle::INDEX_MASK);
+		index = static_cast<uint32_t>(m_textureSlots.size());
+		m_textureSlots.emplace_back();
+	}
+
+	TextureSlot& slot = m_textureSlots[index];
+	slot.texture = std::move(textureIn);
+
+	// Generation 0 is skipped so that a default constructed handle never matches a slot
+	slot.generation = (slot.generation + 1) & TextureHandle::GENERATION_MASK;
+	if (slot.generation == 0)
+		slot.generation = 1;
+
+	TextureHandle handle(index, slot.generation);
+	m_textures[nameIn] = handle;
+	return handle;
+}
+
+
+
+void AssetLibrarian::enableTextureArrays()
+{
+	if (m_useTextureArrays)
+		return;
+
+	m_logger->trace("Packing textures into texture arrays");
+	onContext([this]()
+		{
+			m_useTextureArrays = true;
+			for (const TextureSlot& slot : m_textureSlots)
+			{
+				if (slot.texture)
+					packTexture(*slot.texture);
+			}
+		});
+}
+
+
+
+void AssetLibrarian::enableTexturePacking(const glm::uvec2& pageSizeIn, unsigned int maxTextureSizeIn)
+{
+	if (m_useTextureArrays)
+	{
+		m_logger->warn("Texture packing is not used while textures are packed into texture arrays");
+		return;
+	}
+
+	GAME_ASSERT(pageSizeIn.x > 0 && pageSizeIn.y > 0);
+	m_logger->trace("Packing textures up to {0}x{0} into {1}x{2} texture pages", maxTextureSizeIn, pageSizeIn.x, pageSizeIn.y);
+	onContext([this, pageSizeIn, maxTextureSizeIn]()
+		{
+			m_usePacking = true;
+			m_pageSize = pageSizeIn;
+			m_maxPackedSize = std::min({ maxTextureSizeIn, pageSizeIn.x - TexturePage::PADDING * 2, pageSizeIn.y - TexturePage::PADDING * 2 });
+		});
+}
+
+
+
+std::shared_ptr<Texture> AssetLibrarian::createTexture(const std::filesystem::path& filepathIn, const Image& imageIn, bool atlasIn, 
+	const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn, unsigned int textureIDIn)
+{
+	// Cooked textures keep their own mip chain and compression, so they are never packed. Only images that an empty page 
+	// could hold are packed, so a new page is never made for an image that will not fit on it
+	const bool pack = m_usePacking && !m_useTextureArrays && imageIn.width() <= m_maxPackedSize && imageIn.height() <= m_maxPackedSize
+		&& TexturePage::canHold(imageIn, m_pageSize.x, m_pageSize.y);
+	if (pack)
+	{
+		// Pages are tried oldest first, a new page is only made once none of them has room
+		const glm::uvec2 size(imageIn.width(), imageIn.height());
+		glm::uvec2 position;
+		std::shared_ptr<TexturePage> page;
+		for (const auto& candidate : m_texturePages)
+		{
+			if (candidate->add(imageIn, position))
+			{
+				page = candidate;
+				break;
+			}
+		}
+
+		if (!page)
+		{
+			auto newPage = std::make_shared<TexturePage>(m_pageSize.x, m_pageSize.y);
+			if (newPage->add(imageIn, position))
+			{
+				m_texturePages.push_back(newPage);
+				m_numberOfTexturePages = m_texturePages.size();
+				page = std::move(newPage);
+			}
+		}
+
+		if (page)
+		{
+			if (atlasIn)
+				return std::make_shared<TextureAtlas>(filepathIn, std::move(page), position, size, spriteSizeIn, spritePaddingIn, textureIDIn);
+			return std::make_shared<Texture>(filepathIn, std::move(page), position, size, textureIDIn);
+		}
+	}
+
+	if (atlasIn)
+		return std::make_shared<TextureAtlas>(filepathIn, imageIn, spriteSizeIn, spritePaddingIn, textureIDIn);
+	return std::make_shared<Texture>(filepathIn, imageIn, textureIDIn);
+}
+
+
+
+void AssetLibrarian::onContext(const std::function<void()>& taskIn)
+{
+	if (m_contextQueue)
+		m_contextQueue->run(taskIn);
+	else
+		taskIn();
+}
+
+
+
+const TextureArrayLayer* AssetLibrarian::findTextureLayer(const Texture& textureIn) const
+{
+	auto layer = m_textureLayers.find(textureIn.getID());
+	return layer != m_textureLayers.end() ? &layer->second : nullptr;
+}
+
+
+
+const TextureArray& AssetLibrarian::getTextureArray(int indexIn) const
+{
+	GAME_ASSERT(indexIn >= 0 && indexIn < static_cast<int>(m_textureArrays.size()));
+	return m_textureArrays[indexIn];
+}
+
+
+
+void AssetLibrarian::releaseTexture(std::shared_ptr<Texture> textureIn, const TextureArrayLayer& layerIn)
+{
+	auto release = [this, texture = std::move(textureIn), layerIn]()
+	{
+		if (layerIn.array >= 0)
+			m_releasedLayers.push_back({ texture, layerIn });
+	};
+
+	if (m_contextQueue)
+		m_contextQueue->post(std::move(release));
+	else
+		release();
+}
+
+
+
+void AssetLibrarian::reclaimTextureLayers()
+{
+	// A layer is only reused once nothing holds its old texture, so a pass that is still to be drawn never samples a new image
+	for (size_t i = 0; i < m_releasedLayers.size();)
+	{
+		if (!m_releasedLayers[i].texture.expired())
+		{
+			i++;
+			continue;
+		}
+
+		m_textureArrays[m_releasedLayers[i].layer.array].remove(m_releasedLayers[i].layer.layer);
+		m_releasedLayers[i] = m_releasedLayers.back();
+		m_releasedLayers.pop_back();
+	}
+}
+
+
+
+void AssetLibrarian::packTexture(const Texture& textureIn)
+{
+	if (m_textureLayers.find(textureIn.getID()) != m_textureLayers.end())
+		return;
+
+	TextureArrayLayer layer;
+	if (addToTextureArray(textureIn, layer))
+		m_textureLayers[textureIn.getID()] = layer;
+}
+
+
+
+bool AssetLibrarian::addToTextureArray(const Texture& textureIn, TextureArrayLayer& layerOut)
+{
+	if (textureIn.isPacked())
+	{
+		m_logger->warn("Texture '{0}' is in a texture page and cannot also be packed into a texture array", textureIn.location().string());
+		return false;
+	}
+
+	reclaimTextureLayers();
+
+	int array = 0;
+	for (; array < static_cast<int>(m_textureArrays.size()); array++)
+	{
+		if (m_textureArrays[array].width() == textureIn.width() && m_textureArrays[array].height() == textureIn.height())
+			break;
+	}
+
+	if (array == static_cast<int>(m_textureArrays.size()))
+		m_textureArrays.emplace_back(textureIn.width(), textureIn.height());
+
+	int layer = m_textureArrays[array].add(textureIn);
+	if (layer < 0)
+	{
+		m_logger->warn("Unable to pack texture '{0}' into a texture array", textureIn.location().string());
+		return false;
+	}
+
+	layerOut = { array, static_cast<unsigned int>(layer) };
+	return true;
 }
 
 
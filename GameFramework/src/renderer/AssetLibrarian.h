@@ -5,9 +5,20 @@
 #include <filesystem>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include <future>
+#include <atomic>
+#include <functional>
 
 #include <glm/glm.hpp>
 
+#include "renderer/texture/TextureArray.h"
+#include "renderer/texture/TextureHandle.h"
+#include "renderer/texture/Image.h"
+#include "renderer/texture/TexturePage.h"
+#include "renderer/ContextQueue.h"
+#include "utilities/ThreadPool.h"
+#include "utilities/AssetCache.h"
 #include "utilities/Loggers.hpp"
 
 
@@ -59,6 +70,24 @@ public:
 
 
 
+	/// <summary>
+	/// Keeps decoded textures and linked shader programs in the given asset cache, so later launches skip decoding and compiling them
+	/// <para>Only assets that are loaded afterwards are cached</para>
+	/// </summary>
+	/// <param name="cacheIn">Specifies the asset cache, or null to stop caching</param>
+	void setAssetCache(std::shared_ptr<AssetCache> cacheIn) { m_assetCache = std::move(cacheIn); }
+
+
+
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets the asset cache
+	/// </summary>
+	/// <returns>The asset cache or null if assets are not being cached</returns>
+	AssetCache* getAssetCache() const { return m_assetCache.get(); }
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -86,6 +115,80 @@ public:
 
 
 
+	/// <summary>
+	/// Starts loading a texture in the background, its image is decoded on a worker thread and uploaded once it is ready
+	/// <para>The returned handle can be drawn with straight away, it shows the placeholder texture until the load finishes</para>
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <returns>The texture's handle, or an invalid handle if the file name is not unique</returns>
+	TextureHandle loadTextureAsync(const std::filesystem::path& filepathIn);
+
+
+
+	/// <summary>
+	/// Starts loading a texture atlas in the background, its image is decoded on a worker thread and uploaded once it is ready
+	/// <para>The returned handle can be drawn with straight away, it shows the placeholder texture until the load finishes</para>
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="spriteSizeIn"></param>
+	/// <param name="spritePaddingIn"></param>
+	/// <returns>The texture's handle, or an invalid handle if the file name is not unique</returns>
+	TextureHandle loadTextureAsync(const std::filesystem::path& filepathIn, const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn = { 0, 0 });
+
+
+
+	/// <summary>
+	/// Starts loading every given texture in the background, the images are decoded in parallel
+	/// </summary>
+	/// <param name="filepathsIn"></param>
+	/// <returns>Each texture's handle, in the same order as the given files</returns>
+	std::vector<TextureHandle> loadTexturesAsync(const std::vector<std::filesystem::path>& filepathsIn);
+
+
+
+	/// <summary>
+	/// Checks if the given texture has finished loading, textures that were not loaded in the background always have
+	/// </summary>
+	/// <param name="handleIn"></param>
+	/// <returns></returns>
+	bool isTextureLoaded(TextureHandle handleIn) const;
+
+
+
+	/// <summary>
+	/// Gets the number of background texture loads that have not finished
+	/// </summary>
+	/// <returns></returns>
+	size_t numberOfPendingTextures() const { return m_pendingTextures.size(); }
+
+
+
+	/// <summary>
+	/// Moves the background texture loads along, decoded images are uploaded and uploaded textures replace the placeholder
+	/// <para>This must be called on the main thread, once per frame</para>
+	/// </summary>
+	/// <param name="uploadIn">Runs a function on the thread that owns the OpenGL context</param>
+	void updateTextureLoads(const std::function<void(std::function<void()>)>& uploadIn);
+
+
+
+	/// <summary>
+	/// Sets the queue that every call needing the OpenGL context is made through, so shaders and textures can still be 
+	/// added on the main thread while a render thread owns the context
+	/// </summary>
+	/// <param name="queueIn"></param>
+	void setContextQueue(ContextQueue* queueIn) { m_contextQueue = queueIn; }
+
+
+
+	/// <summary>
+	/// Creates the texture that is shown in place of textures that are still loading
+	/// <para>This needs the OpenGL context, it is called when the renderer is initialized</para>
+	/// </summary>
+	void createPlaceholderTexture();
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -104,15 +207,332 @@ public:
 
 
 
+	/// <summary>
+	/// Gets a handle to the given texture, which can be used to draw it without looking it up by name
+	/// </summary>
+	/// <param name="nameIn"></param>
+	/// <returns>The texture's handle, or an invalid handle if there is no texture with the given name</returns>
+	TextureHandle getTextureHandle(const std::string& nameIn) const;
+
+
+
+	/// <summary>
+	/// Checks if the given handle still refers to a texture
+	/// </summary>
+	/// <param name="handleIn"></param>
+	/// <returns></returns>
+	bool hasTexture(TextureHandle handleIn) const;
+
+
+
+	/// <summary>
+	/// Gets the texture that the given handle refers to
+	/// </summary>
+	/// <param name="handleIn"></param>
+	/// <returns>The texture, or an empty pointer if the texture has been removed</returns>
+	std::weak_ptr<class Texture> getTexture(TextureHandle handleIn) const;
+
+
+
+	/// <summary>
+	/// Removes the given texture, handles to it will no longer resolve
+	/// <para>If the texture was packed into a texture array its layer is not reused</para>
+	/// </summary>
+	/// <param name="nameIn"></param>
+	void removeTexture(const std::string& nameIn);
+
+
+
+	/// <summary>
+	/// Gets the number of texture slots, every texture handle's index is less than this
+	/// </summary>
+	/// <returns></returns>
+	size_t numberOfTextureSlots() const { return m_textureSlots.size(); }
+
+
+
+	/// <summary>
+	/// Packs every loaded texture, and every texture that is added afterwards, into texture arrays of the same size
+	/// </summary>
+	void enableTextureArrays();
+
+
+
+	/// <summary>
+	/// Checks if textures are being packed into texture arrays
+	/// </summary>
+	/// <returns></returns>
+	bool hasTextureArrays() const { return m_useTextureArrays; }
+
+
+
+	/// <summary>
+	/// Packs every texture that is loaded afterwards, and is small enough, into shared texture pages
+	/// <para>
+	/// Textures on the same page are drawn with one texture slot, so batches are broken less often. Packing is an alternative
+	/// to texture arrays and is ignored while texture arrays are in use
+	/// </para>
+	/// <para>
+	/// Pages only ever grow, the space of a removed texture is not reused, so packing suits textures that stay loaded
+	/// </para>
+	/// </summary>
+	/// <param name="pageSizeIn">Specifies the size of each texture page</param>
+	/// <param name="maxTextureSizeIn">Specifies the largest width or height of a texture that will be packed</param>
+	void enableTexturePacking(const glm::uvec2& pageSizeIn = { 2048, 2048 }, unsigned int maxTextureSizeIn = 512);
+
+
+
+	/// <summary>
+	/// Checks if textures are being packed into texture pages
+	/// </summary>
+	/// <returns></returns>
+	bool hasTexturePacking() const { return m_usePacking; }
+
+
+
+	/// <summary>
+	/// Gets the number of texture pages
+	/// </summary>
+	/// <returns></returns>
+	size_t numberOfTexturePages() const { return m_numberOfTexturePages; }
+
+
+
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets where the given texture has been packed into a texture array
+	/// </summary>
+	/// <param name="textureIn"></param>
+	/// <returns>The texture's array and layer, or null if it has not been packed</returns>
+	const TextureArrayLayer* findTextureLayer(const class Texture& textureIn) const;
+
+
+
+	/// <summary>
+	/// Gets the texture array at the given index
+	/// <para>This must be called by the thread that owns the OpenGL context</para>
+	/// </summary>
+	/// <param name="indexIn"></param>
+	/// <returns></returns>
+	const TextureArray& getTextureArray(int indexIn) const;
+
+
+
+	/// <summary>
+	/// Gets the number of texture arrays
+	/// <para>This must be called by the thread that owns the OpenGL context</para>
+	/// </summary>
+	/// <returns></returns>
+	int numberOfTextureArrays() const { return static_cast<int>(m_textureArrays.size()); }
+
+
+
 private:
 
+	/// <summary>
+	/// Runs the given function on the thread that owns the OpenGL context and waits for it to finish
+	/// </summary>
+	/// <param name="taskIn"></param>
+	void onContext(const std::function<void()>& taskIn);
+
+
+
+	/// <summary>
+	/// Copies the given texture into the texture array of its size, a new texture array is made if there is not one yet
+	/// </summary>
+	/// <param name="textureIn"></param>
+	void packTexture(const class Texture& textureIn);
+
+
+
+	/// <summary>
+	/// Copies the given texture into the texture array of its size without recording where it was packed
+	/// <para>Only the texture arrays are touched, which only ever change on the thread that owns the OpenGL context</para>
+	/// </summary>
+	/// <param name="textureIn"></param>
+	/// <param name="layerOut">Filled in with where the texture was packed</param>
+	/// <returns>True if the texture was packed</returns>
+	bool addToTextureArray(const class Texture& textureIn, TextureArrayLayer& layerOut);
+
+
+
+	/// <summary>
+	/// Drops the given texture on the thread that owns the OpenGL context, and gives its texture array layer back once 
+	/// nothing else holds the texture
+	/// </summary>
+	/// <param name="textureIn"></param>
+	/// <param name="layerIn">Specifies the layer the texture was packed into, or an array of -1 if it was not packed</param>
+	void releaseTexture(std::shared_ptr<class Texture> textureIn, const TextureArrayLayer& layerIn);
+
+
+
+	/// <summary>
+	/// Frees the texture array layers of released textures that nothing holds any more
+	/// <para>This must be called by the thread that owns the OpenGL context</para>
+	/// </summary>
+	void reclaimTextureLayers();
+
+
+
+	/// <summary>
+	/// Uploads a decoded image, into a texture page when packing is enabled and the image is small enough
+	/// <para>This needs the OpenGL context</para>
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="imageIn"></param>
+	/// <param name="atlasIn">Specifies if the texture is a texture atlas</param>
+	/// <param name="spriteSizeIn">Specifies the atlas' sprite size</param>
+	/// <param name="spritePaddingIn">Specifies the atlas' sprite padding</param>
+	/// <param name="textureIDIn"></param>
+	/// <returns></returns>
+	std::shared_ptr<class Texture> createTexture(const std::filesystem::path& filepathIn, const Image& imageIn, bool atlasIn, 
+		const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn, unsigned int textureIDIn);
+
+
+
+	/// <summary>
+	/// Decodes the given image file, decoded images are read from and stored in the asset cache when there is one
+	/// <para>Cooked textures are never cached, they are already stored the way they are uploaded</para>
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="cacheIn">Specifies the asset cache, or null to always decode the file</param>
+	/// <returns>The decoded image, which is empty if the file could not be decoded</returns>
+	static Image loadImage(const std::filesystem::path& filepathIn, AssetCache* cacheIn);
+
+
+
+	/// <summary>
+	/// Stores the given texture in a free slot, or a new slot if none are free, and registers it under the given name
+	/// </summary>
+	/// <param name="nameIn"></param>
+	/// <param name="textureIn"></param>
+	/// <returns></returns>
+	TextureHandle storeTexture(const std::string& nameIn, std::shared_ptr<class Texture> textureIn);
+
+
+
+	struct TextureSlot
+	{
+		std::shared_ptr<class Texture> texture;
+
+		/// <summary>
+		/// Changed each time the slot is given to a new texture, 0 is never used
+		/// </summary>
+		uint32_t generation = 0;
+	};
+
+
+
+
+	/// <summary>
+	/// Written on the OpenGL thread and read on the main thread once the upload is done
+	/// </summary>
+	struct TextureUpload
+	{
+		std::shared_ptr<class Texture> texture;
+
+		TextureArrayLayer layer = { -1, 0 };
+
+		std::atomic<bool> done{ false };
+	};
+
+
+
+	struct PendingTexture
+	{
+		std::string name;
+
+		TextureHandle handle;
+
+		std::filesystem::path filepath;
+
+		bool atlas = false;
+
+		glm::uvec2 spriteSize = { 0, 0 };
+
+		glm::uvec2 spritePadding = { 0, 0 };
+
+		std::future<Image> image;
+
+		/// <summary>
+		/// Null until the image has been decoded and handed to the OpenGL thread
+		/// </summary>
+		std::shared_ptr<TextureUpload> upload;
+	};
+
+
+
+	TextureHandle queueTexture(const std::filesystem::path& filepathIn, bool atlasIn, const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn);
+
+
+
 	std::shared_ptr<spdlog::logger> m_logger;
 
 	std::unordered_map<std::string, std::shared_ptr<class Shader>> m_shaders;
 
-	std::unordered_map<std::string, std::shared_ptr<class Texture>> m_textures;
+	std::unordered_map<std::string, TextureHandle> m_textures;
+
+	std::vector<TextureSlot> m_textureSlots;
+
+	std::vector<uint32_t> m_freeTextureSlots;
 
 	unsigned int m_nextTextureID = 1;
+
+	/// <summary>
+	/// The packing settings are only changed on the thread that owns the OpenGL context, so background uploads can read them
+	/// </summary>
+	bool m_useTextureArrays = false;
+
+	/// <summary>
+	/// Only used by the thread that owns the OpenGL context, along with the texture pages
+	/// </summary>
+	std::vector<TextureArray> m_textureArrays;
+
+	/// <summary>
+	/// The layer of each packed texture, by texture ID
+	/// </summary>
+	std::unordered_map<unsigned int, TextureArrayLayer> m_textureLayers;
+
+	/// <summary>
+	/// A removed texture's layer, which is kept until nothing holds the texture
+	/// </summary>
+	struct ReleasedLayer
+	{
+		std::weak_ptr<class Texture> texture;
+
+		TextureArrayLayer layer;
+	};
+
+	/// <summary>
+	/// Only used by the thread that owns the OpenGL context, along with the texture arrays
+	/// </summary>
+	std::vector<ReleasedLayer> m_releasedLayers;
+
+	std::shared_ptr<class Texture> m_placeholderTexture;
+
+	bool m_usePacking = false;
+
+	glm::uvec2 m_pageSize = { 0, 0 };
+
+	unsigned int m_maxPackedSize = 0;
+
+	std::vector<std::shared_ptr<TexturePage>> m_texturePages;
+
+	std::atomic<size_t> m_numberOfTexturePages{ 0 };
+
+	std::vector<PendingTexture> m_pendingTextures;
+
+	/// <summary>
+	/// Decodes images for background texture loads, it is only started once the first one is requested
+	/// </summary>
+	std::unique_ptr<ThreadPool> m_loader;
+
+	std::shared_ptr<AssetCache> m_assetCache;
+
+	/// <summary>
+	/// Null until the renderer is initialized, the calling thread is then assumed to own the OpenGL context
+	/// </summary>
+	ContextQueue* m_contextQueue = nullptr;
 }; 
 
 
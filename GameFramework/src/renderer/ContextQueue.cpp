@@ -0,0 +1,88 @@
+#include <future>
+
+#include "renderer/ContextQueue.h"
+
+
+
+
+void ContextQueue::post(std::function<void()> taskIn)
+{
+	std::function<void()> listener;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_tasks.push_back(std::move(taskIn));
+		listener = m_listener;
+	}
+
+	if (listener)
+		listener();
+}
+
+
+
+void ContextQueue::run(const std::function<void()>& taskIn)
+{
+	if (ownsContext())
+	{
+		taskIn();
+		return;
+	}
+
+	std::promise<void> finished;
+	std::future<void> future = finished.get_future();
+	post([&taskIn, &finished]()
+		{
+			taskIn();
+			finished.set_value();
+		});
+	future.wait();
+}
+
+
+
+void ContextQueue::runTasks()
+{
+	std::vector<std::function<void()>> tasks;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		tasks.swap(m_tasks);
+	}
+
+	for (auto& task : tasks)
+		task();
+}
+
+
+
+bool ContextQueue::hasTasks() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return !m_tasks.empty();
+}
+
+
+
+void ContextQueue::setOwner(std::thread::id ownerIn)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_owner = ownerIn;
+}
+
+
+
+bool ContextQueue::ownsContext() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_owner == std::this_thread::get_id();
+}
+
+
+
+void ContextQueue::setListener(std::function<void()> listenerIn)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_listener = std::move(listenerIn);
+}
+
+
+
@@ -0,0 +1,103 @@
+#ifndef ContextQueue_H_
+#define ContextQueue_H_
+
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+
+
+/// <summary>
+/// Tasks that need the OpenGL context, they are queued by any thread and run by the thread that owns the context
+/// </summary>
+class ContextQueue
+{
+public:
+
+	ContextQueue() = default;
+
+
+
+	ContextQueue(const ContextQueue& other) = delete;
+
+
+
+	ContextQueue(ContextQueue&& other) = delete;
+
+
+
+	/// <summary>
+	/// Queues a task, it is run the next time the thread that owns the context runs its tasks
+	/// <para>This can be called from any thread</para>
+	/// </summary>
+	/// <param name="taskIn"></param>
+	void post(std::function<void()> taskIn);
+
+
+
+	/// <summary>
+	/// Runs a task on the thread that owns the context and waits for it to finish
+	/// <para>The task is run straight away if the calling thread owns the context</para>
+	/// </summary>
+	/// <param name="taskIn"></param>
+	void run(const std::function<void()>& taskIn);
+
+
+
+	/// <summary>
+	/// Runs every queued task, must be called by the thread that owns the context
+	/// </summary>
+	void runTasks();
+
+
+
+	/// <summary>
+	/// Checks if any task is waiting to be run
+	/// </summary>
+	/// <returns></returns>
+	bool hasTasks() const;
+
+
+
+	/// <summary>
+	/// Sets the thread that owns the context
+	/// </summary>
+	/// <param name="ownerIn"></param>
+	void setOwner(std::thread::id ownerIn);
+
+
+
+	/// <summary>
+	/// Checks if the calling thread owns the context
+	/// </summary>
+	/// <returns></returns>
+	bool ownsContext() const;
+
+
+
+	/// <summary>
+	/// Sets a function that is called each time a task is queued, so the thread that owns the context can be woken up
+	/// </summary>
+	/// <param name="listenerIn"></param>
+	void setListener(std::function<void()> listenerIn);
+
+
+
+private:
+
+	mutable std::mutex m_lock;
+
+	std::vector<std::function<void()>> m_tasks;
+
+	std::thread::id m_owner;
+
+	std::function<void()> m_listener;
+};
+
+
+#endif /* ContextQueue_H_ */
+
+
+
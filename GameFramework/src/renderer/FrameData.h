@@ -0,0 +1,47 @@
+#ifndef FrameData_H_
+#define FrameData_H_
+
+#include <glm/glm.hpp>
+
+
+
+
+/// <summary>
+/// The data that every shader can read from the "FrameData" uniform block, which is written once per Renderer::begin
+/// <para>
+/// The members follow the std140 layout, which is declared in GLSL as:
+/// layout(std140, binding = 0) uniform FrameData { mat4 u_view; mat4 u_projection; mat4 u_viewProjection; float u_time; vec2 u_viewport; };
+/// </para>
+/// </summary>
+struct FrameData
+{
+	static constexpr unsigned int BINDING = 0;
+
+	static constexpr const char* BLOCK_NAME = "FrameData";
+
+
+
+	glm::mat4 view;
+
+	glm::mat4 projection;
+
+	glm::mat4 viewProjection;
+
+	/// <summary>
+	/// Seconds since the renderer was initialized
+	/// </summary>
+	float time;
+
+	/// <summary>
+	/// std140 aligns vec2 to 8 bytes
+	/// </summary>
+	float padding;
+
+	glm::vec2 viewport;
+};
+
+
+#endif /* FrameData_H_ */
+
+
+
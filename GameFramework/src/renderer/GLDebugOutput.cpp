@@ -0,0 +1,114 @@
+#include "renderer/GLDebugOutput.h"
+#include "renderer/RendererFondation.h"
+#include "utilities/Loggers.hpp"
+
+
+
+
+static bool s_isEnabled = false;
+
+static std::string s_scope;
+
+
+
+const char* getGL_DebugSource(GLenum sourceIn)
+{
+	switch (sourceIn)
+	{
+	case GL_DEBUG_SOURCE_API:
+		return "API";
+
+	case GL_DEBUG_SOURCE_WINDOW_SYSTEM:
+		return "Window System";
+
+	case GL_DEBUG_SOURCE_SHADER_COMPILER:
+		return "Shader Compiler";
+
+	case GL_DEBUG_SOURCE_THIRD_PARTY:
+		return "Third Party";
+
+	case GL_DEBUG_SOURCE_APPLICATION:
+		return "Application";
+
+	default:
+		return "Other";
+	}
+}
+
+
+
+void APIENTRY onGL_DebugMessage(GLenum sourceIn, GLenum typeIn, GLuint idIn, GLenum severityIn, GLsizei, const GLchar* messageIn, const void*)
+{
+	const char* source = getGL_DebugSource(sourceIn);
+	switch (severityIn)
+	{
+	case GL_DEBUG_SEVERITY_HIGH:
+		Loggers::getLog()->error("OpenGL {0} [{1}] in '{2}': {3}", source, idIn, s_scope, messageIn);
+		break;
+
+	case GL_DEBUG_SEVERITY_MEDIUM:
+		Loggers::getLog()->warn("OpenGL {0} [{1}] in '{2}': {3}", source, idIn, s_scope, messageIn);
+		break;
+
+	case GL_DEBUG_SEVERITY_LOW:
+		Loggers::getLog()->info("OpenGL {0} [{1}] in '{2}': {3}", source, idIn, s_scope, messageIn);
+		break;
+
+	default:
+		Loggers::getLog()->trace("OpenGL {0} [{1}] in '{2}': {3}", source, idIn, s_scope, messageIn);
+		break;
+	}
+
+	if (typeIn == GL_DEBUG_TYPE_ERROR)
+		Loggers::getLog()->flush();
+}
+
+
+
+void GLDebugOutput::enable()
+{
+	if (s_isEnabled)
+		return;
+
+	int flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT))
+		Loggers::getLog()->warn("The OpenGL context is not a debug context, some debug messages may not be reported");
+
+	glEnable(GL_DEBUG_OUTPUT);
+	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glDebugMessageCallback(onGL_DebugMessage, nullptr);
+	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+	s_isEnabled = true;
+	Loggers::getLog()->info("OpenGL debug output has been enabled");
+}
+
+
+
+void GLDebugOutput::disable()
+{
+	if (!s_isEnabled)
+		return;
+
+	glDebugMessageCallback(nullptr, nullptr);
+	glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glDisable(GL_DEBUG_OUTPUT);
+	s_isEnabled = false;
+}
+
+
+
+bool GLDebugOutput::isEnabled()
+{
+	return s_isEnabled;
+}
+
+
+
+void GLDebugOutput::setScope(const std::string& scopeIn)
+{
+	s_scope = scopeIn;
+}
+
+
+
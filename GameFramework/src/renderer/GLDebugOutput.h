@@ -0,0 +1,57 @@
+#ifndef GLDebugOutput_H_
+#define GLDebugOutput_H_
+
+#include <string>
+
+
+
+
+/// <summary>
+/// Forwards the driver's GL_KHR_debug messages into the core logger
+/// <para>
+/// Messages are delivered synchronously, so they are reported from inside the OpenGL call that caused them.
+/// The current scope is logged with each message so that an error can be traced back to the batch that made it
+/// </para>
+/// </summary>
+class GLDebugOutput
+{
+public:
+
+	GLDebugOutput() = delete;
+
+
+
+	/// <summary>
+	/// Starts forwarding debug messages, the OpenGL context should have been created with the debug flag
+	/// </summary>
+	static void enable();
+
+
+
+	/// <summary>
+	/// Stops forwarding debug messages
+	/// </summary>
+	static void disable();
+
+
+
+	/// <summary>
+	/// Checks if debug messages are being forwarded
+	/// </summary>
+	/// <returns></returns>
+	static bool isEnabled();
+
+
+
+	/// <summary>
+	/// Sets the name that is logged with every message until the scope is changed
+	/// </summary>
+	/// <param name="scopeIn"></param>
+	static void setScope(const std::string& scopeIn);
+};
+
+
+#endif /* GLDebugOutput_H_ */
+
+
+
@@ -0,0 +1,180 @@
+#include <SDL.h>
+
+#include "renderer/RenderThread.h"
+#include "renderer/screen/Window.h"
+#include "utilities/Assertions.h"
+
+
+
+
+using Milliseconds = std::chrono::duration<float, std::milli>;
+
+
+
+RenderThread::RenderThread()
+{
+	m_logger = Loggers::getLog();
+}
+
+
+
+RenderThread::~RenderThread()
+{
+	stop();
+}
+
+
+
+void RenderThread::start(Window& windowIn, Renderer& rendererIn)
+{
+	if (isRunning())
+	{
+		m_logger->warn("The render thread has already been started");
+		return;
+	}
+
+	m_window = &windowIn;
+	m_renderer = &rendererIn;
+	m_renderer->setDeferred(true);
+	m_packet = nullptr;
+	m_quit = false;
+	m_renderPacing = Statistics();
+	m_statistics = Statistics();
+	m_lastSubmit = std::chrono::steady_clock::now();
+
+	// A context can only be current on one thread at a time
+	if (SDL_GL_MakeCurrent(m_window->get(), nullptr) != 0)
+		m_logger->error("Unable to release the OpenGL context: SDL error: {0}", SDL_GetError());
+
+	// Tasks queued from now on are run by the render thread, which is woken up for them even when no frame is waiting
+	m_renderer->m_contextQueue.setListener([this]()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+			}
+			m_signal.notify_all();
+		});
+	m_thread = std::thread(&RenderThread::loop, this);
+	m_renderer->m_contextQueue.setOwner(m_thread.get_id());
+	m_logger->info("Render thread has been started");
+}
+
+
+
+void RenderThread::stop()
+{
+	if (!isRunning())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_quit = true;
+	}
+	m_signal.notify_all();
+	m_thread.join();
+
+	if (SDL_GL_MakeCurrent(m_window->get(), m_window->getGlContext()) != 0)
+		m_logger->error("Unable to make the OpenGL context current: SDL error: {0}", SDL_GetError());
+
+	// Anything queued after the render thread's last frame is run now that the context is back
+	m_renderer->m_contextQueue.setListener(nullptr);
+	m_renderer->m_contextQueue.setOwner(std::this_thread::get_id());
+	m_renderer->runTasks();
+
+	m_renderer->setDeferred(false);
+	m_logger->info("Render thread has been stopped");
+}
+
+
+
+void RenderThread::submitFrame()
+{
+	GAME_ASSERT(isRunning());
+	auto now = std::chrono::steady_clock::now();
+	m_statistics.mainFrameTime = Milliseconds(now - m_lastSubmit).count();
+	m_lastSubmit = now;
+
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+		m_signal.wait(lock, [this]() { return m_packet == nullptr; });
+		m_statistics.mainWaitTime = Milliseconds(std::chrono::steady_clock::now() - now).count();
+
+		m_statistics.renderFrameTime = m_renderPacing.renderFrameTime;
+		m_statistics.renderWaitTime = m_renderPacing.renderWaitTime;
+		m_statistics.swapTime = m_renderPacing.swapTime;
+	}
+
+	// The packets are swapped without the lock since queueing the texture uploads wakes the render thread, which takes it
+	Renderer::FramePacket& packet = m_renderer->swapPackets();
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_packet = &packet;
+	}
+	m_signal.notify_all();
+}
+
+
+
+bool RenderThread::isRunning() const
+{
+	return m_thread.joinable();
+}
+
+
+
+const RenderThread::Statistics& RenderThread::getStatistics() const
+{
+	return m_statistics;
+}
+
+
+
+void RenderThread::loop()
+{
+	if (SDL_GL_MakeCurrent(m_window->get(), m_window->getGlContext()) != 0)
+	{
+		m_logger->critical("Unable to make the OpenGL context current on the render thread: SDL error: {0}", SDL_GetError());
+		__debugbreak();
+	}
+
+	while (true)
+	{
+		auto waitStart = std::chrono::steady_clock::now();
+		Renderer::FramePacket* packet = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_signal.wait(lock, [this]() { return m_packet != nullptr || m_quit || m_renderer->m_contextQueue.hasTasks(); });
+			if (m_packet == nullptr && m_quit)
+				break;
+			packet = m_packet;
+		}
+
+		// The main thread may be waiting on a task, such as loading a texture, while it has no frame to submit
+		if (packet == nullptr)
+		{
+			m_renderer->runTasks();
+			continue;
+		}
+
+		auto drawStart = std::chrono::steady_clock::now();
+		m_renderer->drawPacket(*packet);
+
+		auto swapStart = std::chrono::steady_clock::now();
+		m_window->update();
+		auto drawEnd = std::chrono::steady_clock::now();
+
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_renderPacing.renderWaitTime = Milliseconds(drawStart - waitStart).count();
+			m_renderPacing.renderFrameTime = Milliseconds(drawEnd - drawStart).count();
+			m_renderPacing.swapTime = Milliseconds(drawEnd - swapStart).count();
+			m_packet = nullptr;
+		}
+		m_signal.notify_all();
+	}
+
+	SDL_GL_MakeCurrent(m_window->get(), nullptr);
+}
+
+
+
@@ -0,0 +1,162 @@
+#ifndef RenderThread_H_
+#define RenderThread_H_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "renderer/Renderer.h"
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// A thread that owns the OpenGL context and draws the frames that are recorded by the main thread
+/// <para>
+/// While the render thread draws and presents one frame the main thread records the next, so waiting on vsync no longer 
+/// delays the application's logic. Once the render thread has started any call that needs the OpenGL context has to be queued 
+/// with Renderer::enqueueTask or Renderer::runOnContext, which the asset librarian does for its shaders and textures
+/// </para>
+/// </summary>
+class RenderThread
+{
+public:
+
+	/// <summary>
+	/// Frame pacing of both threads, all times are measured in milliseconds
+	/// </summary>
+	struct Statistics
+	{
+		/// <summary>
+		/// The time between the last two frames that the main thread submitted
+		/// </summary>
+		float mainFrameTime = 0.0f;
+
+		/// <summary>
+		/// The time that the main thread spent waiting for the render thread to finish the previous frame
+		/// </summary>
+		float mainWaitTime = 0.0f;
+
+		/// <summary>
+		/// The time that the render thread spent drawing and presenting its last frame
+		/// </summary>
+		float renderFrameTime = 0.0f;
+
+		/// <summary>
+		/// The time that the render thread spent waiting for the main thread to submit its last frame
+		/// </summary>
+		float renderWaitTime = 0.0f;
+
+		/// <summary>
+		/// The part of the render thread's frame time that was spent swapping the window's buffers
+		/// </summary>
+		float swapTime = 0.0f;
+	};
+
+
+
+	RenderThread();
+
+
+
+	RenderThread(const RenderThread& other) = delete;
+
+
+
+	RenderThread(RenderThread&& other) = delete;
+
+
+
+	~RenderThread();
+
+
+
+	/// <summary>
+	/// Moves the window's OpenGL context to a new render thread, the renderer is deferred until the thread is stopped
+	/// </summary>
+	/// <param name="windowIn"></param>
+	/// <param name="rendererIn"></param>
+	void start(class Window& windowIn, Renderer& rendererIn);
+
+
+
+	/// <summary>
+	/// Waits for the render thread to finish its current frame and gives the OpenGL context back to the calling thread
+	/// </summary>
+	void stop();
+
+
+
+	/// <summary>
+	/// Hands the frame recorded since the last submit over to the render thread
+	/// <para>This blocks until the render thread has finished the previous frame, so the main thread is never more than one frame ahead</para>
+	/// </summary>
+	void submitFrame();
+
+
+
+	/// <summary>
+	/// Checks if the render thread is running
+	/// </summary>
+	/// <returns></returns>
+	bool isRunning() const;
+
+
+
+	/// <summary>
+	/// Gets the frame pacing that was measured when the last frame was submitted
+	/// </summary>
+	/// <returns></returns>
+	const Statistics& getStatistics() const;
+
+
+
+private:
+
+	/// <summary>
+	/// The render thread's loop, it draws and presents each submitted frame until the thread is stopped
+	/// </summary>
+	void loop();
+
+
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	std::thread m_thread;
+
+	class Window* m_window = nullptr;
+
+	Renderer* m_renderer = nullptr;
+
+
+
+	std::mutex m_lock;
+
+	std::condition_variable m_signal;
+
+	/// <summary>
+	/// The frame waiting to be drawn or being drawn, null once the render thread has finished it
+	/// </summary>
+	Renderer::FramePacket* m_packet = nullptr;
+
+	bool m_quit = false;
+
+
+
+	std::chrono::steady_clock::time_point m_lastSubmit;
+
+	/// <summary>
+	/// Written by the render thread and copied into the statistics by the main thread, both while holding the lock
+	/// </summary>
+	Statistics m_renderPacing;
+
+	Statistics m_statistics;
+};
+
+
+#endif /* RenderThread_H_ */
+
+
+
@@ -1,18 +1,36 @@
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define RENDERER_SSE_CULLING
+#endif
+
 #include <spdlog/spdlog.h>
+#include <glm/gtc/packing.hpp>
 
 #include "renderer/Renderer.h"
 #include "renderer/RendererFondation.h"
+#include "renderer/GLDebugOutput.h"
+#include "renderer/FrameData.h"
 #include "renderer/shaders/Shader.h"
 #include "renderer/screen/Camera.h"
+#include "renderer/texture/BindlessTexture.h"
+#include "world/TileMap.h"
 #include "utilities/Assertions.h"
 
 
 
 
 Renderer::Renderer()
-	: m_defaultShaderName("FlatSprite")
 {
 	m_logger = Loggers::getLog();
+	m_defaultShader.name = "FlatSprite";
+	m_instancedShader.name = "FlatSpriteInstanced";
+	m_arrayShader.name = "FlatSpriteArray";
+	m_instancedArrayShader.name = "FlatSpriteArrayInstanced";
 }
 
 
@@ -26,26 +44,76 @@ void Renderer::init(unsigned int maxQuadsPerBatch)
 	m_hasBeenInit = true;
 	m_maxQuadsPerBatch = maxQuadsPerBatch;
 
+	// The renderer is initialized by the thread that owns the context, the render thread takes it over once started
+	m_contextQueue.setOwner(std::this_thread::get_id());
+	m_librarian.setContextQueue(&m_contextQueue);
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	m_librarian.addShader(m_defaultShaderName, "data/shaders/flatSprite.vsh", "data/shaders/flatSprite.psh");
-
-	VertexBuffer::Layout layout;
-	layout.add(VertexBuffer::Attribute::Float3, "a_pos")
-		  .add(VertexBuffer::Attribute::Float4, "a_color")
-		  .add(VertexBuffer::Attribute::Float2, "a_texCord")
-		  .add(VertexBuffer::Attribute::Float1, "a_texSlot");
+	// The frame data buffer must exist before any shader is loaded so every shader can share it
+	m_frameUniforms.create(static_cast<unsigned int>(sizeof(FrameData)), FrameData::BINDING);
+	m_startTime = std::chrono::steady_clock::now();
+
+	loadSpriteShader(m_defaultShader, "data/shaders/flatSprite.vsh", "data/shaders/flatSprite.psh", "u_texSlots[0]");
+	loadSpriteShader(m_instancedShader, "data/shaders/flatSpriteInstanced.vsh", "data/shaders/flatSprite.psh", "u_texSlots[0]");
+
+	// The texture array shaders use bindless textures when the driver supports them
+	m_bindlessTextures = BindlessTexture::load();
+	if (m_bindlessTextures)
+		m_textureArrayHandles.create(DEFAULT_NUMBER_OF_TEXTURE_SLOTS * static_cast<unsigned int>(sizeof(uint64_t)), TEXTURE_ARRAY_HANDLES_BINDING);
+	// The pixel shader is picked by whether the bindless functions loaded, not by whether the shader compiler knows the extension. 
+	// With bindless textures the array shaders read their handles from a storage buffer and have no sampler uniforms
+	const std::filesystem::path arraysShader = m_bindlessTextures ? "data/shaders/flatSpriteArrayBindless.psh" : "data/shaders/flatSpriteArray.psh";
+	const std::string arraysUniform = m_bindlessTextures ? "" : "u_textureArrays[0]";
+	loadSpriteShader(m_arrayShader, "data/shaders/flatSprite.vsh", arraysShader, arraysUniform);
+	loadSpriteShader(m_instancedArrayShader, "data/shaders/flatSpriteInstanced.vsh", arraysShader, arraysUniform);
+
+	m_librarian.createPlaceholderTexture();
+
+	m_quadLayout.add(VertexBuffer::Attribute::Float3, "a_pos")
+				.add(VertexBuffer::Attribute::UByte4, "a_color", true)
+				.add(VertexBuffer::Attribute::Half2, "a_texCord")
+				.add(VertexBuffer::Attribute::UInt1, "a_texSlot");
+	GAME_ASSERT(m_quadLayout.stride() == sizeof(QuadVertex));
+
+	// Each frame writes its batches into its own segment of the rings, and fences it once, so the CPU only waits on a 
+	// segment that the GPU is still drawing from frames ago
+	m_vertexStride = m_quadLayout.stride();
+	m_vertexRing.create(StreamingBuffer::Target::Vertex, BATCHES_PER_RING_SEGMENT * m_maxQuadsPerBatch * NUMBER_OF_VERTICES_PER_QUAD * m_vertexStride);
+	m_vbo.create(m_vertexRing);
+	m_vbo.setLayout(m_quadLayout);
+
+	// The index pattern of every quad is the same, so all indices are built once and the base vertex selects the batch.
+	// Tile map chunk meshes share these indices, so there are enough for a full chunk layer as well
+	const unsigned int numberOfQuadIndices = static_cast<unsigned int>(std::max(m_maxQuadsPerBatch, TileMap::CHUNK_SIZE * TileMap::CHUNK_SIZE));
+	std::vector<unsigned int> indices(static_cast<size_t>(numberOfQuadIndices) * NUMBER_OF_INDICES_PER_QUAD);
+	for (unsigned int quad = 0, vertex = 0; quad < numberOfQuadIndices; quad++, vertex += NUMBER_OF_VERTICES_PER_QUAD)
+	{
+		unsigned int* index = &indices[static_cast<size_t>(quad) * NUMBER_OF_INDICES_PER_QUAD];
+		index[0] = vertex + 0;
+		index[1] = vertex + 1;
+		index[2] = vertex + 2;
+		index[3] = vertex + 2;
+		index[4] = vertex + 3;
+		index[5] = vertex + 0;
+	}
+	m_quadIndices.create(indices.data(), static_cast<unsigned int>(indices.size()), IndexBuffer::Usage::Static);
 
-	unsigned int vertexBufferSize = m_maxQuadsPerBatch * NUMBER_OF_VERTICES_PER_QUAD * layout.count() * static_cast<unsigned int>(sizeof(float));
-	m_vbo.create(nullptr, vertexBufferSize, VertexBuffer::Usage::Dynamic);
-	m_vbo.setLayout(layout);
+	VertexBuffer::Layout instanceLayout;
+	instanceLayout.add(VertexBuffer::Attribute::Float3, "a_pos")
+				  .add(VertexBuffer::Attribute::Float2, "a_size")
+				  .add(VertexBuffer::Attribute::UByte4, "a_color", true)
+				  .add(VertexBuffer::Attribute::Float4, "a_texRect")
+				  .add(VertexBuffer::Attribute::UInt1, "a_texSlot")
+				  .setDivisor(1);
+	GAME_ASSERT(instanceLayout.stride() == sizeof(QuadInstance));
 
-	unsigned int indexBufferCount = m_maxQuadsPerBatch * NUMBER_OF_INDICES_PER_QUAD;
-	m_ibo.create(nullptr, indexBufferCount, IndexBuffer::Usage::Dynamic);
+	m_instanceRing.create(StreamingBuffer::Target::Vertex, BATCHES_PER_RING_SEGMENT * m_maxQuadsPerBatch * static_cast<unsigned int>(sizeof(QuadInstance)));
+	m_instanceVbo.create(m_instanceRing);
+	m_instanceVbo.setLayout(instanceLayout);
 
 	m_maxTexturesSlotsPerBatch = DEFAULT_NUMBER_OF_TEXTURE_SLOTS;
-	m_activeTextures.reserve(m_maxTexturesSlotsPerBatch);
 
 	m_logger->info("Renderer has been initialized");
 }
@@ -56,8 +124,15 @@ void Renderer::shutdown()
 {
 	m_logger->info("Shutting down Renderer");
 
-	m_ibo.destroy();
+	m_tileChunkMeshes.clear();
+	m_tileChunkRecords.clear();
+	m_frameUniforms.destroy();
+	m_textureArrayHandles.destroy();
+	m_quadIndices.destroy();
 	m_vbo.destroy();
+	m_vertexRing.destroy();
+	m_instanceVbo.destroy();
+	m_instanceRing.destroy();
 
 	m_logger->info("Rendering stopped");
 }
@@ -66,15 +141,65 @@ void Renderer::shutdown()
 
 void Renderer::begin(const std::shared_ptr<Camera>& cameraIn)
 {
+	GAME_ASSERT(m_pass == nullptr);
 	m_camera = cameraIn;
+	m_pass = &acquirePass();
+
+	FrameData& frame = m_pass->frame;
+	frame.view = m_camera->getView();
+	frame.projection = m_camera->getProjection();
+	frame.viewProjection = m_camera->getViewProjection();
+	frame.time = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_startTime).count();
+	frame.padding = 0.0f;
+	frame.viewport = { m_camera->width(), m_camera->height() };
+
+	if (m_culling)
+	{
+		const glm::vec2& min = m_camera->getVisibleMin();
+		const glm::vec2& max = m_camera->getVisibleMax();
+		m_cullBounds[0] = max.x;
+		m_cullBounds[1] = max.y;
+		m_cullBounds[2] = -min.x;
+		m_cullBounds[3] = -min.y;
+	}
+	else
+	{
+		// Every quad passes the test against an infinite rectangle
+		for (float& bound : m_cullBounds)
+			bound = std::numeric_limits<float>::infinity();
+	}
+
+	// Chunk meshes are only checked every so often since most passes draw the same chunks as the pass before
+	if (m_passNumber % 64 == 0)
+		evictTileChunks();
+
+	if (m_pendingClear)
+	{
+		m_pass->clear = true;
+		m_pass->clearColor = m_pendingClearColor;
+		m_pendingClear = false;
+	}
 }
 
 
 
 void Renderer::clear(float red, float green, float blue, float alpha)
 {
-	glClearColor(red, green, blue, alpha);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	if (m_pass != nullptr)
+	{
+		m_pass->clear = true;
+		m_pass->clearColor = { red, green, blue, alpha };
+	}
+	else if (m_deferred)
+	{
+		m_pendingClear = true;
+		m_pendingClearColor = { red, green, blue, alpha };
+	}
+	else
+	{
+		glClearColor(red, green, blue, alpha);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
 }
 
 
@@ -86,9 +211,149 @@ void Renderer::clear()
 
 
 
+void Renderer::setBatchMode(BatchMode modeIn)
+{
+	m_batchMode = modeIn;
+}
+
+
+
+Renderer::BatchMode Renderer::getBatchMode() const
+{
+	return m_batchMode;
+}
+
+
+
+void Renderer::setTextureBackend(TextureBackend backendIn)
+{
+	m_textureBackend = backendIn;
+	if (m_textureBackend == TextureBackend::Arrays)
+		m_librarian.enableTextureArrays();
+}
+
+
+
+Renderer::TextureBackend Renderer::getTextureBackend() const
+{
+	return m_textureBackend;
+}
+
+
+
+void Renderer::setValidation(Validation validationIn)
+{
+	// The cached results are used by the thread that draws, so they are cleared along with the debug output on that thread
+	runOnContext([this, validationIn]()
+		{
+			m_validation = validationIn;
+			m_validatedStates.clear();
+
+			if (m_validation == Validation::Full)
+				GLDebugOutput::enable();
+			else
+				GLDebugOutput::disable();
+		});
+}
+
+
+
+Renderer::Validation Renderer::getValidation() const
+{
+	return m_validation;
+}
+
+
+
+void Renderer::setCulling(bool enabledIn)
+{
+	m_culling = enabledIn;
+}
+
+
+
+bool Renderer::isCulling() const
+{
+	return m_culling;
+}
+
+
+
+bool Renderer::cull(const glm::vec3& posIn, const glm::vec2& sizeIn)
+{
+#ifdef RENDERER_SSE_CULLING
+	// The quad is packed as { min x, min y, -max x, -max y } so that all four overlap tests are one compare against the bounds
+	const __m128 corner = _mm_setr_ps(posIn.x, posIn.y, posIn.x, posIn.y);
+	const __m128 opposite = _mm_add_ps(corner, _mm_setr_ps(sizeIn.x, sizeIn.y, sizeIn.x, sizeIn.y));
+	__m128 quad = _mm_movelh_ps(_mm_min_ps(corner, opposite), _mm_max_ps(corner, opposite));
+	quad = _mm_xor_ps(quad, _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f));
+	const bool visible = _mm_movemask_ps(_mm_cmple_ps(quad, _mm_load_ps(m_cullBounds))) == 0xF;
+#else
+	const glm::vec2 corner(posIn.x, posIn.y);
+	const glm::vec2 min = glm::min(corner, corner + sizeIn);
+	const glm::vec2 max = glm::max(corner, corner + sizeIn);
+	const bool visible = min.x <= m_cullBounds[0] && min.y <= m_cullBounds[1] && -max.x <= m_cullBounds[2] && -max.y <= m_cullBounds[3];
+#endif
+
+	if (visible)
+		m_pass->quadsVisible++;
+	else
+		m_pass->quadsCulled++;
+	return visible;
+}
+
+
+
+void Renderer::setDeferred(bool deferredIn)
+{
+	GAME_ASSERT(m_pass == nullptr);
+	m_deferred = deferredIn;
+
+	// Anything recorded for the other mode is dropped, including chunk rebuilds, so every chunk is rebuilt the next time it is drawn
+	for (FramePacket& packet : m_packets)
+		packet.numberOfPasses = 0;
+	m_pendingClear = false;
+	m_tileChunkRecords.clear();
+}
+
+
+
+bool Renderer::isDeferred() const
+{
+	return m_deferred;
+}
+
+
+
+void Renderer::enqueueTask(std::function<void()> taskIn)
+{
+	m_contextQueue.post(std::move(taskIn));
+}
+
+
+
+void Renderer::runOnContext(const std::function<void()>& taskIn)
+{
+	m_contextQueue.run(taskIn);
+}
+
+
+
+void Renderer::runTasks()
+{
+	m_contextQueue.runTasks();
+}
+
+
+
 void Renderer::drawQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn)
 {
-	m_quadDrawQueue.emplace(posIn, sizeIn, colorIn);
+	GAME_ASSERT(m_pass != nullptr);
+	if (!cull(posIn, sizeIn))
+		return;
+
+	// Solid color quads use texture 0 in their sort key so they are grouped before all textured quads in the same layer
+	m_pass->commands.push(SortKey::make(SortKey::depthToLayer(posIn.z), 0, 0, 0), { posIn, sizeIn, colorIn, -1, 0 });
 }
 
 
@@ -102,108 +367,365 @@ void Renderer::drawQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const g
 
 void Renderer::drawQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const std::string& textureNameIn, unsigned int spriteIndexIn)
 {
-	auto texture = m_librarian.getTexture(textureNameIn).lock();
+	drawQuad(posIn, sizeIn, colorIn, m_librarian.getTextureHandle(textureNameIn), spriteIndexIn);
+}
+
+
+
+void Renderer::drawQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, TextureHandle textureIn)
+{
+	drawQuad(posIn, sizeIn, colorIn, textureIn, 0);
+}
+
+
+
+void Renderer::drawQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, TextureHandle textureIn, unsigned int spriteIndexIn)
+{
+	GAME_ASSERT(m_pass != nullptr);
+	if (!cull(posIn, sizeIn))
+		return;
 
-	if (m_activeTexturesLookup.find(textureNameIn) == m_activeTexturesLookup.end())
+	int textureID = activateTexture(textureIn);
+	if (textureID < 0)
 	{
-		m_activeTexturesLookup[textureNameIn] = m_nextTextureSlot++;
-		m_activeTextures.push_back(m_librarian.getTexture(textureNameIn));
+		m_pass->commands.push(SortKey::make(SortKey::depthToLayer(posIn.z), 0, 0, 0), { posIn, sizeIn, colorIn, -1, 0 });
+		return;
 	}
 
-	m_quadDrawQueue.emplace(posIn, sizeIn, colorIn, m_activeTexturesLookup[textureNameIn], spriteIndexIn);
+	// With texture arrays, quads are grouped by array rather than by texture since every layer of an array can share a batch.
+	// Likewise textures packed into the same texture page are grouped by the page
+	int textureGroup = m_textureBackend == TextureBackend::Arrays ? m_pass->textureLayers[textureID].array : m_pass->textureBindings[textureID];
+	m_pass->commands.push(SortKey::make(SortKey::depthToLayer(posIn.z), 0, textureGroup + 1, 0), { posIn, sizeIn, colorIn, textureID, spriteIndexIn });
 }
 
 
 
-void Renderer::end()
+int Renderer::activateTexture(TextureHandle textureIn)
 {
-	m_vbo.bind();
-	m_ibo.bind();
+	if (textureIn.index() < m_activeTextures.size())
+	{
+		const ActiveTexture& active = m_activeTextures[textureIn.index()];
+		if (active.pass == m_passNumber && active.handle == textureIn)
+			return active.index;
+	}
+
+	// Only the first quad of each texture in a pass gets here
+	std::shared_ptr<Texture> texture = m_librarian.getTexture(textureIn).lock();
+	if (!texture)
+		return -1;
+
+	if (textureIn.index() >= m_activeTextures.size())
+		m_activeTextures.resize(m_librarian.numberOfTextureSlots());
 
-	int lastTextureSlot = -1;
-	while (!m_quadDrawQueue.empty())
+	int textureID = static_cast<int>(m_pass->textures.size());
+	m_activeTextures[textureIn.index()] = { textureIn, m_passNumber, textureID };
+
+	if (m_textureBackend == TextureBackend::Arrays)
 	{
-		QuadDrawCommand command = m_quadDrawQueue.top();
+		const TextureArrayLayer* layer = m_librarian.findTextureLayer(*texture);
+		if (layer == nullptr)
+			m_logger->warn("Texture '{0}' is not in a texture array and will be drawn as a solid color", texture->location().string());
+		m_pass->textureLayers.push_back(layer != nullptr ? *layer : TextureArrayLayer{ -1, 0 });
+	}
 
-		if (command.hasTexture)
+	int binding = textureID;
+	if (texture->isPacked())
+	{
+		for (int i = 0; i < textureID; i++)
 		{
-			if (lastTextureSlot != command.textureID)
+			if (m_pass->textures[i]->getNativeID() == texture->getNativeID())
 			{
-				lastTextureSlot = command.textureID;
-				m_textureSlotsInCurrentBatch++;
+				binding = i;
+				break;
+			}
+		}
+	}
+	m_pass->textureBindings.push_back(binding);
+
+	m_pass->textures.push_back(std::move(texture));
+	return textureID;
+}
+
+
+
+void Renderer::end()
+{
+	GAME_ASSERT(m_pass != nullptr);
+
+	// The mode and backend are latched for the whole pass so a batch is never split across both paths, and so the 
+	// thread that draws the pass never reads them while the main thread changes them
+	m_pass->batchMode = m_batchMode;
+	m_pass->textureBackend = m_textureBackend;
+
+	Pass& pass = *m_pass;
+	m_pass = nullptr;
+	m_camera.reset();
+	m_passNumber++;
 
+	if (!m_deferred)
+	{
+		drawPass(pass);
+
+		// Passes drawn straight away are not kept, so the next pass reuses this one
+		m_packets[m_recordingPacket].numberOfPasses = 0;
+	}
+}
+
+
+
+void Renderer::endFrame()
+{
+	if (m_deferred)
+	{
+		m_logger->warn("Renderer::endFrame was called while the renderer is deferred");
+		return;
+	}
+
+	m_librarian.updateTextureLoads([](std::function<void()> uploadIn) { uploadIn(); });
+	runTasks();
+
+	m_vertexRing.release();
+	m_instanceRing.release();
+
+	m_statistics = m_frameStatistics;
+	m_frameStatistics = Statistics();
+}
+
+
+
+Renderer::Pass& Renderer::acquirePass()
+{
+	FramePacket& packet = m_packets[m_recordingPacket];
+	if (packet.numberOfPasses == packet.passes.size())
+	{
+		packet.passes.push_back(std::make_unique<Pass>());
+		packet.passes.back()->commands.reserve(m_maxQuadsPerBatch);
+		packet.passes.back()->textures.reserve(m_maxTexturesSlotsPerBatch);
+	}
+
+	Pass& pass = *packet.passes[packet.numberOfPasses++];
+	pass.clear = false;
+	pass.quadsVisible = 0;
+	pass.quadsCulled = 0;
+	pass.commands.clear();
+	pass.textures.clear();
+	pass.textureLayers.clear();
+	pass.textureBindings.clear();
+	pass.tileChunks.clear();
+	pass.tileVertices.clear();
+	pass.evictedTileChunks.clear();
+	return pass;
+}
+
+
+
+void Renderer::drawPacket(FramePacket& packetIn)
+{
+	runTasks();
+
+	for (size_t i = 0; i < packetIn.numberOfPasses; i++)
+		drawPass(*packetIn.passes[i]);
+
+	m_vertexRing.release();
+	m_instanceRing.release();
+
+	packetIn.statistics = m_frameStatistics;
+	m_frameStatistics = Statistics();
+}
+
+
+
+Renderer::FramePacket& Renderer::swapPackets()
+{
+	GAME_ASSERT(m_pass == nullptr);
+	FramePacket& recorded = m_packets[m_recordingPacket];
+
+	// The other packet has been drawn, so it holds the statistics of the last finished frame
+	m_recordingPacket = 1 - m_recordingPacket;
+	FramePacket& next = m_packets[m_recordingPacket];
+	m_statistics = next.statistics;
+	next.numberOfPasses = 0;
+
+	// Textures are uploaded by the render thread before it draws the recorded packet
+	m_librarian.updateTextureLoads([this](std::function<void()> uploadIn) { enqueueTask(std::move(uploadIn)); });
+
+	return recorded;
+}
+
+
+
+void Renderer::drawPass(Pass& passIn)
+{
+	m_drawingPass = &passIn;
+	m_currentTextureBackend = passIn.textureBackend;
+	m_frameStatistics.quadsVisible += passIn.quadsVisible;
+	m_frameStatistics.quadsCulled += passIn.quadsCulled;
+	m_frameUniforms.submitData(&passIn.frame, static_cast<unsigned int>(sizeof(passIn.frame)));
+
+	if (passIn.clear)
+	{
+		glClearColor(passIn.clearColor.r, passIn.clearColor.g, passIn.clearColor.b, passIn.clearColor.a);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+
+	for (const TileChunkKey& key : passIn.evictedTileChunks)
+		m_tileChunkMeshes.erase(key);
+
+	for (const TileChunkDraw& draw : passIn.tileChunks)
+		drawTileChunk(passIn, draw);
+
+	DrawCommandBuffer& commands = passIn.commands;
+	commands.sort();
+
+	const bool arrays = m_currentTextureBackend == TextureBackend::Arrays;
+	const bool bindlessArrays = arrays && m_bindlessTextures;
+	m_batchTextureSlots.assign(arrays ? m_librarian.numberOfTextureArrays() : passIn.textures.size(), 0);
+	if (bindlessArrays)
+		updateTextureArrayHandles();
+
+	m_currentBatchMode = passIn.batchMode;
+	if (m_currentBatchMode == BatchMode::Instanced)
+		m_instanceVbo.bind();
+	else
+	{
+		m_vbo.bind();
+		m_quadIndices.bind();
+	}
+
+	for (const DrawCommandBuffer::Entry& entry : commands.entries())
+	{
+		const QuadDrawCommand& command = commands.get(entry);
+
+		// The texture slots hold either textures or texture arrays depending on the backend
+		int resource = command.textureID;
+		unsigned int layer = 0;
+		if (arrays && resource >= 0)
+		{
+			layer = passIn.textureLayers[resource].layer;
+			resource = passIn.textureLayers[resource].array;
+		}
+		else if (resource >= 0)
+			resource = passIn.textureBindings[resource];
+
+		if (resource >= 0)
+		{
+			// Bindless texture arrays are found by their index in the handle buffer, so they never fill up the batch's texture slots
+			int slot = bindlessArrays ? resource + 1 : m_batchTextureSlots[resource];
+			if (slot == 0)
+			{
 				// It is -1 because texture slot 0 is reserved for non-texture solid color quads
 				if (m_textureSlotsInCurrentBatch >= (m_maxTexturesSlotsPerBatch - 1))
 				{
+					m_frameStatistics.batchBreaks++;
 					flush();
-					m_textureSlotsInCurrentBatch = 1;
-					m_textureSlotOffset = lastTextureSlot;
 				}
+
+				slot = ++m_textureSlotsInCurrentBatch;
+				m_batchTextures[slot] = resource;
+				m_batchTextureSlots[resource] = slot;
 			}
 
-			auto texture = m_activeTextures[command.textureID].lock();
+			// The texture array shader takes the slot in the upper 16 bits and the layer in the lower 16 bits
+			unsigned int textureSlot = arrays ? (static_cast<unsigned int>(slot) << 16) | layer : static_cast<unsigned int>(slot);
+
+			const Texture* texture = passIn.textures[command.textureID].get();
 			SubTexture subTexture = texture->getSubTexture(command.subTextureIndex);
-			bakeQuad(command.pos, command.size, command.color, subTexture, command.textureID - m_textureSlotOffset + 1.0f);
+			if (m_currentBatchMode == BatchMode::Instanced)
+				bakeInstance(command.pos, command.size, command.color, subTexture, textureSlot);
+			else
+				bakeQuad(command.pos, command.size, command.color, subTexture, textureSlot);
 		}
 		else
 		{
 			SubTexture subTexture = { { 0.0f, 0.0f }, { 1.0f, 1.0f } };
-			bakeQuad(command.pos, command.size, command.color, subTexture, 0.0f);
+			if (m_currentBatchMode == BatchMode::Instanced)
+				bakeInstance(command.pos, command.size, command.color, subTexture, 0);
+			else
+				bakeQuad(command.pos, command.size, command.color, subTexture, 0);
 		}
 
-		m_quadDrawQueue.pop();
-
 		if (m_quadsInCurrentBatch >= m_maxQuadsPerBatch)
+		{
+			m_frameStatistics.batchBreaks++;
 			flush();
+		}
 	}
 
 	flush();
 
-	m_ibo.unbind();
-	m_vbo.unbind();
-
-	m_camera.reset();
+	if (m_currentBatchMode == BatchMode::Instanced)
+		m_instanceVbo.unbind();
+	else
+	{
+		m_vbo.unbind();
+		m_quadIndices.unbind();
+	}
 
-	m_nextTextureSlot = 0;
 	m_textureSlotsInCurrentBatch = 0;
-	m_textureSlotOffset = 0;
-	m_activeTextures.clear();
-	m_activeTexturesLookup.clear();
+	m_drawingPass = nullptr;
+
+	// A texture removed while the pass was recorded is deleted here, by the thread that owns the context
+	passIn.textures.clear();
 }
 
 
 
-void Renderer::bakeQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, float textureSlotIn)
+void Renderer::bakeQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, unsigned int textureSlotIn)
 {
-	if (m_quadsInCurrentBatch > m_maxQuadsPerBatch)
+	if (m_quadsInCurrentBatch >= m_maxQuadsPerBatch)
 	{
 		m_logger->error("Tried to bake more quads than the maximum batch size");
 		return;
 	}
 
+	if (m_quadsInCurrentBatch == 0)
+		m_vertexRing.allocate(m_maxQuadsPerBatch * NUMBER_OF_VERTICES_PER_QUAD * m_vertexStride);
+
+	QuadVertex vertices[NUMBER_OF_VERTICES_PER_QUAD];
+	makeQuadVertices(vertices, posIn, sizeIn, colorIn, subTextureIn, textureSlotIn);
+	std::memcpy(static_cast<unsigned char*>(m_vertexRing.data()) + m_quadsInCurrentBatch * sizeof(vertices), vertices, sizeof(vertices));
+	m_frameStatistics.vertexBytesUploaded += sizeof(vertices);
+
+	m_quadsInCurrentBatch++;
+}
+
+
+
+void Renderer::makeQuadVertices(QuadVertex* verticesOut, const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, unsigned int textureSlotIn)
+{
 	glm::vec2 max(posIn.x + static_cast<float>(sizeIn.x), posIn.y + static_cast<float>(sizeIn.y));
 	glm::vec2 min(posIn.x, posIn.y);
 
-	float vertices[] = {
-		min.x, min.y, posIn.z, colorIn.r, colorIn.g, colorIn.b, colorIn.a, subTextureIn.min.x, subTextureIn.max.y, textureSlotIn,
-		max.x, min.y, posIn.z, colorIn.r, colorIn.g, colorIn.b, colorIn.a, subTextureIn.max.x, subTextureIn.max.y, textureSlotIn,
-		max.x, max.y, posIn.z, colorIn.r, colorIn.g, colorIn.b, colorIn.a, subTextureIn.max.x, subTextureIn.min.y, textureSlotIn,
-		min.x, max.y, posIn.z, colorIn.r, colorIn.g, colorIn.b, colorIn.a, subTextureIn.min.x, subTextureIn.min.y, textureSlotIn
-	};
-	m_vbo.submitData(vertices, sizeof(vertices), m_quadsInCurrentBatch * sizeof(vertices));
-
-	unsigned int indices[] = {
-		0 + m_nextVertexOffset, 
-		1 + m_nextVertexOffset, 
-		2 + m_nextVertexOffset, 
-		2 + m_nextVertexOffset, 
-		3 + m_nextVertexOffset, 
-		0 + m_nextVertexOffset
+	const uint32_t color = glm::packUnorm4x8(colorIn);
+	verticesOut[0] = { { min.x, min.y, posIn.z }, color, glm::packHalf2x16({ subTextureIn.min.x, subTextureIn.max.y }), textureSlotIn };
+	verticesOut[1] = { { max.x, min.y, posIn.z }, color, glm::packHalf2x16({ subTextureIn.max.x, subTextureIn.max.y }), textureSlotIn };
+	verticesOut[2] = { { max.x, max.y, posIn.z }, color, glm::packHalf2x16({ subTextureIn.max.x, subTextureIn.min.y }), textureSlotIn };
+	verticesOut[3] = { { min.x, max.y, posIn.z }, color, glm::packHalf2x16({ subTextureIn.min.x, subTextureIn.min.y }), textureSlotIn };
+}
+
+
+
+void Renderer::bakeInstance(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, unsigned int textureSlotIn)
+{
+	if (m_quadsInCurrentBatch >= m_maxQuadsPerBatch)
+	{
+		m_logger->error("Tried to bake more quads than the maximum batch size");
+		return;
+	}
+
+	if (m_quadsInCurrentBatch == 0)
+		m_instanceRing.allocate(m_maxQuadsPerBatch * static_cast<unsigned int>(sizeof(QuadInstance)));
+
+	QuadInstance instance = {
+		posIn,
+		sizeIn,
+		glm::packUnorm4x8(colorIn),
+		{ subTextureIn.min.x, subTextureIn.min.y, subTextureIn.max.x, subTextureIn.max.y },
+		textureSlotIn
 	};
-	m_ibo.submitData(indices, NUMBER_OF_INDICES_PER_QUAD, m_nextIndexOffset * sizeof(unsigned int));
+	std::memcpy(static_cast<QuadInstance*>(m_instanceRing.data()) + m_quadsInCurrentBatch, &instance, sizeof(instance));
+	m_frameStatistics.vertexBytesUploaded += sizeof(instance);
 
-	m_nextVertexOffset += NUMBER_OF_VERTICES_PER_QUAD;
-	m_nextIndexOffset += NUMBER_OF_INDICES_PER_QUAD;
 	m_quadsInCurrentBatch++;
 }
 
@@ -214,65 +736,347 @@ void Renderer::flush()
 	if (m_quadsInCurrentBatch == 0)
 		return;
 
-	auto shaderPtr = m_librarian.getShader(m_defaultShaderName);
-	auto shader = shaderPtr.lock();
+	const bool instanced = m_currentBatchMode == BatchMode::Instanced;
+	const bool arrays = m_currentTextureBackend == TextureBackend::Arrays;
+	const SpriteShader& spriteShader = getBatchShader();
+	auto shader = spriteShader.shader.lock();
 	shader->bind();
 
-	shader->setUniformMat4("u_camera", m_camera->getViewProjection());
-
+	// Bindless texture arrays are read from the handle storage buffer, which only changes when the arrays do
 	GAME_ASSERT(m_textureSlotsInCurrentBatch < DEFAULT_NUMBER_OF_TEXTURE_SLOTS);
-	int slot[DEFAULT_NUMBER_OF_TEXTURE_SLOTS] = { 0 };
-	for (int i = 0; i < m_textureSlotsInCurrentBatch; i++)
+	if (!arrays || !m_bindlessTextures)
 	{
-		// Since i represents the index of active textures one is added to it for the slot index
-		// This is because slot 0 is reserved for non-texture solid color quads
-		size_t texture = static_cast<size_t>(i) + m_textureSlotOffset;
-		m_activeTextures[texture].lock()->bind(i + 1);
-		slot[i + 1] = i + 1;
+		int slot[DEFAULT_NUMBER_OF_TEXTURE_SLOTS] = { 0 };
+		for (int i = 1; i <= m_textureSlotsInCurrentBatch; i++)
+		{
+			// Slot 0 is reserved for non-texture solid color quads
+			if (arrays)
+			{
+				const TextureArray& array = m_librarian.getTextureArray(m_batchTextures[i]);
+				array.bind(i);
+			}
+			else
+			{
+				const Texture& texture = *m_drawingPass->textures[m_batchTextures[i]];
+				texture.bind(i);
+			}
+			slot[i] = i;
+		}
+
+		if (arrays)
+			shader->setUniformSampler2DArray(spriteShader.textures, slot, DEFAULT_NUMBER_OF_TEXTURE_SLOTS);
+		else
+			shader->setUniformSampler2D(spriteShader.textures, slot, DEFAULT_NUMBER_OF_TEXTURE_SLOTS);
 	}
-	shader->setUniformSampler2D("u_texSlots[0]", slot, DEFAULT_NUMBER_OF_TEXTURE_SLOTS);
 
-	if (shader->validate())
-		glDrawElements(GL_TRIANGLES, m_ibo.count(), GL_UNSIGNED_INT, nullptr);
+	if (!validateBatch(spriteShader, m_textureSlotsInCurrentBatch + 1))
+		m_logger->critical("Shader '{0}' failed validation", spriteShader.name);
+	else if (instanced)
+	{
+		// The base instance moves the instance attributes to the batch's place in the instance ring
+		GLuint baseInstance = m_instanceRing.offset() / static_cast<GLuint>(sizeof(QuadInstance));
+		glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, NUMBER_OF_VERTICES_PER_QUAD, m_quadsInCurrentBatch, baseInstance);
+		m_frameStatistics.quads += m_quadsInCurrentBatch;
+		m_frameStatistics.drawCalls++;
+	}
 	else
-		m_logger->critical("Shader '{0}' failed validation", m_defaultShaderName);
+	{
+		// Indices are relative to the start of the batch, the base vertex moves them to the batch's place in the vertex ring
+		GLint baseVertex = static_cast<GLint>(m_vertexRing.offset() / m_vertexStride);
+		glDrawElementsBaseVertex(GL_TRIANGLES, m_quadsInCurrentBatch * NUMBER_OF_INDICES_PER_QUAD, GL_UNSIGNED_INT, nullptr, baseVertex);
+		m_frameStatistics.quads += m_quadsInCurrentBatch;
+		m_frameStatistics.drawCalls++;
+	}
 
-	for (int i = 0; i < m_textureSlotsInCurrentBatch; i++)
-		m_activeTextures[i].lock()->unbind();
+	// The next batch is written straight after the quads of this one, the rings are fenced once the frame ends
+	if (instanced)
+		m_instanceRing.commit(m_quadsInCurrentBatch * static_cast<unsigned int>(sizeof(QuadInstance)));
+	else
+		m_vertexRing.commit(m_quadsInCurrentBatch * NUMBER_OF_VERTICES_PER_QUAD * m_vertexStride);
+
+	for (int i = 1; i <= m_textureSlotsInCurrentBatch; i++)
+	{
+		if (!arrays)
+			m_drawingPass->textures[m_batchTextures[i]]->unbind();
+		else if (!m_bindlessTextures)
+			m_librarian.getTextureArray(m_batchTextures[i]).unbind(i);
+		m_batchTextureSlots[m_batchTextures[i]] = 0;
+	}
 
 	shader->unbind();
 
-	m_nextVertexOffset = 0;
-	m_nextIndexOffset = 0;
 	m_quadsInCurrentBatch = 0;
+	m_textureSlotsInCurrentBatch = 0;
 }
 
 
 
-AssetLibrarian& Renderer::assetLibrarian()
+void Renderer::loadSpriteShader(SpriteShader& shaderIn, const std::filesystem::path& vertexFilepath, const std::filesystem::path& pixelFilepath, const std::string& texturesUniformIn)
 {
-	return m_librarian;
+	m_librarian.addShader(shaderIn.name, vertexFilepath, pixelFilepath);
+	shaderIn.shader = m_librarian.getShader(shaderIn.name);
+
+	auto shader = shaderIn.shader.lock();
+	if (!texturesUniformIn.empty())
+		shaderIn.textures = shader->getUniformHandle(texturesUniformIn);
 }
 
 
 
-Renderer::QuadDrawCommand::QuadDrawCommand(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn)
-	: pos(posIn), size(sizeIn), color(colorIn), textureID(-1), subTextureIndex(0), hasTexture(false)
+void Renderer::updateTextureArrayHandles()
 {
+	const size_t numberOfArrays = static_cast<size_t>(m_librarian.numberOfTextureArrays());
+	bool changed = numberOfArrays != m_uploadedTextureArrayHandles.size();
+	m_uploadedTextureArrayHandles.resize(numberOfArrays);
+	for (size_t i = 0; i < numberOfArrays; i++)
+	{
+		// An array gets a new handle whenever its storage grows
+		const uint64_t handle = m_librarian.getTextureArray(static_cast<int>(i)).getHandle();
+		changed |= m_uploadedTextureArrayHandles[i] != handle;
+		m_uploadedTextureArrayHandles[i] = handle;
+	}
+
+	if (changed && numberOfArrays > 0)
+		m_textureArrayHandles.submitData(m_uploadedTextureArrayHandles.data(), static_cast<unsigned int>(numberOfArrays * sizeof(uint64_t)));
 }
 
 
 
-Renderer::QuadDrawCommand::QuadDrawCommand(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, int TextureIdIn)
-	: pos(posIn), size(sizeIn), color(colorIn), textureID(TextureIdIn), subTextureIndex(0), hasTexture(true)
+bool Renderer::validateBatch(const SpriteShader& shaderIn, int numberOfSlotsIn)
 {
+	auto shader = shaderIn.shader.lock();
+	if (m_validation == Validation::Full)
+	{
+		GLDebugOutput::setScope(fmt::format("{0} batch {1}", shaderIn.name, m_frameStatistics.drawCalls));
+		return shader->validate();
+	}
+
+	// The sampler uniforms always point slot i at unit i, so the number of slots covers which units the program samples
+	const ValidationState state = { shader->getID(), m_currentTextureBackend, m_currentBatchMode, numberOfSlotsIn };
+	auto result = m_validatedStates.find(state);
+	if (result == m_validatedStates.end())
+		result = m_validatedStates.emplace(state, shader->validate()).first;
+
+	return result->second;
+}
+
+
+
+const Renderer::SpriteShader& Renderer::getBatchShader() const
+{
+	if (m_currentTextureBackend == TextureBackend::Arrays)
+		return m_currentBatchMode == BatchMode::Instanced ? m_instancedArrayShader : m_arrayShader;
+
+	return m_currentBatchMode == BatchMode::Instanced ? m_instancedShader : m_defaultShader;
+}
+
+
+
+void Renderer::drawTileMap(const TileMap& mapIn, const std::string& tileSheetNameIn)
+{
+	drawTileMap(mapIn, m_librarian.getTextureHandle(tileSheetNameIn));
+}
+
+
+
+void Renderer::drawTileMap(const TileMap& mapIn, TextureHandle tileSheetIn)
+{
+	GAME_ASSERT(m_pass != nullptr);
+	if (mapIn.tileWidth() <= 0 || mapIn.tileHeight() <= 0)
+		return;
+
+	int textureID = activateTexture(tileSheetIn);
+	if (textureID < 0)
+		return;
+
+	// The tile sheet always takes texture slot 1 when a chunk is drawn, unless it is in a bindless texture array which is found by its index
+	unsigned int textureSlot = 1;
+	if (m_textureBackend == TextureBackend::Arrays)
+	{
+		const TextureArrayLayer& layer = m_pass->textureLayers[textureID];
+		const unsigned int slot = m_bindlessTextures ? static_cast<unsigned int>(layer.array) + 1 : 1;
+		textureSlot = layer.array >= 0 ? (slot << 16) | layer.layer : 0;
+	}
+
+	// Only the chunks under the visible rectangle are drawn, the bounds are stored as { max x, max y, -min x, -min y }
+	const float chunkWidth = static_cast<float>(mapIn.tileWidth() * TileMap::CHUNK_SIZE);
+	const float chunkHeight = static_cast<float>(mapIn.tileHeight() * TileMap::CHUNK_SIZE);
+	// The range is clamped before it is converted so the infinite bounds used without culling select every chunk
+	const int firstX = static_cast<int>(std::max(std::floor(-m_cullBounds[2] / chunkWidth), 0.0f));
+	const int firstY = static_cast<int>(std::max(std::floor(-m_cullBounds[3] / chunkHeight), 0.0f));
+	const int lastX = static_cast<int>(std::min(std::floor(m_cullBounds[0] / chunkWidth), static_cast<float>(mapIn.chunksWide() - 1)));
+	const int lastY = static_cast<int>(std::min(std::floor(m_cullBounds[1] / chunkHeight), static_cast<float>(mapIn.chunksHigh() - 1)));
+
+	const Texture& tileSheet = *m_pass->textures[textureID];
+	for (int chunkY = firstY; chunkY <= lastY; chunkY++)
+	{
+		for (int chunkX = firstX; chunkX <= lastX; chunkX++)
+		{
+			// Streamed chunks that have not arrived yet are skipped, the arrival changes their revision so they are built once they are resident
+			if (!mapIn.isChunkLoaded(chunkX, chunkY))
+				continue;
+
+			// A chunk drawn with a different tile sheet is a different mesh, the sheet's sprites are baked into its vertices
+			const TileChunkKey key = { (static_cast<uint64_t>(mapIn.getID()) << 32) | static_cast<uint32_t>(chunkY * mapIn.chunksWide() + chunkX), tileSheetIn };
+			const uint32_t revision = mapIn.chunkRevision(chunkX, chunkY);
+
+			TileChunkDraw draw = { key, textureID, false, 0, 0 };
+			TileChunkRecord& record = m_tileChunkRecords[key];
+			if (record.revision != revision || record.textureSlot != textureSlot)
+			{
+				draw.rebuild = true;
+				draw.firstVertex = m_pass->tileVertices.size();
+				draw.quads = buildTileChunk(mapIn, chunkX, chunkY, tileSheet, textureSlot);
+				record.revision = revision;
+				record.textureSlot = textureSlot;
+			}
+			record.lastUsedPass = m_passNumber;
+
+			m_pass->tileChunks.push_back(draw);
+		}
+	}
+}
+
+
+
+unsigned int Renderer::buildTileChunk(const TileMap& mapIn, int chunkX, int chunkY, const Texture& tileSheetIn, unsigned int textureSlotIn)
+{
+	const glm::vec2 tileSize(static_cast<float>(mapIn.tileWidth()), static_cast<float>(mapIn.tileHeight()));
+	const int endX = std::min((chunkX + 1) * TileMap::CHUNK_SIZE, mapIn.width());
+	const int endY = std::min((chunkY + 1) * TileMap::CHUNK_SIZE, mapIn.height());
+
+	// Layers are built bottom to top so upper layers are drawn over the ones below them
+	unsigned int quads = 0;
+	for (int layer = 0; layer < mapIn.numberOfLayers(); layer++)
+	{
+		for (int y = chunkY * TileMap::CHUNK_SIZE; y < endY; y++)
+		{
+			for (int x = chunkX * TileMap::CHUNK_SIZE; x < endX; x++)
+			{
+				const ITile* tile = mapIn.getTile(x, y, layer);
+				if (tile == nullptr || !tile->isOpaque())
+					continue;
+
+				const glm::vec3 pos(x * tileSize.x, y * tileSize.y, 0.0f);
+				const SubTexture subTexture = tileSheetIn.getSubTexture(tile->getSprite());
+
+				const size_t first = m_pass->tileVertices.size();
+				m_pass->tileVertices.resize(first + NUMBER_OF_VERTICES_PER_QUAD);
+				makeQuadVertices(&m_pass->tileVertices[first], pos, tileSize, { 1.0f, 1.0f, 1.0f, 1.0f }, subTexture, textureSlotIn);
+				quads++;
+			}
+		}
+	}
+
+	return quads;
+}
+
+
+
+void Renderer::drawTileChunk(const Pass& passIn, const TileChunkDraw& drawIn)
+{
+	TileChunkMesh& mesh = m_tileChunkMeshes[drawIn.key];
+	if (drawIn.rebuild)
+	{
+		mesh.quads = drawIn.quads;
+		mesh.vbo.reset();
+		if (mesh.quads > 0)
+		{
+			const unsigned int size = mesh.quads * NUMBER_OF_VERTICES_PER_QUAD * static_cast<unsigned int>(sizeof(QuadVertex));
+			mesh.vbo = std::make_unique<VertexBuffer>();
+			mesh.vbo->create(reinterpret_cast<float*>(const_cast<QuadVertex*>(&passIn.tileVertices[drawIn.firstVertex])), size, VertexBuffer::Usage::Static);
+			mesh.vbo->setLayout(m_quadLayout);
+			m_frameStatistics.vertexBytesUploaded += size;
+		}
+		m_frameStatistics.tileChunksRebuilt++;
+	}
+
+	if (mesh.quads == 0)
+		return;
+
+	// Chunks are always drawn with the vertex batch mode's shaders
+	m_currentBatchMode = BatchMode::Vertices;
+	const bool arrays = m_currentTextureBackend == TextureBackend::Arrays;
+	const SpriteShader& spriteShader = getBatchShader();
+	auto shader = spriteShader.shader.lock();
+	shader->bind();
+
+	const Texture& tileSheet = *passIn.textures[drawIn.textureID];
+	const int array = arrays ? passIn.textureLayers[drawIn.textureID].array : -1;
+	if (arrays && m_bindlessTextures)
+		updateTextureArrayHandles();
+	else
+	{
+		int slot[DEFAULT_NUMBER_OF_TEXTURE_SLOTS] = { 0 };
+		slot[1] = 1;
+		if (!arrays)
+		{
+			tileSheet.bind(1);
+			shader->setUniformSampler2D(spriteShader.textures, slot, DEFAULT_NUMBER_OF_TEXTURE_SLOTS);
+		}
+		else if (array >= 0)
+		{
+			m_librarian.getTextureArray(array).bind(1);
+			shader->setUniformSampler2DArray(spriteShader.textures, slot, DEFAULT_NUMBER_OF_TEXTURE_SLOTS);
+		}
+	}
+
+	mesh.vbo->bind();
+	m_quadIndices.bind();
+	if (!validateBatch(spriteShader, 2))
+		m_logger->critical("Shader '{0}' failed validation", spriteShader.name);
+	else
+	{
+		// A chunk with several layers can hold more quads than there are shared indices, so it is drawn in pieces
+		const unsigned int quadsPerDraw = m_quadIndices.count() / NUMBER_OF_INDICES_PER_QUAD;
+		for (unsigned int first = 0; first < mesh.quads; first += quadsPerDraw)
+		{
+			const unsigned int quads = std::min(quadsPerDraw, mesh.quads - first);
+			glDrawElementsBaseVertex(GL_TRIANGLES, quads * NUMBER_OF_INDICES_PER_QUAD, GL_UNSIGNED_INT, nullptr, first * NUMBER_OF_VERTICES_PER_QUAD);
+			m_frameStatistics.drawCalls++;
+		}
+		m_frameStatistics.quads += mesh.quads;
+		m_frameStatistics.tileChunks++;
+	}
+	mesh.vbo->unbind();
+	m_quadIndices.unbind();
+
+	if (!arrays)
+		tileSheet.unbind();
+	else if (array >= 0 && !m_bindlessTextures)
+		m_librarian.getTextureArray(array).unbind(1);
+
+	shader->unbind();
+}
+
+
+
+void Renderer::evictTileChunks()
+{
+	for (auto record = m_tileChunkRecords.begin(); record != m_tileChunkRecords.end();)
+	{
+		if (m_passNumber - record->second.lastUsedPass > TILE_CHUNK_LIFETIME)
+		{
+			m_pass->evictedTileChunks.push_back(record->first);
+			record = m_tileChunkRecords.erase(record);
+		}
+		else
+			record++;
+	}
+}
+
+
+
+AssetLibrarian& Renderer::assetLibrarian()
+{
+	return m_librarian;
 }
 
 
 
-Renderer::QuadDrawCommand::QuadDrawCommand(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, int TextureIdIn, unsigned int subTextureIndexIn)
-	: pos(posIn), size(sizeIn), color(colorIn), textureID(TextureIdIn), subTextureIndex(subTextureIndexIn), hasTexture(true)
+const Renderer::Statistics& Renderer::getStatistics() const
 {
+	return m_statistics;
 }
 
 
@@ -4,17 +4,27 @@
 
 #include <string>
 #include <vector>
-#include <queue>
+#include <map>
 #include <unordered_map>
+#include <tuple>
 #include <memory>
 #include <functional>
+#include <chrono>
 
 #include <glm/glm.hpp>
 
 #include "renderer/AssetLibrarian.h"
+#include "renderer/ContextQueue.h"
+#include "renderer/FrameData.h"
+#include "renderer/shaders/Shader.h"
 #include "renderer/texture/Texture.h"
+#include "renderer/texture/TextureHandle.h"
 #include "renderer/buffers/VertexBuffer.h"
 #include "renderer/buffers/IndexBuffer.h"
+#include "renderer/buffers/StreamingBuffer.h"
+#include "renderer/buffers/UniformBuffer.h"
+#include "renderer/buffers/StorageBuffer.h"
+#include "renderer/commands/DrawCommandBuffer.h"
 #include "utilities/Loggers.hpp"
 
 
@@ -25,50 +35,119 @@ TODO: add TTF support and text rendering
 */
 class Renderer 
 {
-	struct QuadDrawCommand
-	{
-		QuadDrawCommand(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn);
-
-
-
-		QuadDrawCommand(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, int TextureIdIn);
-
-
-
-		QuadDrawCommand(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, int TextureIdIn, unsigned int subTextureIndexIn);
-
+public:
 
+	/// <summary>
+	/// Counters that are gathered while a frame is drawn
+	/// </summary>
+	struct Statistics
+	{
+		/// <summary>
+		/// The number of quads that were drawn
+		/// </summary>
+		unsigned int quads = 0;
+
+		/// <summary>
+		/// The number of bytes of vertex data that were written to the GPU
+		/// </summary>
+		size_t vertexBytesUploaded = 0;
+
+		/// <summary>
+		/// The number of draw calls that were made
+		/// </summary>
+		unsigned int drawCalls = 0;
+
+		/// <summary>
+		/// The number of times a batch had to be drawn before the end of the frame because it ran out of texture slots or space
+		/// </summary>
+		unsigned int batchBreaks = 0;
+
+		/// <summary>
+		/// The number of submitted quads that were inside of the camera's visible rectangle
+		/// </summary>
+		unsigned int quadsVisible = 0;
+
+		/// <summary>
+		/// The number of submitted quads that were outside of the camera's visible rectangle and never queued
+		/// </summary>
+		unsigned int quadsCulled = 0;
+
+		/// <summary>
+		/// The number of tile map chunks that were drawn
+		/// </summary>
+		unsigned int tileChunks = 0;
+
+		/// <summary>
+		/// The number of tile map chunk meshes that were rebuilt
+		/// </summary>
+		unsigned int tileChunksRebuilt = 0;
+	};
 
-		bool operator>(const QuadDrawCommand& other) const
-		{
-			return textureID > other.textureID;
-		}
 
 
+	/// <summary>
+	/// How quads are sent to the GPU
+	/// </summary>
+	enum class BatchMode : uint8_t
+	{
+		/// <summary>
+		/// Each quad is written as 4 complete vertices
+		/// </summary>
+		Vertices,
+
+		/// <summary>
+		/// Each quad is written as one compact instance record and its corners are built by the vertex shader
+		/// </summary>
+		Instanced
+	};
 
-		bool operator<(const QuadDrawCommand& other) const
-		{
-			return textureID < other.textureID;
-		}
 
 
+	/// <summary>
+	/// How textures are made available to the sprite shaders
+	/// </summary>
+	enum class TextureBackend : uint8_t
+	{
+		/// <summary>
+		/// Each texture is bound to its own texture slot, a batch can use at most 15 textures
+		/// </summary>
+		Slots,
+
+		/// <summary>
+		/// Same-sized textures are packed into texture arrays and each array takes one texture slot, when bindless textures are supported 
+		/// arrays take no slots and a batch can use any number of them
+		/// </summary>
+		Arrays
+	};
 
-		glm::vec3 pos;
 
-		glm::vec2 size;
 
-		glm::vec4 color;
+	/// <summary>
+	/// How often shader programs are validated before they are drawn with
+	/// </summary>
+	enum class Validation : uint8_t
+	{
+		/// <summary>
+		/// Each program is validated once for each state that it is drawn with and the result is reused
+		/// </summary>
+		Cached,
+
+		/// <summary>
+		/// The program is validated before every draw call and OpenGL debug messages are logged with the batch that caused them
+		/// </summary>
+		Full
+	};
 
-		int textureID;
 
-		unsigned int subTextureIndex;
 
-		bool hasTexture;
-	};
+#ifdef NDEBUG
+	static constexpr Validation DEFAULT_VALIDATION = Validation::Cached;
+#else
+	static constexpr Validation DEFAULT_VALIDATION = Validation::Full;
+#endif
 
 
 
-public:
 
 	Renderer();
 
@@ -98,7 +177,8 @@ public:
 
 
 	/// <summary>
-	/// 
+	/// Starts a new pass and records the camera's matrices, the time, and the viewport size for the frame data uniform buffer
+	/// <para>Quads submitted during the pass are culled against the camera's visible rectangle</para>
 	/// </summary>
 	/// <param name="cameraIn"></param>
 	void begin(const std::shared_ptr<class Camera>& cameraIn);
@@ -106,12 +186,125 @@ public:
 
 
 	/// <summary>
-	/// 
+	/// Ends the current pass
+	/// <para>
+	/// Every quad submitted since Renderer::begin is sorted and drawn in as few batches as possible. When the renderer is deferred 
+	/// the pass is only recorded and it is drawn by the render thread once the frame has been submitted
+	/// </para>
 	/// </summary>
 	void end();
 
 
 
+	/// <summary>
+	/// Finishes a frame that was drawn on this thread by running any queued tasks and publishing the frame's statistics
+	/// <para>This must not be called when the renderer is deferred, the render thread finishes each frame instead</para>
+	/// </summary>
+	void endFrame();
+
+
+
+	/// <summary>
+	/// Sets if passes are only recorded by Renderer::end so they can be drawn by a render thread
+	/// <para>This must not be called between Renderer::begin and Renderer::end</para>
+	/// </summary>
+	/// <param name="deferredIn"></param>
+	void setDeferred(bool deferredIn);
+
+
+
+	/// <summary>
+	/// Checks if passes are only recorded by Renderer::end so they can be drawn by a render thread
+	/// </summary>
+	/// <returns></returns>
+	bool isDeferred() const;
+
+
+
+	/// <summary>
+	/// Queues a task that needs the OpenGL context, it is run by the thread that owns the context before the next frame is drawn
+	/// <para>This can be called from any thread</para>
+	/// </summary>
+	/// <param name="taskIn"></param>
+	void enqueueTask(std::function<void()> taskIn);
+
+
+
+	/// <summary>
+	/// Runs a task that needs the OpenGL context on the thread that owns the context and waits for it to finish
+	/// <para>The task is run straight away if the calling thread owns the context</para>
+	/// </summary>
+	/// <param name="taskIn"></param>
+	void runOnContext(const std::function<void()>& taskIn);
+
+
+
+	/// <summary>
+	/// Sets how quads are sent to the GPU, which takes effect from the next call to Renderer::end
+	/// </summary>
+	/// <param name="modeIn"></param>
+	void setBatchMode(BatchMode modeIn);
+
+
+
+	/// <summary>
+	/// Gets how quads are sent to the GPU
+	/// </summary>
+	/// <returns></returns>
+	BatchMode getBatchMode() const;
+
+
+
+	/// <summary>
+	/// Sets how textures are made available to the sprite shaders, this must not be called between Renderer::begin and Renderer::end
+	/// </summary>
+	/// <param name="backendIn"></param>
+	void setTextureBackend(TextureBackend backendIn);
+
+
+
+	/// <summary>
+	/// Gets how textures are made available to the sprite shaders
+	/// </summary>
+	/// <returns></returns>
+	TextureBackend getTextureBackend() const;
+
+
+
+	/// <summary>
+	/// Sets how often shader programs are validated before they are drawn with
+	/// <para>While deferred this waits for the render thread to apply it</para>
+	/// </summary>
+	/// <param name="validationIn"></param>
+	void setValidation(Validation validationIn);
+
+
+
+	/// <summary>
+	/// Gets how often shader programs are validated before they are drawn with
+	/// </summary>
+	/// <returns></returns>
+	Validation getValidation() const;
+
+
+
+	/// <summary>
+	/// Sets if quads outside of the camera's visible rectangle are dropped when they are submitted, which takes effect from the next pass
+	/// <para>Culling is enabled by default</para>
+	/// </summary>
+	/// <param name="enabledIn"></param>
+	void setCulling(bool enabledIn);
+
+
+
+	/// <summary>
+	/// Checks if quads outside of the camera's visible rectangle are dropped when they are submitted
+	/// </summary>
+	/// <returns></returns>
+	bool isCulling() const;
+
+
+
 	/// <summary>
 	/// Forces the renderer to draw the current batch
 	/// </summary>
@@ -121,6 +314,7 @@ public:
 
 	/// <summary>
 	/// Clears the screen and fills it in with the given color
+	/// <para>Inside of a pass the clear is recorded and done before the pass's quads are drawn</para>
 	/// </summary>
 	/// <param name="red">Specifies the amount of red</param>
 	/// <param name="green">Specifies the amount of green</param>
@@ -170,6 +364,52 @@ public:
 
 
 
+	/// <summary>
+	/// Draws a textured quad without looking the texture up by name
+	/// </summary>
+	/// <param name="posIn"></param>
+	/// <param name="sizeIn"></param>
+	/// <param name="colorIn"></param>
+	/// <param name="textureIn">Specifies a handle from AssetLibrarian::getTextureHandle</param>
+	void drawQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, TextureHandle textureIn);
+
+
+
+	/// <summary>
+	/// Draws one sprite of a texture atlas without looking the texture up by name
+	/// <para>A handle to a texture that has been removed is drawn as a solid color quad</para>
+	/// </summary>
+	/// <param name="posIn"></param>
+	/// <param name="sizeIn"></param>
+	/// <param name="colorIn"></param>
+	/// <param name="textureIn">Specifies a handle from AssetLibrarian::getTextureHandle</param>
+	/// <param name="spriteIndexIn"></param>
+	void drawQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, TextureHandle textureIn, unsigned int spriteIndexIn);
+
+
+
+	/// <summary>
+	/// Draws every chunk of the given tile map that overlaps the camera's visible rectangle
+	/// <para>
+	/// Each chunk is drawn from a cached mesh with one draw call, a chunk's mesh is only rebuilt after one of its tiles has changed. 
+	/// Tile maps are drawn before the quads of the current pass
+	/// </para>
+	/// </summary>
+	/// <param name="mapIn"></param>
+	/// <param name="tileSheetIn">Specifies the texture atlas that the map's tile sprites index into</param>
+	void drawTileMap(const class TileMap& mapIn, TextureHandle tileSheetIn);
+
+
+
+	/// <summary>
+	/// Draws every chunk of the given tile map that overlaps the camera's visible rectangle
+	/// </summary>
+	/// <param name="mapIn"></param>
+	/// <param name="tileSheetNameIn">Specifies the texture atlas that the map's tile sprites index into</param>
+	void drawTileMap(const class TileMap& mapIn, const std::string& tileSheetNameIn);
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -178,17 +418,380 @@ public:
 
 
 
+	/// <summary>
+	/// Gets the statistics of the last frame that was drawn
+	/// </summary>
+	/// <returns></returns>
+	const Statistics& getStatistics() const;
+
+
+
 private:
 
+	friend class RenderThread;
+
+
+
+	/// <summary>
+	/// One corner of a quad in the vertex batch mode, 24 bytes
+	/// </summary>
+	struct QuadVertex
+	{
+		glm::vec3 pos;
+
+		/// <summary>
+		/// RGBA8 color, normalized by the vertex shader
+		/// </summary>
+		uint32_t color;
+
+		/// <summary>
+		/// Two half floats
+		/// </summary>
+		uint32_t texCord;
+
+		unsigned int texSlot;
+	};
+
+
+
+	/// <summary>
+	/// Identifies a tile map chunk's mesh, the same chunk drawn with another tile sheet has a mesh of its own
+	/// </summary>
+	struct TileChunkKey
+	{
+		/// <summary>
+		/// The tile map's ID in the upper 32 bits and the chunk's index in the lower 32 bits
+		/// </summary>
+		uint64_t chunk = 0;
+
+		TextureHandle tileSheet;
+
+		bool operator==(const TileChunkKey& other) const { return chunk == other.chunk && tileSheet == other.tileSheet; }
+	};
+
+
+
+	struct TileChunkKeyHash
+	{
+		size_t operator()(const TileChunkKey& keyIn) const
+		{
+			return std::hash<uint64_t>()(keyIn.chunk ^ (static_cast<uint64_t>(keyIn.tileSheet.value()) * 0x9E3779B97F4A7C15ull));
+		}
+	};
+
+
+
+	/// <summary>
+	/// The state that glValidateProgram checks a sprite shader against, the textures themselves are left out so that 
+	/// each combination of programs and slots is only validated once
+	/// </summary>
+	struct ValidationState
+	{
+		unsigned int program = 0;
+
+		TextureBackend textureBackend = TextureBackend::Slots;
+
+		BatchMode batchMode = BatchMode::Vertices;
+
+		int numberOfSlots = 0;
+
+		bool operator<(const ValidationState& other) const
+		{
+			return std::tie(program, textureBackend, batchMode, numberOfSlots) < std::tie(other.program, other.textureBackend, other.batchMode, other.numberOfSlots);
+		}
+	};
+
+
+
+	/// <summary>
+	/// A tile map chunk to draw, with the vertices to rebuild its mesh from if it has changed
+	/// </summary>
+	struct TileChunkDraw
+	{
+		TileChunkKey key;
+
+		/// <summary>
+		/// Index of the tile sheet in the pass's texture list
+		/// </summary>
+		int textureID;
+
+		bool rebuild;
+
+		/// <summary>
+		/// Where the chunk's vertices start in the pass's tile vertex list, only used when the chunk is rebuilt
+		/// </summary>
+		size_t firstVertex;
+
+		unsigned int quads;
+	};
+
+
+
 	/// <summary>
-	/// Adds a new quad to the current renderer batch
+	/// Everything needed to draw the quads submitted between one Renderer::begin and Renderer::end
+	/// </summary>
+	struct Pass
+	{
+		FrameData frame;
+
+		bool clear = false;
+
+		glm::vec4 clearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+		BatchMode batchMode = BatchMode::Vertices;
+
+		TextureBackend textureBackend = TextureBackend::Slots;
+
+		unsigned int quadsVisible = 0;
+
+		unsigned int quadsCulled = 0;
+
+		DrawCommandBuffer commands;
+
+		/// <summary>
+		/// Each texture is held for the whole pass so it can be used without locking it for every quad, the textures are 
+		/// released once the pass has been drawn so the last reference to a texture is dropped by the thread that owns the context
+		/// </summary>
+		std::vector<std::shared_ptr<Texture>> textures;
+
+		/// <summary>
+		/// The texture array layer of each texture, only used by the texture array backend
+		/// </summary>
+		std::vector<TextureArrayLayer> textureLayers;
+
+		/// <summary>
+		/// The first texture in this pass with the same OpenGL texture as each texture, textures packed into the same 
+		/// texture page share one texture slot through it
+		/// </summary>
+		std::vector<int> textureBindings;
+
+		std::vector<TileChunkDraw> tileChunks;
+
+		std::vector<QuadVertex> tileVertices;
+
+		/// <summary>
+		/// Chunk meshes that have not been drawn for a while and are destroyed before this pass is drawn
+		/// </summary>
+		std::vector<TileChunkKey> evictedTileChunks;
+	};
+
+
+
+	/// <summary>
+	/// The passes of one frame
+	/// <para>
+	/// There are two packets, one is recorded into by the main thread while the other is drawn by the render thread. 
+	/// Each packet is only ever used by one thread at a time so recording and drawing never need a lock
+	/// </para>
+	/// </summary>
+	struct FramePacket
+	{
+		/// <summary>
+		/// Passes are kept between frames so their memory is reused, only the first numberOfPasses are part of the frame
+		/// </summary>
+		std::vector<std::unique_ptr<Pass>> passes;
+
+		size_t numberOfPasses = 0;
+
+		Statistics statistics;
+	};
+
+
+
+	/// <summary>
+	/// Gets the next unused pass of the packet that is being recorded into
+	/// </summary>
+	/// <returns></returns>
+	Pass& acquirePass();
+
+
+
+	/// <summary>
+	/// Sorts the given pass's quads and draws them in as few batches as possible
+	/// </summary>
+	/// <param name="passIn"></param>
+	void drawPass(Pass& passIn);
+
+
+
+	/// <summary>
+	/// Draws every pass of the given packet and stores the frame's statistics in it, only called by the render thread
+	/// </summary>
+	/// <param name="packetIn"></param>
+	void drawPacket(FramePacket& packetIn);
+
+
+
+	/// <summary>
+	/// Hands the recorded packet over to be drawn and starts recording into the other packet
+	/// <para>This must only be called once the render thread has finished drawing the other packet</para>
+	/// </summary>
+	/// <returns>The packet to draw</returns>
+	FramePacket& swapPackets();
+
+
+
+	/// <summary>
+	/// Runs every queued task, must be called by the thread that owns the OpenGL context
+	/// </summary>
+	void runTasks();
+
+
+
+	/// <summary>
+	/// Adds the given texture to the current pass's texture list if it is not already in it
+	/// </summary>
+	/// <param name="textureIn"></param>
+	/// <returns>The texture's index in the pass's texture list, or -1 if the handle no longer refers to a texture</returns>
+	int activateTexture(TextureHandle textureIn);
+
+
+
+	/// <summary>
+	/// Checks if a quad overlaps the current pass's visible rectangle and counts it as either visible or culled
+	/// </summary>
+	/// <param name="posIn"></param>
+	/// <param name="sizeIn"></param>
+	/// <returns>True if the quad should be queued</returns>
+	bool cull(const glm::vec3& posIn, const glm::vec2& sizeIn);
+
+
+
+	/// <summary>
+	/// Writes the 4 vertices of a quad
+	/// </summary>
+	/// <param name="verticesOut"></param>
+	/// <param name="posIn"></param>
+	/// <param name="sizeIn"></param>
+	/// <param name="colorIn"></param>
+	/// <param name="subTextureIn"></param>
+	/// <param name="textureSlotIn"></param>
+	static void makeQuadVertices(QuadVertex* verticesOut, const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, unsigned int textureSlotIn);
+
+
+
+	/// <summary>
+	/// Appends the vertices of every visible tile in the given chunk to the current pass's tile vertex list
+	/// </summary>
+	/// <param name="mapIn"></param>
+	/// <param name="chunkX"></param>
+	/// <param name="chunkY"></param>
+	/// <param name="tileSheetIn"></param>
+	/// <param name="textureSlotIn"></param>
+	/// <returns>The number of quads that were added</returns>
+	unsigned int buildTileChunk(const class TileMap& mapIn, int chunkX, int chunkY, const Texture& tileSheetIn, unsigned int textureSlotIn);
+
+
+
+	/// <summary>
+	/// Draws a tile map chunk's mesh, rebuilding it first if it has changed
+	/// </summary>
+	/// <param name="passIn"></param>
+	/// <param name="drawIn"></param>
+	void drawTileChunk(const Pass& passIn, const TileChunkDraw& drawIn);
+
+
+
+	/// <summary>
+	/// Forgets every tile map chunk that has not been drawn in the last TILE_CHUNK_LIFETIME passes and tells the current pass to destroy their meshes
+	/// </summary>
+	void evictTileChunks();
+
+	/// <summary>
+	/// Adds a new quad to the current renderer batch by writing its 4 vertices straight into the mapped vertex ring
 	/// <para>increments the number of quads in the current batch</para>
 	/// </summary>
 	/// <param name="posIn"></param>
 	/// <param name="sizeIn"></param>
 	/// <param name="colorIn"></param>
 	/// <param name="subTextureIn"></param>
-	void bakeQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, float textureSlotIn);
+	void bakeQuad(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, unsigned int textureSlotIn);
+
+
+
+	/// <summary>
+	/// Adds a new quad to the current renderer batch by writing one instance record into the mapped instance ring
+	/// <para>increments the number of quads in the current batch</para>
+	/// </summary>
+	/// <param name="posIn"></param>
+	/// <param name="sizeIn"></param>
+	/// <param name="colorIn"></param>
+	/// <param name="subTextureIn"></param>
+	void bakeInstance(const glm::vec3& posIn, const glm::vec2& sizeIn, const glm::vec4& colorIn, const SubTexture& subTextureIn, unsigned int textureSlotIn);
+
+
+
+	/// <summary>
+	/// The per-instance record of the instanced batch mode
+	/// </summary>
+	struct QuadInstance
+	{
+		glm::vec3 pos;
+
+		glm::vec2 size;
+
+		/// <summary>
+		/// RGBA8 color, normalized by the vertex shader
+		/// </summary>
+		uint32_t color;
+
+		/// <summary>
+		/// The sub-texture's minimum and maximum UV coordinates
+		/// </summary>
+		glm::vec4 texRect;
+
+		unsigned int texSlot;
+	};
+
+
+
+	/// <summary>
+	/// A sprite shader with the uniforms that are sent on every flush resolved ahead of time
+	/// </summary>
+	struct SpriteShader
+	{
+		std::string name;
+
+		std::weak_ptr<Shader> shader;
+
+		Shader::UniformHandle textures;
+	};
+
+
+
+	/// <summary>
+	/// Loads a sprite shader into the asset librarian and resolves its uniforms
+	/// </summary>
+	/// <param name="shaderIn">Specifies the sprite shader, its name must already be set</param>
+	/// <param name="vertexFilepath"></param>
+	/// <param name="pixelFilepath"></param>
+	/// <param name="texturesUniformIn">Specifies the name of the shader's texture sampler array, or nothing if it has none</param>
+	void loadSpriteShader(SpriteShader& shaderIn, const std::filesystem::path& vertexFilepath, const std::filesystem::path& pixelFilepath, const std::string& texturesUniformIn);
+
+
+
+	/// <summary>
+	/// Gets the shader that matches the current batch mode and texture backend
+	/// </summary>
+	/// <returns></returns>
+	const SpriteShader& getBatchShader() const;
+
+
+
+	/// <summary>
+	/// Uploads the bindless handle of every texture array to the handle storage buffer if any of them have changed, only used with bindless textures
+	/// </summary>
+	void updateTextureArrayHandles();
+
+
+
+	/// <summary>
+	/// Validates the given sprite shader against the current batch's state, depending on the validation mode the result may be cached
+	/// </summary>
+	/// <param name="shaderIn"></param>
+	/// <param name="numberOfSlotsIn">Specifies the number of texture slots that the shader samples, including the solid color slot</param>
+	/// <returns>True if the batch can be drawn</returns>
+	bool validateBatch(const SpriteShader& shaderIn, int numberOfSlotsIn);
 
 
 
@@ -200,39 +803,180 @@ private:
 
 	VertexBuffer m_vbo;
 
-	IndexBuffer m_ibo;
+	StreamingBuffer m_vertexRing;
+
+	IndexBuffer m_quadIndices;
+
+	unsigned int m_vertexStride = 0;
+
+	VertexBuffer m_instanceVbo;
+
+	StreamingBuffer m_instanceRing;
+
+	BatchMode m_batchMode = BatchMode::Vertices;
+
+	BatchMode m_currentBatchMode = BatchMode::Vertices;
 
 	static constexpr int NUMBER_OF_VERTICES_PER_QUAD = 4;
 
 	static constexpr int NUMBER_OF_INDICES_PER_QUAD = 6;
 
+	/// <summary>
+	/// The number of full batches that fit in one frame's segment of the vertex and instance rings
+	/// </summary>
+	static constexpr int BATCHES_PER_RING_SEGMENT = 8;
+
 	int m_maxQuadsPerBatch = 1000;
 
 	int m_quadsInCurrentBatch = 0;
 
-	unsigned int m_nextVertexOffset = 0;
 
-	int m_nextIndexOffset = 0;
 
+	/// <summary>
+	/// Where a texture slot's texture is in the current pass's texture list
+	/// </summary>
+	struct ActiveTexture
+	{
+		TextureHandle handle;
+
+		/// <summary>
+		/// The pass that the index belongs to, entries from earlier passes are stale
+		/// </summary>
+		uint32_t pass = 0;
 
+		int index = -1;
+	};
 
-	std::unordered_map<std::string, int> m_activeTexturesLookup;
 
-	std::vector<std::weak_ptr<Texture>> m_activeTextures;
 
-	static constexpr int DEFAULT_NUMBER_OF_TEXTURE_SLOTS = 16;
+	/// <summary>
+	/// Indexed by the asset librarian's texture slot
+	/// </summary>
+	std::vector<ActiveTexture> m_activeTextures;
+
+	/// <summary>
+	/// Counts every pass that has been started, it starts at 1 so that unused entries are never part of a pass
+	/// </summary>
+	uint32_t m_passNumber = 1;
+
+	TextureBackend m_textureBackend = TextureBackend::Slots;
+
+	/// <summary>
+	/// The texture backend of the pass that is being drawn
+	/// </summary>
+	TextureBackend m_currentTextureBackend = TextureBackend::Slots;
+
+	bool m_bindlessTextures = false;
 
-	int m_nextTextureSlot = 0;
+	static constexpr int DEFAULT_NUMBER_OF_TEXTURE_SLOTS = 16;
 
 	int m_maxTexturesSlotsPerBatch = 16;
 
 	int m_textureSlotsInCurrentBatch = 0;
 
-	int m_textureSlotOffset = 0;
+	/// <summary>
+	/// The active texture, or texture array, bound to each texture slot of the current batch
+	/// </summary>
+	int m_batchTextures[DEFAULT_NUMBER_OF_TEXTURE_SLOTS] = { 0 };
+
+	/// <summary>
+	/// The texture slot each active texture, or texture array, is bound to in the current batch, or 0 if it is not part of the batch
+	/// </summary>
+	std::vector<int> m_batchTextureSlots;
+
+	static constexpr unsigned int TEXTURE_ARRAY_HANDLES_BINDING = 1;
+
+	/// <summary>
+	/// Every texture array's bindless handle by the array's index, which the texture array shaders index with the quad's texture slot
+	/// </summary>
+	StorageBuffer m_textureArrayHandles;
+
+	/// <summary>
+	/// The handles that are in the handle storage buffer
+	/// </summary>
+	std::vector<uint64_t> m_uploadedTextureArrayHandles;
+
+
+
+	FramePacket m_packets[2];
+
+	int m_recordingPacket = 0;
+
+	/// <summary>
+	/// The pass between Renderer::begin and Renderer::end, or null outside of a pass
+	/// </summary>
+	Pass* m_pass = nullptr;
+
+	/// <summary>
+	/// The pass that is being drawn, or null when no pass is being drawn
+	/// </summary>
+	const Pass* m_drawingPass = nullptr;
+
+	bool m_deferred = false;
+
+	bool m_culling = true;
+
+	/// <summary>
+	/// The current pass's visible rectangle stored as { max x, max y, -min x, -min y } so a quad can be tested with a single compare
+	/// </summary>
+	alignas(16) float m_cullBounds[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+
+
+	/// <summary>
+	/// What the main thread knows about a tile map chunk's mesh
+	/// </summary>
+	struct TileChunkRecord
+	{
+		/// <summary>
+		/// The chunk's revision when its mesh was last built
+		/// </summary>
+		uint32_t revision = 0;
+
+		/// <summary>
+		/// The texture slot that was baked into the mesh's vertices
+		/// </summary>
+		unsigned int textureSlot = 0;
+
+		uint32_t lastUsedPass = 0;
+	};
+
+
+
+	/// <summary>
+	/// A tile map chunk's mesh, only used by the thread that draws
+	/// </summary>
+	struct TileChunkMesh
+	{
+		std::unique_ptr<VertexBuffer> vbo;
+
+		unsigned int quads = 0;
+	};
 
 
 
-	std::priority_queue<QuadDrawCommand, std::vector<QuadDrawCommand>, std::greater<QuadDrawCommand>> m_quadDrawQueue;
+	/// <summary>
+	/// The number of passes a chunk mesh is kept for after it was last drawn
+	/// </summary>
+	static constexpr uint32_t TILE_CHUNK_LIFETIME = 600;
+
+	std::unordered_map<TileChunkKey, TileChunkRecord, TileChunkKeyHash> m_tileChunkRecords;
+
+	std::unordered_map<TileChunkKey, TileChunkMesh, TileChunkKeyHash> m_tileChunkMeshes;
+
+	VertexBuffer::Layout m_quadLayout;
+
+	/// <summary>
+	/// A clear requested outside of a pass while deferred, it is done at the start of the next pass
+	/// </summary>
+	bool m_pendingClear = false;
+
+	glm::vec4 m_pendingClearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+	/// <summary>
+	/// Every call that needs the OpenGL context, including the asset librarian's, goes through this queue
+	/// </summary>
+	ContextQueue m_contextQueue;
 
 
 
@@ -240,9 +984,35 @@ private:
 
 
 
-	std::string m_defaultShaderName;
+	SpriteShader m_defaultShader;
+
+	SpriteShader m_instancedShader;
+
+	SpriteShader m_arrayShader;
+
+	SpriteShader m_instancedArrayShader;
+
+	Validation m_validation = DEFAULT_VALIDATION;
+
+	/// <summary>
+	/// The cached validation result of each program and batch state, only used by Validation::Cached
+	/// </summary>
+	std::map<ValidationState, bool> m_validatedStates;
 
 	std::shared_ptr<class Camera> m_camera;
+
+	/// <summary>
+	/// Holds the FrameData that is shared by every shader
+	/// </summary>
+	UniformBuffer m_frameUniforms;
+
+	std::chrono::steady_clock::time_point m_startTime;
+
+
+
+	Statistics m_frameStatistics;
+
+	Statistics m_statistics;
 };
 
 
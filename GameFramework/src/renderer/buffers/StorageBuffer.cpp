@@ -0,0 +1,85 @@
+#include <algorithm>
+
+#include "renderer/buffers/StorageBuffer.h"
+#include "renderer/RendererFondation.h"
+
+
+
+
+StorageBuffer::StorageBuffer()
+{
+	m_logger = Loggers::getLog();
+}
+
+
+
+StorageBuffer::StorageBuffer(StorageBuffer&& other) noexcept
+	: m_logger(other.m_logger), m_id(other.m_id), m_size(other.m_size), m_binding(other.m_binding), m_movedOrDestroyed(other.m_movedOrDestroyed)
+{
+	other.m_id = 0;
+	other.m_movedOrDestroyed = true;
+}
+
+
+
+StorageBuffer::~StorageBuffer()
+{
+	destroy();
+}
+
+
+
+void StorageBuffer::create(unsigned int sizeIn, unsigned int bindingIn)
+{
+	if (m_id)
+	{
+		m_logger->warn("This storage buffer has already been created.");
+		return;
+	}
+
+	m_size = std::max(sizeIn, 1u);
+	m_binding = bindingIn;
+	glCreateBuffers(1, &m_id);
+	glNamedBufferStorage(m_id, m_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	bind();
+	m_movedOrDestroyed = false;
+}
+
+
+
+void StorageBuffer::destroy()
+{
+	if (!m_movedOrDestroyed && m_id)
+	{
+		m_logger->trace("Storage buffer '{0}' has been deleted", m_id);
+		glDeleteBuffers(1, &m_id);
+		m_id = 0;
+		m_movedOrDestroyed = true;
+	}
+}
+
+
+
+void StorageBuffer::submitData(const void* dataIn, unsigned int sizeIn)
+{
+	GAME_ASSERT(m_id != 0);
+	if (sizeIn > m_size)
+	{
+		// The storage is immutable, so growing means making a new buffer
+		const unsigned int binding = m_binding;
+		const unsigned int size = std::max(sizeIn, m_size * 2);
+		destroy();
+		create(size, binding);
+	}
+	glNamedBufferSubData(m_id, 0, sizeIn, dataIn);
+}
+
+
+
+void StorageBuffer::bind() const
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_binding, m_id);
+}
+
+
+
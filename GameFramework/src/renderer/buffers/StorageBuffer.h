@@ -0,0 +1,91 @@
+#ifndef StorageBuffer_H_
+#define StorageBuffer_H_
+
+#include <memory>
+
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// A shader storage buffer that is bound to a fixed binding point and grows to fit whatever is written to it
+/// </summary>
+class StorageBuffer
+{
+public:
+
+	StorageBuffer();
+
+
+
+	StorageBuffer(const StorageBuffer& other) = delete;
+
+
+
+	StorageBuffer(StorageBuffer&& other) noexcept;
+
+
+
+	~StorageBuffer();
+
+
+
+	/// <summary>
+	/// Creates a new storage buffer and binds it to the given binding point
+	/// </summary>
+	/// <param name="sizeIn">Specifies the initial size of the storage buffer, measured in bytes</param>
+	/// <param name="bindingIn">Specifies the shader storage block binding point</param>
+	void create(unsigned int sizeIn, unsigned int bindingIn);
+
+
+
+	/// <summary>
+	/// Destroys this storage buffer and frees all of its data
+	/// </summary>
+	void destroy();
+
+
+
+	/// <summary>
+	/// Replaces this storage buffer's data, the buffer is recreated with more room first if the data does not fit
+	/// </summary>
+	/// <param name="dataIn">Specifies the new data, which must follow the std430 layout of the block</param>
+	/// <param name="sizeIn">Specifies the size of the new data, measured in bytes</param>
+	void submitData(const void* dataIn, unsigned int sizeIn);
+
+
+
+	/// <summary>
+	/// Binds this storage buffer to its binding point
+	/// </summary>
+	void bind() const;
+
+
+
+	/// <summary>
+	/// Gets the shader storage block binding point this buffer is bound to
+	/// </summary>
+	/// <returns></returns>
+	unsigned int getBinding() const { return m_binding; }
+
+
+
+private:
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	unsigned int m_id = 0;
+
+	unsigned int m_size = 0;
+
+	unsigned int m_binding = 0;
+
+	bool m_movedOrDestroyed = false;
+};
+
+
+#endif /* StorageBuffer_H_ */
+
+
+
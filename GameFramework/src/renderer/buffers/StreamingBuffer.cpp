@@ -0,0 +1,196 @@
+#include "renderer/buffers/StreamingBuffer.h"
+#include "renderer/RendererFondation.h"
+
+
+
+
+unsigned int getGL_BufferTarget(StreamingBuffer::Target targetIn)
+{
+	switch (targetIn)
+	{
+	case StreamingBuffer::Target::Vertex:
+		return GL_ARRAY_BUFFER;
+
+	case StreamingBuffer::Target::Index:
+		return GL_ELEMENT_ARRAY_BUFFER;
+
+	default:
+		Loggers::getLog()->error("Invalid streaming buffer target!");
+		__debugbreak();
+		return 0;
+	}
+}
+
+
+
+StreamingBuffer::StreamingBuffer()
+{
+	m_logger = Loggers::getLog();
+}
+
+
+
+StreamingBuffer::StreamingBuffer(StreamingBuffer&& other) noexcept
+	: m_logger(other.m_logger), m_id(other.m_id), m_target(other.m_target), m_mapped(other.m_mapped), m_segmentSize(other.m_segmentSize),
+	m_currentSegment(other.m_currentSegment), m_allocationStart(other.m_allocationStart), m_used(other.m_used), m_released(other.m_released), 
+	m_fences(std::move(other.m_fences)), m_movedOrDestroyed(other.m_movedOrDestroyed)
+{
+	other.m_id = 0;
+	other.m_mapped = nullptr;
+	other.m_movedOrDestroyed = true;
+}
+
+
+
+StreamingBuffer::~StreamingBuffer()
+{
+	destroy();
+}
+
+
+
+void StreamingBuffer::create(Target targetIn, unsigned int segmentSizeIn, unsigned int numberOfSegmentsIn)
+{
+	if (m_id)
+	{
+		m_logger->warn("This streaming buffer has already been created.");
+		return;
+	}
+
+	GAME_ASSERT(segmentSizeIn > 0 && numberOfSegmentsIn > 0);
+	m_target = targetIn;
+	m_segmentSize = segmentSizeIn;
+	m_fences.assign(numberOfSegmentsIn, nullptr);
+
+	// The first reservation will move to segment 0
+	m_currentSegment = numberOfSegmentsIn - 1;
+	m_allocationStart = 0;
+	m_used = 0;
+	m_released = true;
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	const GLsizeiptr size = static_cast<GLsizeiptr>(m_segmentSize) * numberOfSegmentsIn;
+	glCreateBuffers(1, &m_id);
+	glNamedBufferStorage(m_id, size, nullptr, flags);
+	m_mapped = static_cast<unsigned char*>(glMapNamedBufferRange(m_id, 0, size, flags));
+	if (m_mapped == nullptr)
+	{
+		m_logger->critical("Unable to map streaming buffer '{0}'", m_id);
+		__debugbreak();
+	}
+
+	m_movedOrDestroyed = false;
+}
+
+
+
+void StreamingBuffer::destroy()
+{
+	if (!m_movedOrDestroyed && m_id)
+	{
+		for (auto& fence : m_fences)
+		{
+			if (fence != nullptr)
+				glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		glUnmapNamedBuffer(m_id);
+		m_mapped = nullptr;
+		m_logger->trace("Streaming buffer '{0}' has been deleted", m_id);
+		glDeleteBuffers(1, &m_id);
+		m_id = 0;
+		m_movedOrDestroyed = true;
+	}
+}
+
+
+
+void* StreamingBuffer::allocate(unsigned int sizeIn)
+{
+	GAME_ASSERT(sizeIn <= m_segmentSize);
+
+	// A frame that outgrows its segment fences it early and carries on in the next one
+	if (!m_released && m_used + sizeIn > m_segmentSize)
+		release();
+
+	if (m_released)
+		acquire();
+
+	m_allocationStart = m_used;
+	m_used += sizeIn;
+	return data();
+}
+
+
+
+void StreamingBuffer::commit(unsigned int sizeIn)
+{
+	GAME_ASSERT(m_allocationStart + sizeIn <= m_used);
+	m_used = m_allocationStart + sizeIn;
+}
+
+
+
+void StreamingBuffer::release()
+{
+	if (m_released)
+		return;
+
+	GLsync& fence = m_fences[m_currentSegment];
+	if (fence != nullptr)
+		glDeleteSync(fence);
+
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_released = true;
+}
+
+
+
+void* StreamingBuffer::data() const
+{
+	return m_mapped + offset();
+}
+
+
+
+void StreamingBuffer::acquire()
+{
+	m_currentSegment = (m_currentSegment + 1) % static_cast<unsigned int>(m_fences.size());
+	m_allocationStart = 0;
+	m_used = 0;
+	m_released = false;
+
+	GLsync& fence = m_fences[m_currentSegment];
+	if (fence != nullptr)
+	{
+		// One millisecond at a time so the commands are flushed on the first wait without spinning on the driver
+		constexpr GLuint64 TIMEOUT = 1000000;
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT);
+		while (result == GL_TIMEOUT_EXPIRED)
+			result = glClientWaitSync(fence, 0, TIMEOUT);
+
+		if (result == GL_WAIT_FAILED)
+			m_logger->error("Failed waiting on streaming buffer '{0}' segment {1}", m_id, m_currentSegment);
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
+
+
+
+void StreamingBuffer::bind() const
+{
+	glBindBuffer(getGL_BufferTarget(m_target), m_id);
+}
+
+
+
+void StreamingBuffer::unbind() const
+{
+	glBindBuffer(getGL_BufferTarget(m_target), 0);
+}
+
+
+
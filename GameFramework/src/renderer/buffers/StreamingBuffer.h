@@ -0,0 +1,185 @@
+#ifndef StreamingBuffer_H_
+#define StreamingBuffer_H_
+
+#include <vector>
+#include <memory>
+
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// A persistently mapped GPU buffer that is split into segments and used as a ring
+/// <para>
+/// Each frame writes its batches one after another into the current segment while the GPU reads from the segments before it.
+/// A segment is fenced once, when the frame that wrote it ends, so a segment is only written to once the GPU is done with it
+/// </para>
+/// </summary>
+class StreamingBuffer
+{
+public:
+
+	enum class Target : uint8_t
+	{
+		Vertex,
+		Index
+	};
+
+
+
+	static constexpr unsigned int DEFAULT_NUMBER_OF_SEGMENTS = 3;
+
+
+
+	StreamingBuffer();
+
+
+
+	StreamingBuffer(const StreamingBuffer& other) = delete;
+
+
+
+	StreamingBuffer(StreamingBuffer&& other) noexcept;
+
+
+
+	~StreamingBuffer();
+
+
+
+	/// <summary>
+	/// Creates a new persistently mapped buffer
+	/// </summary>
+	/// <param name="targetIn">Specifies what the buffer will be bound as</param>
+	/// <param name="segmentSizeIn">Specifies the size of each segment, measured in bytes</param>
+	/// <param name="numberOfSegmentsIn">Specifies the number of segments in the ring</param>
+	void create(Target targetIn, unsigned int segmentSizeIn, unsigned int numberOfSegmentsIn = DEFAULT_NUMBER_OF_SEGMENTS);
+
+
+
+	/// <summary>
+	/// Unmaps and destroys this buffer
+	/// </summary>
+	void destroy();
+
+
+
+	/// <summary>
+	/// Reserves space for a batch in the current segment, moving to the next segment if the current one is full
+	/// <para>Moving to a segment waits for the GPU to finish reading it if it is still in use</para>
+	/// </summary>
+	/// <param name="sizeIn">Specifies the most that will be written, measured in bytes, it must fit in a segment</param>
+	/// <returns>A pointer to the start of the reserved space</returns>
+	void* allocate(unsigned int sizeIn);
+
+
+
+	/// <summary>
+	/// Gives back the part of the last reservation that was not written to, so the next batch follows straight after it
+	/// </summary>
+	/// <param name="sizeIn">Specifies how much of the last reservation was written to, measured in bytes</param>
+	void commit(unsigned int sizeIn);
+
+
+
+	/// <summary>
+	/// Marks the current segment as being used by the GPU, the next reservation starts in the next segment
+	/// <para>This must be called once per frame, after the draw calls that read from the current segment have been issued</para>
+	/// </summary>
+	void release();
+
+
+
+	/// <summary>
+	/// Gets a pointer to the start of the last reservation
+	/// </summary>
+	/// <returns></returns>
+	void* data() const;
+
+
+
+	/// <summary>
+	/// Gets the offset of the last reservation from the start of the buffer, measured in bytes
+	/// </summary>
+	/// <returns></returns>
+	unsigned int offset() const { return m_currentSegment * m_segmentSize + m_allocationStart; }
+
+
+
+	/// <summary>
+	/// Gets the size of each segment, measured in bytes
+	/// </summary>
+	/// <returns></returns>
+	unsigned int segmentSize() const { return m_segmentSize; }
+
+
+
+	/// <summary>
+	/// Gets this buffer's OpenGL identifier
+	/// </summary>
+	/// <returns></returns>
+	unsigned int getID() const { return m_id; }
+
+
+
+	/// <summary>
+	/// Makes this the active buffer for its target
+	/// </summary>
+	void bind() const;
+
+
+
+	/// <summary>
+	/// Makes the currently active buffer for this buffer's target inactive
+	/// </summary>
+	void unbind() const;
+
+
+
+private:
+
+	/// <summary>
+	/// Moves to the next segment in the ring, waiting for the GPU to finish reading it if it is still in use
+	/// </summary>
+	void acquire();
+
+
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	unsigned int m_id = 0;
+
+	Target m_target = Target::Vertex;
+
+	unsigned char* m_mapped = nullptr;
+
+	unsigned int m_segmentSize = 0;
+
+	unsigned int m_currentSegment = 0;
+
+	/// <summary>
+	/// Where the last reservation starts in the current segment, measured in bytes
+	/// </summary>
+	unsigned int m_allocationStart = 0;
+
+	/// <summary>
+	/// How much of the current segment has been reserved, measured in bytes
+	/// </summary>
+	unsigned int m_used = 0;
+
+	/// <summary>
+	/// True once the current segment has been fenced, the next reservation must move to the next segment
+	/// </summary>
+	bool m_released = true;
+
+	std::vector<struct __GLsync*> m_fences;
+
+	bool m_movedOrDestroyed = false;
+};
+
+
+#endif /* StreamingBuffer_H_ */
+
+
+
@@ -0,0 +1,75 @@
+#include "renderer/buffers/UniformBuffer.h"
+#include "renderer/RendererFondation.h"
+
+
+
+
+UniformBuffer::UniformBuffer()
+{
+	m_logger = Loggers::getLog();
+}
+
+
+
+UniformBuffer::UniformBuffer(UniformBuffer&& other) noexcept
+	: m_logger(other.m_logger), m_id(other.m_id), m_size(other.m_size), m_binding(other.m_binding), m_movedOrDestroyed(other.m_movedOrDestroyed)
+{
+	other.m_id = 0;
+	other.m_movedOrDestroyed = true;
+}
+
+
+
+UniformBuffer::~UniformBuffer()
+{
+	destroy();
+}
+
+
+
+void UniformBuffer::create(unsigned int sizeIn, unsigned int bindingIn)
+{
+	if (m_id)
+	{
+		m_logger->warn("This uniform buffer has already been created.");
+		return;
+	}
+
+	m_size = sizeIn;
+	m_binding = bindingIn;
+	glCreateBuffers(1, &m_id);
+	glNamedBufferStorage(m_id, m_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+	bind();
+	m_movedOrDestroyed = false;
+}
+
+
+
+void UniformBuffer::destroy()
+{
+	if (!m_movedOrDestroyed && m_id)
+	{
+		m_logger->trace("Uniform buffer '{0}' has been deleted", m_id);
+		glDeleteBuffers(1, &m_id);
+		m_id = 0;
+		m_movedOrDestroyed = true;
+	}
+}
+
+
+
+void UniformBuffer::submitData(const void* dataIn, unsigned int sizeIn, unsigned int offsetIn)
+{
+	GAME_ASSERT(offsetIn + sizeIn <= m_size);
+	glNamedBufferSubData(m_id, offsetIn, sizeIn, dataIn);
+}
+
+
+
+void UniformBuffer::bind() const
+{
+	glBindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_id);
+}
+
+
+
@@ -0,0 +1,92 @@
+#ifndef UniformBuffer_H_
+#define UniformBuffer_H_
+
+#include <memory>
+
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// A block of uniform data in GPU memory that is bound to a fixed binding point and shared by every shader that declares the block
+/// </summary>
+class UniformBuffer
+{
+public:
+
+	UniformBuffer();
+
+
+
+	UniformBuffer(const UniformBuffer& other) = delete;
+
+
+
+	UniformBuffer(UniformBuffer&& other) noexcept;
+
+
+
+	~UniformBuffer();
+
+
+
+	/// <summary>
+	/// Creates a new uniform buffer and binds it to the given binding point
+	/// </summary>
+	/// <param name="sizeIn">Specifies the size of the uniform buffer, measured in bytes</param>
+	/// <param name="bindingIn">Specifies the uniform block binding point</param>
+	void create(unsigned int sizeIn, unsigned int bindingIn);
+
+
+
+	/// <summary>
+	/// Destroys this uniform buffer and frees all of its data
+	/// </summary>
+	void destroy();
+
+
+
+	/// <summary>
+	/// Replaces part of this uniform buffer's data
+	/// </summary>
+	/// <param name="dataIn">Specifies the new data, which must follow the std140 layout of the block</param>
+	/// <param name="sizeIn">Specifies the size of the new data, measured in bytes</param>
+	/// <param name="offsetIn">Specifies the starting location of the new data, measured in bytes</param>
+	void submitData(const void* dataIn, unsigned int sizeIn, unsigned int offsetIn = 0);
+
+
+
+	/// <summary>
+	/// Binds this uniform buffer to its binding point
+	/// </summary>
+	void bind() const;
+
+
+
+	/// <summary>
+	/// Gets the uniform block binding point this buffer is bound to
+	/// </summary>
+	/// <returns></returns>
+	unsigned int getBinding() const { return m_binding; }
+
+
+
+private:
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	unsigned int m_id = 0;
+
+	unsigned int m_size = 0;
+
+	unsigned int m_binding = 0;
+
+	bool m_movedOrDestroyed = false;
+};
+
+
+#endif /* UniformBuffer_H_ */
+
+
+
@@ -1,6 +1,8 @@
 #include <iostream>
+#include <cstdint>
 
 #include "renderer/buffers/VertexBuffer.h"
+#include "renderer/buffers/StreamingBuffer.h"
 #include "renderer/RendererFondation.h"
 
 
@@ -22,6 +24,18 @@ unsigned int getGL_DataType(VertexBuffer::Attribute typeIn)
 	case VertexBuffer::Attribute::Float4:
 		return GL_FLOAT;
 
+	case VertexBuffer::Attribute::UByte4:
+		return GL_UNSIGNED_BYTE;
+
+	case VertexBuffer::Attribute::Half2:
+		return GL_HALF_FLOAT;
+
+	case VertexBuffer::Attribute::Short2:
+		return GL_SHORT;
+
+	case VertexBuffer::Attribute::UInt1:
+		return GL_UNSIGNED_INT;
+
 	default:
 		return GL_FLOAT;
 	}
@@ -45,6 +59,18 @@ unsigned int getVertexAttributeSize(VertexBuffer::Attribute typeIn)
 	case VertexBuffer::Attribute::Float4:
 		return sizeof(float) * 4;
 
+	case VertexBuffer::Attribute::UByte4:
+		return sizeof(unsigned char) * 4;
+
+	case VertexBuffer::Attribute::Half2:
+		return sizeof(uint16_t) * 2;
+
+	case VertexBuffer::Attribute::Short2:
+		return sizeof(int16_t) * 2;
+
+	case VertexBuffer::Attribute::UInt1:
+		return sizeof(unsigned int);
+
 	default:
 		Loggers::getLog()->error("Invalid vertex buffer attribute data type!");
 		__debugbreak();
@@ -77,6 +103,18 @@ unsigned int VertexBuffer::Element::count() const
 	case VertexBuffer::Attribute::Float4:
 		return 4;
 
+	case VertexBuffer::Attribute::UByte4:
+		return 4;
+
+	case VertexBuffer::Attribute::Half2:
+		return 2;
+
+	case VertexBuffer::Attribute::Short2:
+		return 2;
+
+	case VertexBuffer::Attribute::UInt1:
+		return 1;
+
 	default:
 		return 0;
 	}
@@ -84,9 +122,17 @@ unsigned int VertexBuffer::Element::count() const
 
 
 
+bool VertexBuffer::Element::isInteger() const
+{
+	return type == VertexBuffer::Attribute::UInt1;
+}
+
+
+
 VertexBuffer::Layout& VertexBuffer::Layout::add(VertexBuffer::Attribute typeIn, const std::string& nameIn, bool isNormalized)
 {
 	m_elements.push_back({ typeIn, nameIn, isNormalized });
+	m_stride += m_elements.back().size;
 	return *this;
 }
 
@@ -95,6 +141,7 @@ VertexBuffer::Layout& VertexBuffer::Layout::add(VertexBuffer::Attribute typeIn,
 VertexBuffer::Layout& VertexBuffer::Layout::add(VertexBuffer::Attribute typeIn, const std::string& nameIn)
 {
 	m_elements.push_back({ typeIn, nameIn, false });
+	m_stride += m_elements.back().size;
 	return *this;
 }
 
@@ -119,6 +166,28 @@ unsigned int VertexBuffer::Layout::count() const
 
 
 
+unsigned int VertexBuffer::Layout::stride() const
+{
+	return m_stride;
+}
+
+
+
+VertexBuffer::Layout& VertexBuffer::Layout::setDivisor(unsigned int divisorIn)
+{
+	m_divisor = divisorIn;
+	return *this;
+}
+
+
+
+unsigned int VertexBuffer::Layout::divisor() const
+{
+	return m_divisor;
+}
+
+
+
 void VertexBuffer::Layout::update()
 {
 	m_stride = 0;
@@ -147,7 +216,7 @@ VertexBuffer::VertexBuffer()
 
 
 VertexBuffer::VertexBuffer(VertexBuffer&& other) noexcept
-	: m_id(other.m_id), m_vbo(other.m_vbo), m_usage(other.m_usage) 
+	: m_id(other.m_id), m_vbo(other.m_vbo), m_ownsBuffer(other.m_ownsBuffer), m_usage(other.m_usage) 
 {
 	other.m_id = 0;
 	other.m_vbo = 0;
@@ -218,6 +287,23 @@ void VertexBuffer::create(float* vertices, unsigned int size, Usage usage)
 
 
 
+void VertexBuffer::create(const StreamingBuffer& bufferIn)
+{
+	if (m_vbo) 
+	{
+		m_logger->warn("This vertex buffer has already been created.");
+		return;
+	}
+
+	glBindVertexArray(m_id);
+	m_vbo = bufferIn.getID();
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	m_ownsBuffer = false;
+	m_usage = Usage::Stream;
+}
+
+
+
 void VertexBuffer::destroy()
 {
 	if (!m_movedOrDestroyed)
@@ -225,8 +311,11 @@ void VertexBuffer::destroy()
 		m_logger->trace("Vertex array '{0}' has been deleted", m_id);
 		glDeleteVertexArrays(1, &m_id);
 		m_id = 0;
-		m_logger->trace("Vertex buffer '{0}' has been deleted", m_vbo);
-		glDeleteBuffers(1, &m_vbo);
+		if (m_ownsBuffer)
+		{
+			m_logger->trace("Vertex buffer '{0}' has been deleted", m_vbo);
+			glDeleteBuffers(1, &m_vbo);
+		}
 		m_vbo = 0;
 		m_movedOrDestroyed = true;
 	}
@@ -250,12 +339,24 @@ void VertexBuffer::setLayout(VertexBuffer::Layout& layout)
 	for (const auto& element : layout.m_elements) 
 	{
 		glEnableVertexAttribArray(index);
-		glVertexAttribPointer(index,
-			element.count(),
-			getGL_DataType(element.type),
-			element.normalized ? GL_TRUE : GL_FALSE,
-			layout.m_stride,
-			(const void*)element.offset);
+		if (element.isInteger())
+		{
+			glVertexAttribIPointer(index,
+				element.count(),
+				getGL_DataType(element.type),
+				layout.m_stride,
+				(const void*)element.offset);
+		}
+		else
+		{
+			glVertexAttribPointer(index,
+				element.count(),
+				getGL_DataType(element.type),
+				element.normalized ? GL_TRUE : GL_FALSE,
+				layout.m_stride,
+				(const void*)element.offset);
+		}
+		glVertexAttribDivisor(index, layout.m_divisor);
 
 		index++;
 	}
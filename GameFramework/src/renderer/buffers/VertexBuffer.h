@@ -22,12 +22,20 @@ public:
 
 
 
+	/// <summary>
+	/// The data type of a vertex attribute
+	/// <para>UInt1 is read by the shader as an integer, all other types are converted to floats</para>
+	/// </summary>
 	enum class Attribute : uint8_t
 	{
 		Float1,
 		Float2,
 		Float3,
-		Float4
+		Float4,
+		UByte4,
+		Half2,
+		Short2,
+		UInt1
 	};
 
 
@@ -46,6 +54,14 @@ public:
 
 
 
+		/// <summary>
+		/// Checks if this vertex buffer element is read by the shader as an integer
+		/// </summary>
+		/// <returns></returns>
+		bool isInteger() const;
+
+
+
 		VertexBuffer::Attribute type;
 
 		std::string name;
@@ -102,6 +118,32 @@ public:
 
 
 
+		/// <summary>
+		/// Gets the size of one vertex in this vertex buffer layout, measured in bytes
+		/// </summary>
+		/// <returns></returns>
+		unsigned int stride() const;
+
+
+
+		/// <summary>
+		/// Sets how often the attributes in this layout advance
+		/// <para>0 advances them once per vertex, otherwise they advance once every divisor instances</para>
+		/// </summary>
+		/// <param name="divisorIn"></param>
+		/// <returns>A referance to this vertext buffer layout</returns>
+		Layout& setDivisor(unsigned int divisorIn);
+
+
+
+		/// <summary>
+		/// Gets how often the attributes in this layout advance
+		/// </summary>
+		/// <returns></returns>
+		unsigned int divisor() const;
+
+
+
 	private:
 
 		/// <summary>
@@ -114,6 +156,8 @@ public:
 		std::vector<VertexBuffer::Element> m_elements;
 
 		unsigned int m_stride = 0;
+
+		unsigned int m_divisor = 0;
 	};
 
 
@@ -147,6 +191,17 @@ public:
 
 
 
+	/// <summary>
+	/// Creates a new vertex buffer that reads its vertex data from the given streaming buffer
+	/// <para>
+	/// The streaming buffer is not owned by this vertex buffer and must outlive it, vertex data is written through the streaming buffer
+	/// </para>
+	/// </summary>
+	/// <param name="bufferIn">Specifies the streaming buffer that holds the vertex data</param>
+	void create(const class StreamingBuffer& bufferIn);
+
+
+
 	/// <summary>
 	/// Destroys this vertex buffer and frees all of its data
 	/// </summary>
@@ -227,6 +282,8 @@ private:
 
 	unsigned int m_vbo;
 
+	bool m_ownsBuffer = true;
+
 	std::vector<Layout> m_layouts;
 
 	Usage m_usage;
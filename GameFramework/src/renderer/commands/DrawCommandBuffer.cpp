@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cstring>
+
+#include "renderer/commands/DrawCommandBuffer.h"
+
+
+
+
+uint32_t SortKey::depthToLayer(float depthIn)
+{
+	float depth = std::clamp(depthIn, -1.0f, 1.0f);
+	return static_cast<uint32_t>((depth + 1.0f) * 0.5f * static_cast<float>(LAYER_MASK) + 0.5f);
+}
+
+
+
+void DrawCommandBuffer::reserve(size_t countIn)
+{
+	m_commands.reserve(countIn);
+	m_entries.reserve(countIn);
+	m_scratch.reserve(countIn);
+}
+
+
+
+void DrawCommandBuffer::push(uint64_t keyIn, const QuadDrawCommand& commandIn)
+{
+	m_entries.push_back({ keyIn, static_cast<uint32_t>(m_commands.size()) });
+	m_commands.push_back(commandIn);
+}
+
+
+
+void DrawCommandBuffer::sort()
+{
+	constexpr int RADIX_BITS = 8;
+	constexpr int NUMBER_OF_BUCKETS = 1 << RADIX_BITS;
+	constexpr int NUMBER_OF_PASSES = sizeof(uint64_t) * 8 / RADIX_BITS;
+
+	const size_t count = m_entries.size();
+	if (count < 2)
+		return;
+
+	// All histograms are built in a single pass over the keys
+	uint32_t histograms[NUMBER_OF_PASSES][NUMBER_OF_BUCKETS];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (const Entry& entry : m_entries)
+	{
+		for (int pass = 0; pass < NUMBER_OF_PASSES; pass++)
+			histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (NUMBER_OF_BUCKETS - 1)]++;
+	}
+
+	m_scratch.resize(count);
+	Entry* src = m_entries.data();
+	Entry* dst = m_scratch.data();
+	for (int pass = 0; pass < NUMBER_OF_PASSES; pass++)
+	{
+		const int shift = pass * RADIX_BITS;
+		uint32_t* histogram = histograms[pass];
+
+		// When every key shares the same digit this pass would not move anything
+		if (histogram[(src[0].key >> shift) & (NUMBER_OF_BUCKETS - 1)] == count)
+			continue;
+
+		uint32_t offset = 0;
+		for (int bucket = 0; bucket < NUMBER_OF_BUCKETS; bucket++)
+		{
+			uint32_t bucketSize = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketSize;
+		}
+
+		for (size_t i = 0; i < count; i++)
+			dst[histogram[(src[i].key >> shift) & (NUMBER_OF_BUCKETS - 1)]++] = src[i];
+
+		std::swap(src, dst);
+	}
+
+	if (src != m_entries.data())
+		m_entries.swap(m_scratch);
+}
+
+
+
+void DrawCommandBuffer::clear()
+{
+	m_commands.clear();
+	m_entries.clear();
+}
+
+
+
@@ -0,0 +1,195 @@
+#ifndef DrawCommandBuffer_H_
+#define DrawCommandBuffer_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+
+
+
+/// <summary>
+/// Packs the state a quad needs to be drawn with into a single 64-bit integer so that draw commands can be ordered with one radix sort
+/// <para>Bits 48-63 hold the layer, 40-47 the shader, 20-39 the texture, 18-19 the blend mode, and 0-17 are reserved</para>
+/// </summary>
+class SortKey
+{
+public:
+
+	static constexpr int LAYER_SHIFT = 48;
+
+	static constexpr int SHADER_SHIFT = 40;
+
+	static constexpr int TEXTURE_SHIFT = 20;
+
+	static constexpr int BLEND_SHIFT = 18;
+
+	static constexpr uint64_t LAYER_MASK = 0xFFFF;
+
+	static constexpr uint64_t SHADER_MASK = 0xFF;
+
+	static constexpr uint64_t TEXTURE_MASK = 0xFFFFF;
+
+	static constexpr uint64_t BLEND_MASK = 0x3;
+
+
+
+	/// <summary>
+	/// Builds a new sort key, fields are ordered from most to least significant
+	/// </summary>
+	/// <param name="layerIn">Specifies the draw layer, lower layers are drawn first</param>
+	/// <param name="shaderIn">Specifies the shader's index</param>
+	/// <param name="textureIn">Specifies the texture's index</param>
+	/// <param name="blendIn">Specifies the blend mode</param>
+	/// <returns></returns>
+	static constexpr uint64_t make(uint32_t layerIn, uint32_t shaderIn, uint32_t textureIn, uint32_t blendIn)
+	{
+		return ((layerIn & LAYER_MASK) << LAYER_SHIFT)
+			| ((shaderIn & SHADER_MASK) << SHADER_SHIFT)
+			| ((textureIn & TEXTURE_MASK) << TEXTURE_SHIFT)
+			| ((blendIn & BLEND_MASK) << BLEND_SHIFT);
+	}
+
+
+
+	/// <summary>
+	/// Converts a depth in normalized device space, [-1, 1], into a draw layer
+	/// </summary>
+	/// <param name="depthIn"></param>
+	/// <returns></returns>
+	static uint32_t depthToLayer(float depthIn);
+
+
+
+	static constexpr uint32_t layer(uint64_t keyIn) { return static_cast<uint32_t>((keyIn >> LAYER_SHIFT) & LAYER_MASK); }
+
+
+
+	static constexpr uint32_t shader(uint64_t keyIn) { return static_cast<uint32_t>((keyIn >> SHADER_SHIFT) & SHADER_MASK); }
+
+
+
+	static constexpr uint32_t texture(uint64_t keyIn) { return static_cast<uint32_t>((keyIn >> TEXTURE_SHIFT) & TEXTURE_MASK); }
+
+
+
+	static constexpr uint32_t blend(uint64_t keyIn) { return static_cast<uint32_t>((keyIn >> BLEND_SHIFT) & BLEND_MASK); }
+};
+
+
+
+struct QuadDrawCommand
+{
+	glm::vec3 pos;
+
+	glm::vec2 size;
+
+	glm::vec4 color;
+
+	/// <summary>
+	/// Index of the texture in the renderer's active texture list, or -1 for solid color quads
+	/// </summary>
+	int textureID;
+
+	unsigned int subTextureIndex;
+};
+
+
+
+/// <summary>
+/// A linear list of quad draw commands that is recorded each frame and then sorted by key
+/// <para>Memory is kept between frames so once the buffer has grown to a frame's worth of commands, recording does not allocate</para>
+/// </summary>
+class DrawCommandBuffer
+{
+public:
+
+	struct Entry
+	{
+		uint64_t key;
+
+		uint32_t index;
+	};
+
+
+
+	DrawCommandBuffer() = default;
+
+
+
+	DrawCommandBuffer(const DrawCommandBuffer& other) = delete;
+
+
+
+	/// <summary>
+	/// Reserves memory for the given number of commands
+	/// </summary>
+	/// <param name="countIn"></param>
+	void reserve(size_t countIn);
+
+
+
+	/// <summary>
+	/// Adds a new command to the end of this buffer
+	/// </summary>
+	/// <param name="keyIn">Specifies the command's sort key</param>
+	/// <param name="commandIn">Specifies the command</param>
+	void push(uint64_t keyIn, const QuadDrawCommand& commandIn);
+
+
+
+	/// <summary>
+	/// Orders all commands by their sort key using a least significant digit radix sort
+	/// <para>The sort is stable, so commands with equal keys keep the order that they were submitted in</para>
+	/// </summary>
+	void sort();
+
+
+
+	/// <summary>
+	/// Removes all commands while keeping the memory that they used
+	/// </summary>
+	void clear();
+
+
+
+	/// <summary>
+	/// Gets the sort entries, which are only in order after DrawCommandBuffer::sort has been called
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<Entry>& entries() const { return m_entries; }
+
+
+
+	/// <summary>
+	/// Gets the command for the given entry
+	/// </summary>
+	/// <param name="entryIn"></param>
+	/// <returns></returns>
+	const QuadDrawCommand& get(const Entry& entryIn) const { return m_commands[entryIn.index]; }
+
+
+
+	size_t size() const { return m_commands.size(); }
+
+
+
+	bool empty() const { return m_commands.empty(); }
+
+
+
+private:
+
+	std::vector<QuadDrawCommand> m_commands;
+
+	std::vector<Entry> m_entries;
+
+	std::vector<Entry> m_scratch;
+};
+
+
+#endif /* DrawCommandBuffer_H_ */
+
+
+
@@ -36,6 +36,20 @@ glm::vec3& Camera::pos()
 
 
 
+float Camera::rotation() const
+{
+	return m_rotation;
+}
+
+
+
+void Camera::setRotation(float degreesIn)
+{
+	m_rotation = degreesIn;
+}
+
+
+
 float Camera::width() const
 {
 	return m_width;
@@ -74,9 +88,9 @@ const glm::mat4& Camera::getViewProjection() const
 void Camera::SetViewportSize(float width, float height)
 {
 	m_projection = glm::ortho<float>(0.0f, width, height, 0.0f, -1.0f, 1.0f);
-	update();
 	m_width = width;
 	m_height = height;
+	update();
 }
 
 
@@ -86,6 +100,17 @@ void Camera::update()
 	glm::mat4 transform = glm::translate(glm::mat4(1.0f), m_position) * glm::rotate(glm::mat4(1.0f), glm::radians(m_rotation), glm::vec3(0, 0, 1));
 	m_view = glm::inverse(transform);
 	m_viewProjection = m_projection * m_view;
+
+	// The viewport's corners are moved into world space and the visible rectangle is the box around them
+	const glm::vec2 corners[] = { { 0.0f, 0.0f }, { m_width, 0.0f }, { m_width, m_height }, { 0.0f, m_height } };
+	m_visibleMin = glm::vec2(transform * glm::vec4(corners[0], 0.0f, 1.0f));
+	m_visibleMax = m_visibleMin;
+	for (int i = 1; i < 4; i++)
+	{
+		glm::vec2 corner = glm::vec2(transform * glm::vec4(corners[i], 0.0f, 1.0f));
+		m_visibleMin = glm::min(m_visibleMin, corner);
+		m_visibleMax = glm::max(m_visibleMax, corner);
+	}
 }
 
 
@@ -38,6 +38,22 @@ public:
 
 
 
+	/// <summary>
+	/// Gets this camera's rotation around its position, measured in degrees
+	/// </summary>
+	/// <returns></returns>
+	float rotation() const;
+
+
+
+	/// <summary>
+	/// Sets this camera's rotation around its position, which takes effect from the next call to Camera::update
+	/// </summary>
+	/// <param name="degreesIn"></param>
+	void setRotation(float degreesIn);
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -78,6 +94,22 @@ public:
 
 
 
+	/// <summary>
+	/// Gets the minimum corner of the world space rectangle that holds everything this camera can see
+	/// </summary>
+	/// <returns></returns>
+	const glm::vec2& getVisibleMin() const { return m_visibleMin; }
+
+
+
+	/// <summary>
+	/// Gets the maximum corner of the world space rectangle that holds everything this camera can see
+	/// </summary>
+	/// <returns></returns>
+	const glm::vec2& getVisibleMax() const { return m_visibleMax; }
+
+
+
 	/// <summary>
 	/// 
 	/// </summary>
@@ -88,7 +120,7 @@ public:
 
 
 	/// <summary>
-	/// Updates this camera's view matrix
+	/// Updates this camera's view matrix and visible rectangle
 	/// </summary>
 	void update();
 
@@ -109,6 +141,10 @@ private:
 	float m_rotation = 0.0f;
 
 	float m_width, m_height;
+
+	glm::vec2 m_visibleMin = { 0.0f, 0.0f };
+
+	glm::vec2 m_visibleMax = { 0.0f, 0.0f };
 };
 
 
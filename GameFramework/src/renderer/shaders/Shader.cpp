@@ -1,11 +1,13 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <cstring>
 
 #include <glm/gtc/type_ptr.hpp>
 
 #include "renderer/shaders/Shader.h"
 #include "renderer/RendererFondation.h"
+#include "utilities/AssetCache.h"
 
 
 
@@ -41,7 +43,7 @@ Shader::~Shader()
 
 
 
-void Shader::create(const std::filesystem::path& vertexFilepath, const std::filesystem::path& pixelFilepath)
+void Shader::create(const std::filesystem::path& vertexFilepath, const std::filesystem::path& pixelFilepath, AssetCache* cacheIn)
 {
 	if (!m_id)
 	{
@@ -56,12 +58,7 @@ void Shader::create(const std::filesystem::path& vertexFilepath, const std::file
 			__debugbreak();
 		}
 		else
-		{
-			unsigned int vertexShaderID = Shader::compile(Type::VERTEX, Shader::load(vertexFilepath.string()));
-			unsigned int pixelShaderID = Shader::compile(Type::PIXEL, Shader::load(pixelFilepath.string()));
-			m_id = Shader::link(vertexShaderID, pixelShaderID);
-			buildUniforms();
-		}
+			createFromString(Shader::load(vertexFilepath.string()), Shader::load(pixelFilepath.string()), cacheIn);
 	}
 	else
 		m_logger->warn("Shader OpenGL ID: '{0}' has already been created", m_id);
@@ -69,13 +66,26 @@ void Shader::create(const std::filesystem::path& vertexFilepath, const std::file
 
 
 
-void Shader::createFromString(const std::string& vertexSrc, const std::string& pixelSrc)
+void Shader::createFromString(const std::string& vertexSrc, const std::string& pixelSrc, AssetCache* cacheIn)
 {
 	if (!m_id)
 	{
-		unsigned int vertexShaderID = Shader::compile(Type::VERTEX, vertexSrc);
-		unsigned int pixelShaderID = Shader::compile(Type::PIXEL, pixelSrc);
-		m_id = Shader::link(vertexShaderID, pixelShaderID);
+		// A cached program skips compiling and linking, the sources are only compiled when the binary is missing or rejected
+		uint64_t key = 0;
+		if (cacheIn)
+		{
+			key = Shader::getProgramKey(vertexSrc, pixelSrc);
+			m_id = Shader::loadProgram(*cacheIn, key);
+		}
+
+		if (!m_id)
+		{
+			unsigned int vertexShaderID = Shader::compile(Type::VERTEX, vertexSrc);
+			unsigned int pixelShaderID = Shader::compile(Type::PIXEL, pixelSrc);
+			m_id = Shader::link(vertexShaderID, pixelShaderID, cacheIn != nullptr);
+			if (cacheIn && m_id)
+				Shader::storeProgram(*cacheIn, key, m_id);
+		}
 		buildUniforms();
 	}
 	else
@@ -148,11 +158,13 @@ unsigned int Shader::compile(Type type, const std::string& src)
 
 
 
-unsigned int Shader::link(unsigned int vertexShaderID, unsigned int pixelShaderID) 
+unsigned int Shader::link(unsigned int vertexShaderID, unsigned int pixelShaderID, bool retrievableIn) 
 {
 	unsigned int programID = glCreateProgram();
 	glAttachShader(programID, vertexShaderID);
 	glAttachShader(programID, pixelShaderID);
+	if (retrievableIn)
+		glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glLinkProgram(programID);
 
 	int isLinked = 0;
@@ -178,6 +190,65 @@ unsigned int Shader::link(unsigned int vertexShaderID, unsigned int pixelShaderI
 
 
 
+uint64_t Shader::getProgramKey(const std::string& vertexSrc, const std::string& pixelSrc)
+{
+	uint64_t key = AssetCache::hash(vertexSrc);
+	key = AssetCache::hash(pixelSrc, key);
+	for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+	{
+		const char* driver = reinterpret_cast<const char*>(glGetString(name));
+		if (driver)
+			key = AssetCache::hash(driver, std::strlen(driver), key);
+	}
+	return key;
+}
+
+
+
+unsigned int Shader::loadProgram(AssetCache& cacheIn, uint64_t keyIn)
+{
+	int numberOfFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numberOfFormats);
+	std::vector<unsigned char> binary;
+	if (numberOfFormats <= 0 || !cacheIn.read("programs", keyIn, binary) || binary.size() <= sizeof(uint32_t))
+		return 0;
+
+	// The entry is the binary's format followed by the binary itself
+	uint32_t format = 0;
+	std::memcpy(&format, binary.data(), sizeof(format));
+	unsigned int programID = glCreateProgram();
+	glProgramBinary(programID, format, binary.data() + sizeof(format), static_cast<GLsizei>(binary.size() - sizeof(format)));
+
+	// Drivers reject binaries from other versions of themselves, the program is then compiled from source as normal
+	int isLinked = 0;
+	glGetProgramiv(programID, GL_LINK_STATUS, &isLinked);
+	if (isLinked == GL_FALSE)
+	{
+		Loggers::getLog()->info("A cached shader program was rejected by the driver, it will be compiled again");
+		glDeleteProgram(programID);
+		return 0;
+	}
+	return programID;
+}
+
+
+
+void Shader::storeProgram(AssetCache& cacheIn, uint64_t keyIn, unsigned int programIDIn)
+{
+	int length = 0;
+	glGetProgramiv(programIDIn, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	uint32_t format = 0;
+	std::vector<unsigned char> binary(sizeof(format) + length);
+	glGetProgramBinary(programIDIn, length, &length, &format, binary.data() + sizeof(format));
+	std::memcpy(binary.data(), &format, sizeof(format));
+	cacheIn.store("programs", keyIn, binary.data(), sizeof(format) + length);
+}
+
+
+
 bool Shader::hasUniform(const std::string& nameIn) const
 {
 	return m_uniformsLookup.find(nameIn) != m_uniformsLookup.end();
@@ -200,6 +271,32 @@ Shader::Uniform* Shader::getUniform(const std::string& nameIn)
 
 
 
+Shader::UniformHandle Shader::getUniformHandle(const std::string& nameIn) const
+{
+	auto uniform = m_uniformsLookup.find(nameIn);
+	if (uniform == m_uniformsLookup.end())
+	{
+		m_logger->warn("Uniform '{0}' is either unused, invalid, or misspelled", nameIn);
+		return UniformHandle();
+	}
+
+	return UniformHandle(static_cast<int>(uniform->second));
+}
+
+
+
+bool Shader::bindUniformBlock(const std::string& blockNameIn, unsigned int bindingIn)
+{
+	unsigned int index = glGetUniformBlockIndex(m_id, blockNameIn.c_str());
+	if (index == GL_INVALID_INDEX)
+		return false;
+
+	glUniformBlockBinding(m_id, index, bindingIn);
+	return true;
+}
+
+
+
 std::vector<Shader::Uniform>& Shader::getUniforms()
 {
 	return m_uniforms;
@@ -216,13 +313,18 @@ const std::vector<Shader::Uniform>& Shader::getUniforms() const
 
 Shader& Shader::setUniformBool1(const std::string& nameIn, bool dataIn)
 {
-	setUniform<bool>(nameIn, Uniform::Type::Bool1, dataIn, 1, [this](bool dataIn, unsigned int countIn, const Uniform& uniform)
-		{
-			int params;
-			glGetUniformiv(m_id, uniform.getLocation(), &params);
+	return setUniformBool1(getUniformHandle(nameIn), dataIn);
+}
+
 
-			if ((params ? 1 : 0) != dataIn)
-				glUniform1i(uniform.getLocation(), dataIn ? 1 : 0);
+
+Shader& Shader::setUniformBool1(UniformHandle handleIn, bool dataIn)
+{
+	setUniform<bool>(handleIn, Uniform::Type::Bool1, dataIn, 1, [](bool dataIn, unsigned int countIn, Uniform& uniform)
+		{
+			int data = dataIn ? 1 : 0;
+			if (uniform.updateCache(&data, sizeof(data)))
+				glUniform1i(uniform.getLocation(), data);
 		});
 
 	return *this;
@@ -232,11 +334,16 @@ Shader& Shader::setUniformBool1(const std::string& nameIn, bool dataIn)
 
 Shader& Shader::setUniformInt1(const std::string& nameIn, int dataIn)
 {
-	setUniform<int>(nameIn, Uniform::Type::Int1, dataIn, 1, [this](int dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformInt1(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformInt1(UniformHandle handleIn, int dataIn)
+{
+	setUniform<int>(handleIn, Uniform::Type::Int1, dataIn, 1, [](int dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			int params;
-			glGetUniformiv(m_id, uniform.getLocation(), &params);
-			if (params != dataIn)
+			if (uniform.updateCache(&dataIn, sizeof(dataIn)))
 				glUniform1i(uniform.getLocation(), dataIn);
 		});
 
@@ -247,9 +354,17 @@ Shader& Shader::setUniformInt1(const std::string& nameIn, int dataIn)
 
 Shader& Shader::setUniformInt1(const std::string& nameIn, int* dataIn, unsigned int countIn)
 {
-	setUniform<int*>(nameIn, Uniform::Type::Int1Array, dataIn, countIn, [this](int* dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformInt1(getUniformHandle(nameIn), dataIn, countIn);
+}
+
+
+
+Shader& Shader::setUniformInt1(UniformHandle handleIn, int* dataIn, unsigned int countIn)
+{
+	setUniform<int*>(handleIn, Uniform::Type::Int1Array, dataIn, countIn, [](int* dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform1iv(uniform.getLocation(), countIn, dataIn);
+			if (uniform.updateCache(dataIn, sizeof(int) * countIn))
+				glUniform1iv(uniform.getLocation(), countIn, dataIn);
 		});
 
 	return *this;
@@ -259,9 +374,17 @@ Shader& Shader::setUniformInt1(const std::string& nameIn, int* dataIn, unsigned
 
 Shader& Shader::setUniformInt2(const std::string& nameIn, const glm::ivec2& dataIn)
 {
-	setUniform<glm::ivec2>(nameIn, Uniform::Type::Int2, dataIn, 1, [this](glm::ivec2 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformInt2(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformInt2(UniformHandle handleIn, const glm::ivec2& dataIn)
+{
+	setUniform<glm::ivec2>(handleIn, Uniform::Type::Int2, dataIn, 1, [](glm::ivec2 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform2iv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniform2iv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -271,9 +394,17 @@ Shader& Shader::setUniformInt2(const std::string& nameIn, const glm::ivec2& data
 
 Shader& Shader::setUniformInt3(const std::string& nameIn, const glm::ivec3& dataIn)
 {
-	setUniform<glm::ivec3>(nameIn, Uniform::Type::Int3, dataIn, 1, [this](glm::ivec3 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformInt3(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformInt3(UniformHandle handleIn, const glm::ivec3& dataIn)
+{
+	setUniform<glm::ivec3>(handleIn, Uniform::Type::Int3, dataIn, 1, [](glm::ivec3 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform3iv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniform3iv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -283,9 +414,17 @@ Shader& Shader::setUniformInt3(const std::string& nameIn, const glm::ivec3& data
 
 Shader& Shader::setUniformInt4(const std::string& nameIn, const glm::ivec4& dataIn)
 {
-	setUniform<glm::ivec4>(nameIn, Uniform::Type::Int4, dataIn, 1, [this](glm::ivec4 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformInt4(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformInt4(UniformHandle handleIn, const glm::ivec4& dataIn)
+{
+	setUniform<glm::ivec4>(handleIn, Uniform::Type::Int4, dataIn, 1, [](glm::ivec4 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform4iv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniform4iv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -295,11 +434,16 @@ Shader& Shader::setUniformInt4(const std::string& nameIn, const glm::ivec4& data
 
 Shader& Shader::setUniformSampler2D(const std::string& nameIn, int dataIn)
 {
-	setUniform<int>(nameIn, Uniform::Type::Sampler2D, dataIn, 1, [this](const int dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformSampler2D(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformSampler2D(UniformHandle handleIn, int dataIn)
+{
+	setUniform<int>(handleIn, Uniform::Type::Sampler2D, dataIn, 1, [](int dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			int params;
-			glGetUniformiv(m_id, uniform.getLocation(), &params);
-			if (params != dataIn)
+			if (uniform.updateCache(&dataIn, sizeof(dataIn)))
 				glUniform1i(uniform.getLocation(), dataIn);
 		});
 
@@ -310,9 +454,17 @@ Shader& Shader::setUniformSampler2D(const std::string& nameIn, int dataIn)
 
 Shader& Shader::setUniformSampler2D(const std::string& nameIn, int* dataIn, unsigned int countIn)
 {
-	setUniform<int*>(nameIn, Uniform::Type::Sampler2D1Array, dataIn, countIn, [this](int* dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformSampler2D(getUniformHandle(nameIn), dataIn, countIn);
+}
+
+
+
+Shader& Shader::setUniformSampler2D(UniformHandle handleIn, int* dataIn, unsigned int countIn)
+{
+	setUniform<int*>(handleIn, Uniform::Type::Sampler2D1Array, dataIn, countIn, [](int* dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform1iv(uniform.getLocation(), countIn, dataIn);
+			if (uniform.updateCache(dataIn, sizeof(int) * countIn))
+				glUniform1iv(uniform.getLocation(), countIn, dataIn);
 		});
 
 	return *this;
@@ -320,14 +472,38 @@ Shader& Shader::setUniformSampler2D(const std::string& nameIn, int* dataIn, unsi
 
 
 
+Shader& Shader::setUniformSampler2DArray(const std::string& nameIn, int* dataIn, unsigned int countIn)
+{
+	return setUniformSampler2DArray(getUniformHandle(nameIn), dataIn, countIn);
+}
+
+
+
+Shader& Shader::setUniformSampler2DArray(UniformHandle handleIn, int* dataIn, unsigned int countIn)
+{
+	setUniform<int*>(handleIn, Uniform::Type::Sampler2DArray1Array, dataIn, countIn, [](int* dataIn, unsigned int countIn, Uniform& uniform)
+		{
+			if (uniform.updateCache(dataIn, sizeof(int) * countIn))
+				glUniform1iv(uniform.getLocation(), countIn, dataIn);
+		});
+
+	return *this;
+}
+
+
 
 Shader& Shader::setUniformFloat1(const std::string& nameIn, float dataIn)
 {
-	setUniform<float>(nameIn, Uniform::Type::Float1, dataIn, 1, [this](float dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformFloat1(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformFloat1(UniformHandle handleIn, float dataIn)
+{
+	setUniform<float>(handleIn, Uniform::Type::Float1, dataIn, 1, [](float dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			float params;
-			glGetUniformfv(m_id, uniform.getLocation(), &params);
-			if (params != dataIn)
+			if (uniform.updateCache(&dataIn, sizeof(dataIn)))
 				glUniform1f(uniform.getLocation(), dataIn);
 		});
 
@@ -338,9 +514,17 @@ Shader& Shader::setUniformFloat1(const std::string& nameIn, float dataIn)
 
 Shader& Shader::setUniformFloat2(const std::string& nameIn, const glm::vec2& dataIn)
 {
-	setUniform<glm::vec2>(nameIn, Uniform::Type::Float2, dataIn, 1, [this](glm::vec2 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformFloat2(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformFloat2(UniformHandle handleIn, const glm::vec2& dataIn)
+{
+	setUniform<glm::vec2>(handleIn, Uniform::Type::Float2, dataIn, 1, [](glm::vec2 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform2fv(m_id, 1, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniform2fv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -350,9 +534,17 @@ Shader& Shader::setUniformFloat2(const std::string& nameIn, const glm::vec2& dat
 
 Shader& Shader::setUniformFloat3(const std::string& nameIn, const glm::vec3& dataIn)
 {
-	setUniform<glm::vec3>(nameIn, Uniform::Type::Float3, dataIn, 1, [this](glm::vec3 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformFloat3(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformFloat3(UniformHandle handleIn, const glm::vec3& dataIn)
+{
+	setUniform<glm::vec3>(handleIn, Uniform::Type::Float3, dataIn, 1, [](glm::vec3 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform3fv(m_id, 1, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniform3fv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -362,9 +554,17 @@ Shader& Shader::setUniformFloat3(const std::string& nameIn, const glm::vec3& dat
 
 Shader& Shader::setUniformFloat4(const std::string& nameIn, const glm::vec4& dataIn)
 {
-	setUniform<glm::vec4>(nameIn, Uniform::Type::Float4, dataIn, 1, [this](glm::vec4 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformFloat4(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformFloat4(UniformHandle handleIn, const glm::vec4& dataIn)
+{
+	setUniform<glm::vec4>(handleIn, Uniform::Type::Float4, dataIn, 1, [](glm::vec4 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniform4fv(m_id, 1, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniform4fv(uniform.getLocation(), 1, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -374,9 +574,17 @@ Shader& Shader::setUniformFloat4(const std::string& nameIn, const glm::vec4& dat
 
 Shader& Shader::setUniformMat3(const std::string& nameIn, const glm::mat3& dataIn)
 {
-	setUniform<glm::mat3>(nameIn, Uniform::Type::Mat3, dataIn, 1, [this](glm::mat3 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformMat3(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformMat3(UniformHandle handleIn, const glm::mat3& dataIn)
+{
+	setUniform<glm::mat3>(handleIn, Uniform::Type::Mat3, dataIn, 1, [](glm::mat3 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniformMatrix3fv(uniform.getLocation(), 1, GL_FALSE, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniformMatrix3fv(uniform.getLocation(), 1, GL_FALSE, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -386,9 +594,17 @@ Shader& Shader::setUniformMat3(const std::string& nameIn, const glm::mat3& dataI
 
 Shader& Shader::setUniformMat4(const std::string& nameIn, const glm::mat4& dataIn)
 {
-	setUniform<glm::mat4>(nameIn, Uniform::Type::Mat4, dataIn, 1, [this](glm::mat4 dataIn, unsigned int countIn, const Uniform& uniform)
+	return setUniformMat4(getUniformHandle(nameIn), dataIn);
+}
+
+
+
+Shader& Shader::setUniformMat4(UniformHandle handleIn, const glm::mat4& dataIn)
+{
+	setUniform<glm::mat4>(handleIn, Uniform::Type::Mat4, dataIn, 1, [](glm::mat4 dataIn, unsigned int countIn, Uniform& uniform)
 		{
-			glUniformMatrix4fv(uniform.getLocation(), 1, GL_FALSE, glm::value_ptr(dataIn));
+			if (uniform.updateCache(glm::value_ptr(dataIn), sizeof(dataIn)))
+				glUniformMatrix4fv(uniform.getLocation(), 1, GL_FALSE, glm::value_ptr(dataIn));
 		});
 
 	return *this;
@@ -401,6 +617,17 @@ bool Shader::validate() const
 	glValidateProgram(m_id);
 	int isValid;
 	glGetProgramiv(m_id, GL_VALIDATE_STATUS, &isValid);
+	if (isValid != GL_TRUE)
+	{
+		int maxLength = 0;
+		glGetProgramiv(m_id, GL_INFO_LOG_LENGTH, &maxLength);
+		if (maxLength > 0)
+		{
+			std::vector<char> infoLog(maxLength);
+			glGetProgramInfoLog(m_id, maxLength, &maxLength, &infoLog[0]);
+			m_logger->error("Shader program '{0}' failed validation! {1}", m_id, infoLog.data());
+		}
+	}
 	return isValid == GL_TRUE;
 }
 
@@ -437,14 +664,21 @@ void Shader::buildUniforms()
 		}
 		else
 		{
+			// Members of uniform blocks, such as the FrameData block, have no location and are set through their buffer instead
+			const GLuint index = static_cast<GLuint>(i);
+			GLint blockIndex = -1;
+			glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+			if (blockIndex != -1)
+				continue;
+
 			int location = glGetUniformLocation(m_id, name);
 			if (location == -1) 
 			{
 				m_logger->error("Error getting the location for Uniform '{0}' it is either unused, invalid, or misspelled", name, glGetError());
 				__debugbreak();
 			}
+			m_uniformsLookup.insert({ name, static_cast<unsigned int>(m_uniforms.size()) });
 			m_uniforms.emplace_back(name, getUniformTypeFromGL(type, size), size, location, m_id);
-			m_uniformsLookup.insert({ name, i });
 		}
 	}
 }
@@ -458,6 +692,18 @@ Shader::Uniform::Uniform(const std::string& nameIn, Type typeIn, int sizeIn, int
 
 
 
+bool Shader::Uniform::updateCache(const void* dataIn, size_t sizeIn)
+{
+	if (m_cache.size() == sizeIn && std::memcmp(m_cache.data(), dataIn, sizeIn) == 0)
+		return false;
+
+	const unsigned char* data = static_cast<const unsigned char*>(dataIn);
+	m_cache.assign(data, data + sizeIn);
+	return true;
+}
+
+
+
 unsigned int Shader::get_glShaderType(Type type)
 {
 	switch (type) 
@@ -526,6 +772,12 @@ std::string Shader::Uniform::uniformTypeToString(Type typeIn)
 	case Type::Sampler2D1Array:
 		return std::string("Sampler2D1Array");
 
+	case Type::Sampler2DArray:
+		return std::string("Sampler2DArray");
+
+	case Type::Sampler2DArray1Array:
+		return std::string("Sampler2DArray1Array");
+
 	case Type::Invalid:
 	default:
 		return std::string("Invalid");
@@ -580,6 +832,12 @@ Shader::Uniform::Type Shader::getUniformTypeFromGL(unsigned int typeIn, int size
 		else
 			return Shader::Uniform::Type::Sampler2D1Array;
 
+	case GL_SAMPLER_2D_ARRAY:
+		if (sizeIn == 1)
+			return Shader::Uniform::Type::Sampler2DArray;
+		else
+			return Shader::Uniform::Type::Sampler2DArray1Array;
+
 	default:
 		Loggers::getLog()->error("Invalid shader uniform type!");
 		__debugbreak();
@@ -10,6 +10,7 @@
 #include <glm/glm.hpp>
 
 #include "utilities/Loggers.hpp"
+#include "utilities/Assertions.h"
 
 
 
@@ -47,7 +48,9 @@ public:
 			Mat3,
 			Mat4,
 			Sampler2D,
-			Sampler2D1Array
+			Sampler2D1Array,
+			Sampler2DArray,
+			Sampler2DArray1Array
 		};
 
 
@@ -98,6 +101,17 @@ public:
 
 
 
+		/// <summary>
+		/// Compares the given data with the last data that was sent to this uniform and keeps a copy of it
+		/// <para>This replaces reading the uniform back from the driver, which can stall the pipeline</para>
+		/// </summary>
+		/// <param name="dataIn">Specifies the data that is about to be sent</param>
+		/// <param name="sizeIn">Specifies the size of the data, measured in bytes</param>
+		/// <returns>True if the data has changed and must be sent to the shader</returns>
+		bool updateCache(const void* dataIn, size_t sizeIn);
+
+
+
 	private:
 
 		std::string m_name;
@@ -107,6 +121,50 @@ public:
 		int m_size, m_location;
 
 		unsigned int m_program;
+
+		/// <summary>
+		/// A copy of the last data that was sent to this uniform, empty until data is first sent
+		/// </summary>
+		std::vector<unsigned char> m_cache;
+	};
+
+
+
+	/// <summary>
+	/// A pre-resolved reference to one of this shader's uniforms, which lets data be sent without looking the uniform up by name
+	/// <para>A handle is only valid for the shader that it was gotten from</para>
+	/// </summary>
+	class UniformHandle
+	{
+	public:
+
+		UniformHandle() = default;
+
+
+
+		explicit UniformHandle(int indexIn) : m_index(indexIn) {}
+
+
+
+		/// <summary>
+		/// Checks if this handle refers to a uniform
+		/// </summary>
+		/// <returns></returns>
+		bool isValid() const { return m_index >= 0; }
+
+
+
+		/// <summary>
+		/// Gets the index of the uniform in its shader's uniform list
+		/// </summary>
+		/// <returns></returns>
+		int index() const { return m_index; }
+
+
+
+	private:
+
+		int m_index = -1;
 	};
 	
 
@@ -132,7 +190,8 @@ public:
 	/// </summary>
 	/// <param name="vertexFilepath">Specifies the file path of the vertex shader file</param>
 	/// <param name="pixelFilepath">Specifies the file path of the pixel shader file</param>
-	void create(const std::filesystem::path& vertexFilepath, const std::filesystem::path& pixelFilepath);
+	/// <param name="cacheIn">Specifies where linked programs are cached, the sources are always compiled when it is null</param>
+	void create(const std::filesystem::path& vertexFilepath, const std::filesystem::path& pixelFilepath, class AssetCache* cacheIn = nullptr);
 
 
 
@@ -141,7 +200,8 @@ public:
 	/// </summary>
 	/// <param name="vertexSrc">Specifies the vertex shader sorce string</param>
 	/// <param name="pixelSrc">Specifies the pixel shader sorce string</param>
-	void createFromString(const std::string& vertexSrc, const std::string& pixelSrc);
+	/// <param name="cacheIn">Specifies where linked programs are cached, the sources are always compiled when it is null</param>
+	void createFromString(const std::string& vertexSrc, const std::string& pixelSrc, class AssetCache* cacheIn = nullptr);
 
 
 
@@ -164,6 +224,25 @@ public:
 
 
 
+	/// <summary>
+	/// Resolves the specified uniform into a handle that can be used to send data to it without a name lookup
+	/// </summary>
+	/// <param name="nameIn">Specifies the shader uniform's variable name</param>
+	/// <returns>The uniform's handle, which is invalid if the uniform is not present</returns>
+	UniformHandle getUniformHandle(const std::string& nameIn) const;
+
+
+
+	/// <summary>
+	/// Connects the specified uniform block to a uniform buffer binding point
+	/// </summary>
+	/// <param name="blockNameIn">Specifies the uniform block's name</param>
+	/// <param name="bindingIn">Specifies the binding point</param>
+	/// <returns>True if the uniform block is part of this shader</returns>
+	bool bindUniformBlock(const std::string& blockNameIn, unsigned int bindingIn);
+
+
+
 	/// <summary>
 	/// Gets all of this shader's uniforms
 	/// </summary>
@@ -190,6 +269,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends boolean data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the boolean data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformBool1(UniformHandle handleIn, bool dataIn);
+
+
+
 	/// <summary>
 	/// Sends integer data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -200,6 +289,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends integer data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the integer data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformInt1(UniformHandle handleIn, int dataIn);
+
+
+
 	/// <summary>
 	/// Sends an array of integer data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -211,6 +310,17 @@ public:
 
 
 
+	/// <summary>
+	/// Sends an array of integer data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the integer data that is to be sent</param>
+	/// <param name="countIn">Specifies the number of integer elements in the array</param>
+	/// <returns></returns>
+	Shader& setUniformInt1(UniformHandle handleIn, int* dataIn, unsigned int countIn);
+
+
+
 	/// <summary>
 	/// Sends vector integer data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -221,6 +331,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends vector integer data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the vector integer data that is to be sent</param>
+	/// <returns></returns>
+	Shader& setUniformInt2(UniformHandle handleIn, const glm::ivec2& dataIn);
+
+
+
 	/// <summary>
 	/// Sends vector integer data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -231,6 +351,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends vector integer data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the vector integer data that is to be sent</param>
+	/// <returns></returns>
+	Shader& setUniformInt3(UniformHandle handleIn, const glm::ivec3& dataIn);
+
+
+
 	/// <summary>
 	/// Sends vector integer data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -241,6 +371,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends vector integer data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the vector integer data that is to be sent</param>
+	/// <returns></returns>
+	Shader& setUniformInt4(UniformHandle handleIn, const glm::ivec4& dataIn);
+
+
+
 	/// <summary>
 	/// Sends 2D texture slot data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -251,6 +391,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends 2D texture slot data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the 2D texture slot data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformSampler2D(UniformHandle handleIn, int dataIn);
+
+
+
 	/// <summary>
 	/// Sends an array of Sampler2D data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -262,6 +412,39 @@ public:
 
 
 
+	/// <summary>
+	/// Sends an array of Sampler2D data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the Sampler2D data that is to be sent</param>
+	/// <param name="countIn">Specifies the number of Sampler2D elements in the array</param>
+	/// <returns></returns>
+	Shader& setUniformSampler2D(UniformHandle handleIn, int* dataIn, unsigned int countIn);
+
+
+
+	/// <summary>
+	/// Sends an array of Sampler2DArray data to the specified shader uniform variable if it's present
+	/// </summary>
+	/// <param name="nameIn">Specifies the shader uniform variable name</param>
+	/// <param name="dataIn">Specifies the Sampler2DArray data that is to be sent</param>
+	/// <param name="countIn">Specifies the number of Sampler2DArray elements in the array</param>
+	/// <returns></returns>
+	Shader& setUniformSampler2DArray(const std::string& nameIn, int* dataIn, unsigned int countIn);
+
+
+
+	/// <summary>
+	/// Sends an array of Sampler2DArray data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the Sampler2DArray data that is to be sent</param>
+	/// <param name="countIn">Specifies the number of Sampler2DArray elements in the array</param>
+	/// <returns></returns>
+	Shader& setUniformSampler2DArray(UniformHandle handleIn, int* dataIn, unsigned int countIn);
+
+
+
 	/// <summary>
 	/// Sends floating point data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -272,6 +455,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends floating point data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the floating point data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformFloat1(UniformHandle handleIn, float dataIn);
+
+
+
 	/// <summary>
 	/// Sends vector floating point data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -282,6 +475,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends vector floating point data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the vector floating point data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformFloat2(UniformHandle handleIn, const glm::vec2& dataIn);
+
+
+
 	/// <summary>
 	/// Sends vector floating point data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -292,6 +495,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends vector floating point data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the vector floating point data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformFloat3(UniformHandle handleIn, const glm::vec3& dataIn);
+
+
+
 	/// <summary>
 	/// Sends vector floating point data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -302,6 +515,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends vector floating point data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the vector floating point data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformFloat4(UniformHandle handleIn, const glm::vec4& dataIn);
+
+
+
 	/// <summary>
 	/// Sends matrix floating point data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -312,6 +535,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends matrix floating point data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the matrix floating point data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformMat3(UniformHandle handleIn, const glm::mat3& dataIn);
+
+
+
 	/// <summary>
 	/// Sends matrix floating point data to the specified shader uniform variable if it's present
 	/// </summary>
@@ -322,6 +555,16 @@ public:
 
 
 
+	/// <summary>
+	/// Sends matrix floating point data to the specified shader uniform variable if the handle is valid
+	/// </summary>
+	/// <param name="handleIn">Specifies the shader uniform's handle, from Shader::getUniformHandle</param>
+	/// <param name="dataIn">Specifies the matrix floating point data that is to be sent</param>
+	/// <returns>A referance to this shader</returns>
+	Shader& setUniformMat4(UniformHandle handleIn, const glm::mat4& dataIn);
+
+
+
 	/// <summary>
 	/// Gets the number of shader unifroms that are being used by this shader
 	/// </summary>
@@ -386,8 +629,40 @@ private:
 	/// </summary>
 	/// <param name="vertexShaderID">Specifies the ID of the vertex shader to be linked</param>
 	/// <param name="pixelShaderID">Specifies the ID of the vertex pixel to be linked</param>
+	/// <param name="retrievableIn">Specifies if the linked program's binary will be read back</param>
 	/// <returns>The ID of the new shader program or 0 on error</returns>
-	static unsigned int link(unsigned int vertexShaderID, unsigned int pixelShaderID);
+	static unsigned int link(unsigned int vertexShaderID, unsigned int pixelShaderID, bool retrievableIn = false);
+
+
+
+	/// <summary>
+	/// Gets the key of a linked program in the asset cache
+	/// <para>Program binaries only work with the driver that made them, so the driver is part of the key</para>
+	/// </summary>
+	/// <param name="vertexSrc"></param>
+	/// <param name="pixelSrc"></param>
+	/// <returns></returns>
+	static uint64_t getProgramKey(const std::string& vertexSrc, const std::string& pixelSrc);
+
+
+
+	/// <summary>
+	/// Creates a shader program from a binary in the asset cache
+	/// </summary>
+	/// <param name="cacheIn"></param>
+	/// <param name="keyIn"></param>
+	/// <returns>The ID of the new shader program or 0 if the binary is not cached or was rejected by the driver</returns>
+	static unsigned int loadProgram(class AssetCache& cacheIn, uint64_t keyIn);
+
+
+
+	/// <summary>
+	/// Stores a linked shader program's binary in the asset cache
+	/// </summary>
+	/// <param name="cacheIn"></param>
+	/// <param name="keyIn"></param>
+	/// <param name="programIDIn"></param>
+	static void storeProgram(class AssetCache& cacheIn, uint64_t keyIn, unsigned int programIDIn);
 
 
 
@@ -421,27 +696,25 @@ private:
 	/// 
 	/// </summary>
 	/// <typeparam name="T"></typeparam>
-	/// <param name="nameIn"></param>
+	/// <param name="handleIn"></param>
 	/// <param name="typeIn"></param>
 	/// <param name="dataIn"></param>
 	/// <param name="countIn"></param>
 	/// <param name="function"></param>
 	template<typename T>
-	void setUniform(const std::string& nameIn, Uniform::Type typeIn, T dataIn, unsigned int countIn, std::function<void(T dataIn, unsigned int countIn, const Uniform& uniform)> function)
+	void setUniform(UniformHandle handleIn, Uniform::Type typeIn, T dataIn, unsigned int countIn, std::function<void(T dataIn, unsigned int countIn, Uniform& uniform)> function)
 	{
-		if (m_uniformsLookup.find(nameIn) == m_uniformsLookup.end())
-		{
-			m_logger->warn("Uniform '{0}' is either unused, invalid, or misspelled", nameIn);
+		if (!handleIn.isValid())
 			return;
-		}
 
-		unsigned int i = m_uniformsLookup[nameIn];
-		if (m_uniforms[i].getType() == typeIn)
+		GAME_ASSERT(handleIn.index() < static_cast<int>(m_uniforms.size()));
+		Uniform& uniform = m_uniforms[handleIn.index()];
+		if (uniform.getType() == typeIn)
 		{
-			function(dataIn, countIn, m_uniforms[i]);
+			function(dataIn, countIn, uniform);
 		}
 		else
-			m_logger->warn("Tried to submit data of type '{0}' to uniform '{1}', which is of type '{2}'", Uniform::uniformTypeToString(typeIn), nameIn, Uniform::uniformTypeToString(m_uniforms[i].getType()));
+			m_logger->warn("Tried to submit data of type '{0}' to uniform '{1}', which is of type '{2}'", Uniform::uniformTypeToString(typeIn), uniform.getName(), Uniform::uniformTypeToString(uniform.getType()));
 	}
 
 
@@ -0,0 +1,76 @@
+#include "renderer/texture/BindlessTexture.h"
+#include "renderer/RendererFondation.h"
+#include "utilities/Loggers.hpp"
+
+
+
+
+typedef GLuint64 (APIENTRYP PFN_GetTextureHandle)(GLuint texture);
+typedef void (APIENTRYP PFN_MakeTextureHandleResident)(GLuint64 handle);
+typedef void (APIENTRYP PFN_MakeTextureHandleNonResident)(GLuint64 handle);
+
+static PFN_GetTextureHandle s_getTextureHandle = nullptr;
+static PFN_MakeTextureHandleResident s_makeTextureHandleResident = nullptr;
+static PFN_MakeTextureHandleNonResident s_makeTextureHandleNonResident = nullptr;
+
+static bool s_isSupported = false;
+
+
+
+bool BindlessTexture::load()
+{
+	if (s_isSupported)
+		return true;
+
+	if (SDL_GL_ExtensionSupported("GL_ARB_bindless_texture") != SDL_TRUE)
+	{
+		Loggers::getLog()->info("Bindless textures are not supported by this driver");
+		return false;
+	}
+
+	s_getTextureHandle = reinterpret_cast<PFN_GetTextureHandle>(SDL_GL_GetProcAddress("glGetTextureHandleARB"));
+	s_makeTextureHandleResident = reinterpret_cast<PFN_MakeTextureHandleResident>(SDL_GL_GetProcAddress("glMakeTextureHandleResidentARB"));
+	s_makeTextureHandleNonResident = reinterpret_cast<PFN_MakeTextureHandleNonResident>(SDL_GL_GetProcAddress("glMakeTextureHandleNonResidentARB"));
+
+	s_isSupported = s_getTextureHandle && s_makeTextureHandleResident && s_makeTextureHandleNonResident;
+	if (s_isSupported)
+		Loggers::getLog()->info("Bindless textures are supported");
+	else
+		Loggers::getLog()->warn("Bindless textures are advertised but their functions could not be loaded");
+
+	return s_isSupported;
+}
+
+
+
+bool BindlessTexture::isSupported()
+{
+	return s_isSupported;
+}
+
+
+
+uint64_t BindlessTexture::getHandle(unsigned int textureIn)
+{
+	GAME_ASSERT(s_isSupported);
+	return s_getTextureHandle(textureIn);
+}
+
+
+
+void BindlessTexture::makeResident(uint64_t handleIn)
+{
+	GAME_ASSERT(s_isSupported);
+	s_makeTextureHandleResident(handleIn);
+}
+
+
+
+void BindlessTexture::makeNonResident(uint64_t handleIn)
+{
+	GAME_ASSERT(s_isSupported);
+	s_makeTextureHandleNonResident(handleIn);
+}
+
+
+
@@ -0,0 +1,68 @@
+#ifndef BindlessTexture_H_
+#define BindlessTexture_H_
+
+#include <cstdint>
+
+
+
+
+/// <summary>
+/// Loads and wraps the ARB_bindless_texture entry points, which are not part of the core profile that glad was generated for
+/// <para>
+/// Every method other than BindlessTexture::load and BindlessTexture::isSupported must only be called when the extension is supported
+/// </para>
+/// </summary>
+class BindlessTexture
+{
+public:
+
+	BindlessTexture() = delete;
+
+
+
+	/// <summary>
+	/// Looks up the extension's entry points, must be called after the OpenGL context has been made current
+	/// </summary>
+	/// <returns>True if the driver supports bindless textures</returns>
+	static bool load();
+
+
+
+	/// <summary>
+	/// Checks if the driver supports bindless textures
+	/// </summary>
+	/// <returns></returns>
+	static bool isSupported();
+
+
+
+	/// <summary>
+	/// Gets the bindless handle of the given texture
+	/// <para>Once a handle has been made, the texture's storage and parameters cannot be changed</para>
+	/// </summary>
+	/// <param name="textureIn">Specifies the OpenGL texture identifier</param>
+	/// <returns></returns>
+	static uint64_t getHandle(unsigned int textureIn);
+
+
+
+	/// <summary>
+	/// Makes the given handle resident so that it can be read by shaders
+	/// </summary>
+	/// <param name="handleIn"></param>
+	static void makeResident(uint64_t handleIn);
+
+
+
+	/// <summary>
+	/// Makes the given handle non-resident, which must be done before its texture is deleted
+	/// </summary>
+	/// <param name="handleIn"></param>
+	static void makeNonResident(uint64_t handleIn);
+};
+
+
+#endif /* BindlessTexture_H_ */
+
+
+
@@ -0,0 +1,93 @@
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <stb_image/stb_image.h>
+
+#include "renderer/texture/Image.h"
+
+
+
+
+Image::Image(unsigned int widthIn, unsigned int heightIn, unsigned int channelsIn)
+	: m_width(widthIn), m_height(heightIn), m_channels(channelsIn)
+{
+	// Allocated the same way as stb_image so every image is freed by the same deleter
+	const size_t size = static_cast<size_t>(m_width) * m_height * m_channels;
+	m_pixels.reset(static_cast<unsigned char*>(std::malloc(size)));
+	if (m_pixels)
+		std::memset(m_pixels.get(), 0, size);
+	m_levels.push_back({ 0, size, m_width, m_height });
+}
+
+
+
+Image Image::load(const std::filesystem::path& filepathIn)
+{
+	// The flip setting is per thread, so decoding on several threads at once does not race on it
+	stbi_set_flip_vertically_on_load_thread(1);
+
+	Image image;
+	if (TextureFile::isCooked(filepathIn))
+	{
+		// Cooked textures are already in the layout they are uploaded in
+		TextureFileHeader header;
+		std::vector<TextureFileLevel> levels;
+		unsigned char* data = nullptr;
+		std::string error;
+		if (!TextureFile::read(filepathIn, header, levels, data, error))
+			return image;
+
+		image.m_pixels.reset(data);
+		image.m_width = header.width;
+		image.m_height = header.height;
+		image.m_channels = 4;
+		image.m_format = static_cast<TextureFile::Format>(header.format);
+		for (unsigned int i = 0; i < header.numberOfLevels; i++)
+		{
+			image.m_levels.push_back({ static_cast<size_t>(levels[i].offset), static_cast<size_t>(levels[i].size), 
+				std::max(header.width >> i, 1u), std::max(header.height >> i, 1u) });
+		}
+		return image;
+	}
+
+	int width = 0, height = 0, channels = 0;
+	image.m_pixels.reset(stbi_load(filepathIn.string().c_str(), &width, &height, &channels, 0));
+	if (image.m_pixels)
+	{
+		image.m_width = width;
+		image.m_height = height;
+		image.m_channels = channels;
+		image.m_levels.push_back({ 0, static_cast<size_t>(width) * height * channels, image.m_width, image.m_height });
+	}
+	return image;
+}
+
+
+
+Image Image::decode(const unsigned char* dataIn, size_t sizeIn)
+{
+	stbi_set_flip_vertically_on_load_thread(1);
+
+	Image image;
+	int width = 0, height = 0, channels = 0;
+	image.m_pixels.reset(stbi_load_from_memory(dataIn, static_cast<int>(sizeIn), &width, &height, &channels, 0));
+	if (image.m_pixels)
+	{
+		image.m_width = width;
+		image.m_height = height;
+		image.m_channels = channels;
+		image.m_levels.push_back({ 0, static_cast<size_t>(width) * height * channels, image.m_width, image.m_height });
+	}
+	return image;
+}
+
+
+
+void Image::Deleter::operator()(unsigned char* pixelsIn) const
+{
+	stbi_image_free(pixelsIn);
+}
+
+
+
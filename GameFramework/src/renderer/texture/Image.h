@@ -0,0 +1,163 @@
+#ifndef Image_H_
+#define Image_H_
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "renderer/texture/TextureFile.h"
+
+
+
+
+/// <summary>
+/// Decoded pixels in CPU memory, 8 bits per channel with the bottom row first as OpenGL expects
+/// <para>
+/// Images that are loaded from a cooked texture can instead hold a whole mip chain, either as RGBA or block compressed. 
+/// Images do not touch OpenGL, so they can be decoded on any thread and uploaded later
+/// </para>
+/// </summary>
+class Image
+{
+public:
+
+	Image() = default;
+
+
+
+	/// <summary>
+	/// Creates a new image whose pixels are all zero
+	/// </summary>
+	/// <param name="widthIn"></param>
+	/// <param name="heightIn"></param>
+	/// <param name="channelsIn">Specifies the number of 8 bit channels in each pixel</param>
+	Image(unsigned int widthIn, unsigned int heightIn, unsigned int channelsIn);
+
+
+
+	Image(const Image& other) = delete;
+
+
+
+	Image(Image&& other) noexcept = default;
+
+
+
+	Image& operator=(Image&& other) noexcept = default;
+
+
+
+	/// <summary>
+	/// Where one mip level is in an image's data
+	/// </summary>
+	struct Level
+	{
+		size_t offset;
+
+		size_t size;
+
+		unsigned int width;
+
+		unsigned int height;
+	};
+
+
+
+	/// <summary>
+	/// Decodes the given image file, or reads it as it is if it is a cooked texture, this is safe to call from any thread
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <returns>The decoded image, which is empty if the file could not be decoded</returns>
+	static Image load(const std::filesystem::path& filepathIn);
+
+
+
+	/// <summary>
+	/// Decodes an image file that has already been read into memory, this is safe to call from any thread
+	/// </summary>
+	/// <param name="dataIn">Specifies the contents of an image file</param>
+	/// <param name="sizeIn"></param>
+	/// <returns>The decoded image, which is empty if the data could not be decoded</returns>
+	static Image decode(const unsigned char* dataIn, size_t sizeIn);
+
+
+
+	/// <summary>
+	/// Checks if this image holds any pixels
+	/// </summary>
+	/// <returns></returns>
+	bool isValid() const { return m_pixels != nullptr; }
+
+
+
+	unsigned int width() const { return m_width; }
+
+
+
+	unsigned int height() const { return m_height; }
+
+
+
+	unsigned int channels() const { return m_channels; }
+
+
+
+	/// <summary>
+	/// Gets how the texels are stored, every uncompressed image is RGBA8 whatever its number of channels
+	/// </summary>
+	/// <returns></returns>
+	TextureFile::Format format() const { return m_format; }
+
+
+
+	/// <summary>
+	/// Checks if this image holds block compressed texels
+	/// </summary>
+	/// <returns></returns>
+	bool isCompressed() const { return TextureFile::isCompressed(m_format); }
+
+
+
+	unsigned int numberOfLevels() const { return static_cast<unsigned int>(m_levels.size()); }
+
+
+
+	const Level& level(unsigned int indexIn) const { return m_levels[indexIn]; }
+
+
+
+	unsigned char* data() { return m_pixels.get(); }
+
+
+
+	const unsigned char* data() const { return m_pixels.get(); }
+
+
+
+private:
+
+	struct Deleter
+	{
+		void operator()(unsigned char* pixelsIn) const;
+	};
+
+
+
+	std::unique_ptr<unsigned char, Deleter> m_pixels;
+
+	unsigned int m_width = 0;
+
+	unsigned int m_height = 0;
+
+	unsigned int m_channels = 0;
+
+	TextureFile::Format m_format = TextureFile::Format::RGBA8;
+
+	std::vector<Level> m_levels;
+};
+
+
+#endif /* Image_H_ */
+
+
+
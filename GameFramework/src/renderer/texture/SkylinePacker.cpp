@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <limits>
+
+#include "renderer/texture/SkylinePacker.h"
+
+
+
+
+SkylinePacker::SkylinePacker(unsigned int widthIn, unsigned int heightIn)
+	: m_width(widthIn), m_height(heightIn)
+{
+	clear();
+}
+
+
+
+bool SkylinePacker::insert(unsigned int widthIn, unsigned int heightIn, glm::uvec2& positionOut)
+{
+	if (widthIn == 0 || heightIn == 0)
+		return false;
+
+	// Bottom-left: the lowest top edge wins, ties go to the narrowest segment so wide gaps are kept for wide rectangles
+	size_t best = m_skyline.size();
+	unsigned int bestTop = std::numeric_limits<unsigned int>::max();
+	unsigned int bestWidth = std::numeric_limits<unsigned int>::max();
+	unsigned int bestY = 0;
+	for (size_t i = 0; i < m_skyline.size(); i++)
+	{
+		unsigned int y = 0;
+		if (!fits(i, widthIn, heightIn, y))
+			continue;
+
+		const unsigned int top = y + heightIn;
+		if (top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth))
+		{
+			best = i;
+			bestTop = top;
+			bestWidth = m_skyline[i].width;
+			bestY = y;
+		}
+	}
+
+	if (best == m_skyline.size())
+		return false;
+
+	const Segment placed = { m_skyline[best].x, bestY + heightIn, widthIn };
+	m_skyline.insert(m_skyline.begin() + best, placed);
+
+	// The segments now under the placed rectangle are cut back or removed
+	const unsigned int right = placed.x + placed.width;
+	for (size_t i = best + 1; i < m_skyline.size();)
+	{
+		Segment& segment = m_skyline[i];
+		if (segment.x >= right)
+			break;
+
+		const unsigned int segmentRight = segment.x + segment.width;
+		if (segmentRight <= right)
+		{
+			m_skyline.erase(m_skyline.begin() + i);
+			continue;
+		}
+
+		segment.width = segmentRight - right;
+		segment.x = right;
+		break;
+	}
+
+	// Neighbours at the same height are joined so the skyline stays short
+	for (size_t i = 0; i + 1 < m_skyline.size();)
+	{
+		if (m_skyline[i].y == m_skyline[i + 1].y)
+		{
+			m_skyline[i].width += m_skyline[i + 1].width;
+			m_skyline.erase(m_skyline.begin() + i + 1);
+		}
+		else
+			i++;
+	}
+
+	m_usedArea += static_cast<uint64_t>(widthIn) * heightIn;
+	positionOut = { placed.x, bestY };
+	return true;
+}
+
+
+
+void SkylinePacker::clear()
+{
+	m_skyline.clear();
+	m_skyline.push_back({ 0, 0, m_width });
+	m_usedArea = 0;
+}
+
+
+
+float SkylinePacker::occupancy() const
+{
+	const uint64_t area = static_cast<uint64_t>(m_width) * m_height;
+	return area > 0 ? static_cast<float>(static_cast<double>(m_usedArea) / area) : 0.0f;
+}
+
+
+
+bool SkylinePacker::fits(size_t indexIn, unsigned int widthIn, unsigned int heightIn, unsigned int& yOut) const
+{
+	const unsigned int x = m_skyline[indexIn].x;
+	if (x + widthIn > m_width)
+		return false;
+
+	// The rectangle rests on the highest segment that it spans
+	unsigned int y = 0;
+	unsigned int widthLeft = widthIn;
+	for (size_t i = indexIn; widthLeft > 0; i++)
+	{
+		if (i == m_skyline.size())
+			return false;
+
+		y = std::max(y, m_skyline[i].y);
+		if (y + heightIn > m_height)
+			return false;
+
+		widthLeft -= std::min(widthLeft, m_skyline[i].width);
+	}
+
+	yOut = y;
+	return true;
+}
+
+
+
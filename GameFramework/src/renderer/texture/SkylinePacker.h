@@ -0,0 +1,107 @@
+#ifndef SkylinePacker_H_
+#define SkylinePacker_H_
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+
+
+
+/// <summary>
+/// Places rectangles into a fixed size area using the skyline bottom-left heuristic
+/// <para>
+/// The packer only tracks the top edge of the placed rectangles, as a list of horizontal segments, so each insert is linear in
+/// the number of segments. Rectangles are never removed, the whole area is reset instead
+/// </para>
+/// </summary>
+class SkylinePacker
+{
+public:
+
+	/// <summary>
+	/// Creates an empty packer
+	/// </summary>
+	/// <param name="widthIn">Specifies the width of the area, measured in pixels</param>
+	/// <param name="heightIn">Specifies the height of the area, measured in pixels</param>
+	SkylinePacker(unsigned int widthIn, unsigned int heightIn);
+
+
+
+	/// <summary>
+	/// Finds a place for a rectangle, choosing the position that keeps the skyline lowest
+	/// </summary>
+	/// <param name="widthIn"></param>
+	/// <param name="heightIn"></param>
+	/// <param name="positionOut">Filled in with the bottom left corner of the placed rectangle</param>
+	/// <returns>True if the rectangle was placed, false if there is no room left for it</returns>
+	bool insert(unsigned int widthIn, unsigned int heightIn, glm::uvec2& positionOut);
+
+
+
+	/// <summary>
+	/// Removes every rectangle
+	/// </summary>
+	void clear();
+
+
+
+	/// <summary>
+	/// Gets the fraction of the area that is covered by rectangles
+	/// </summary>
+	/// <returns></returns>
+	float occupancy() const;
+
+
+
+	unsigned int width() const { return m_width; }
+
+
+
+	unsigned int height() const { return m_height; }
+
+
+
+private:
+
+	/// <summary>
+	/// A horizontal segment of the skyline, everything below it is either used or wasted
+	/// </summary>
+	struct Segment
+	{
+		unsigned int x;
+
+		unsigned int y;
+
+		unsigned int width;
+	};
+
+
+
+	/// <summary>
+	/// Checks if a rectangle fits with its left edge at the start of the given segment
+	/// </summary>
+	/// <param name="indexIn">Specifies the segment</param>
+	/// <param name="widthIn"></param>
+	/// <param name="heightIn"></param>
+	/// <param name="yOut">Filled in with the lowest height the rectangle can sit at</param>
+	/// <returns></returns>
+	bool fits(size_t indexIn, unsigned int widthIn, unsigned int heightIn, unsigned int& yOut) const;
+
+
+
+	unsigned int m_width;
+
+	unsigned int m_height;
+
+	uint64_t m_usedArea = 0;
+
+	std::vector<Segment> m_skyline;
+};
+
+
+#endif /* SkylinePacker_H_ */
+
+
+
@@ -1,8 +1,7 @@
 #include <string>
 
-#include <stb_image/stb_image.h>
-
 #include "Texture.h"
+#include "renderer/texture/TexturePage.h"
 #include "renderer/RendererFondation.h"
 #include "utilities/Loggers.hpp"
 #include "utilities/Assertions.h"
@@ -10,31 +9,78 @@
 
 
 
+// Block compression from EXT_texture_compression_s3tc, which is not part of the core profile
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+
+
+
 Texture::Texture(const std::filesystem::path& filepath, unsigned int GuidIn)
 	: m_id(0), m_width(0), m_height(0), m_channels(0), m_guid(GuidIn)
 {
-	stbi_set_flip_vertically_on_load(TRUE);
+	Image image = Image::load(filepath);
+	GAME_ASSERT(image.isValid());
+	create(filepath, image);
+}
+
+
+
+Texture::Texture(const std::filesystem::path& filepath, const Image& imageIn, unsigned int GuidIn)
+	: m_id(0), m_width(0), m_height(0), m_channels(0), m_guid(GuidIn)
+{
+	GAME_ASSERT(imageIn.isValid());
+	create(filepath, imageIn);
+}
+
+
+
+Texture::Texture(const std::filesystem::path& filepath, std::shared_ptr<TexturePage> pageIn, const glm::uvec2& positionIn, const glm::uvec2& sizeIn, unsigned int GuidIn)
+	: m_id(pageIn->getNativeID()), m_filepath(filepath), m_page(std::move(pageIn)), m_width(sizeIn.x), m_height(sizeIn.y), m_channels(4), m_guid(GuidIn)
+{
+	const glm::vec2 pageSize(static_cast<float>(m_page->width()), static_cast<float>(m_page->height()));
+	m_region.min = glm::vec2(positionIn) / pageSize;
+	m_region.max = glm::vec2(positionIn + sizeIn) / pageSize;
+}
 
-	int width, height, channels;
-	stbi_uc* imageData = stbi_load(filepath.string().c_str(), &width, &height, &channels, 0);
-	GAME_ASSERT(imageData != nullptr);
 
-	m_width = width;
-	m_height = height;
-	m_channels = channels;
+
+void Texture::create(const std::filesystem::path& filepath, const Image& imageIn)
+{
+	m_width = imageIn.width();
+	m_height = imageIn.height();
+	m_channels = imageIn.channels();
 	m_filepath = filepath;
 
+	// RGB textures are stored as RGBA since drivers pad RGB8 to four bytes per texel anyway
 	GLenum internalformat = 0, format = 0;
-	switch (channels)
+	switch (imageIn.format())
 	{
-	case 3:
-		internalformat = GL_RGB8;
-		format = GL_RGB;
+	case TextureFile::Format::RGBA8:
+		internalformat = GL_RGBA8;
+		format = m_channels == 3 ? GL_RGB : GL_RGBA;
+		if (m_channels != 3 && m_channels != 4)
+		{
+			Loggers::getLog()->critical("Texture '{0}' is in a non-supported image format", filepath.string());
+			__debugbreak();
+		}
 		break;
 
-	case 4:
-		internalformat = GL_RGBA8;
-		format = GL_RGBA;
+	case TextureFile::Format::BC1:
+		internalformat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		break;
+
+	case TextureFile::Format::BC3:
+		internalformat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		break;
+
+	case TextureFile::Format::BC7:
+		internalformat = GL_COMPRESSED_RGBA_BPTC_UNORM;
 		break;
 
 	default:
@@ -43,23 +89,44 @@ Texture::Texture(const std::filesystem::path& filepath, unsigned int GuidIn)
 		break;
 	}
 
+	if ((imageIn.format() == TextureFile::Format::BC1 || imageIn.format() == TextureFile::Format::BC3) 
+		&& SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc") != SDL_TRUE)
+	{
+		Loggers::getLog()->critical("Texture '{0}' is BC1/BC3 compressed, which is not supported by this driver", filepath.string());
+		__debugbreak();
+	}
+
+	const GLsizei levels = static_cast<GLsizei>(imageIn.numberOfLevels());
 	glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
-	glTextureStorage2D(m_id, 1, internalformat, m_width, m_height);
+	glTextureStorage2D(m_id, levels, internalformat, m_width, m_height);
 
 	glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-	glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	// The nearest mip level is used so sprites stay sharp while zoomed out textures are read from smaller levels
+	glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
 	glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTextureParameteri(m_id, GL_TEXTURE_MAX_LEVEL, levels - 1);
 
-	glTextureSubImage2D(m_id, 0, 0, 0, m_width, m_height, format, GL_UNSIGNED_BYTE, imageData);
-	stbi_image_free(imageData);
+	// Rows of RGB images are not always 4 byte aligned
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (GLsizei i = 0; i < levels; i++)
+	{
+		const Image::Level& level = imageIn.level(i);
+		const unsigned char* data = imageIn.data() + level.offset;
+		if (imageIn.isCompressed())
+			glCompressedTextureSubImage2D(m_id, i, 0, 0, level.width, level.height, internalformat, static_cast<GLsizei>(level.size), data);
+		else
+			glTextureSubImage2D(m_id, i, 0, 0, level.width, level.height, format, GL_UNSIGNED_BYTE, data);
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 }
 
 
 
 Texture::Texture(Texture&& other) noexcept
-	: m_id(other.m_id), m_filepath(other.m_filepath), m_width(other.m_width), m_height(other.m_height), m_channels(other.m_channels), m_guid(other.m_guid)
+	: m_id(other.m_id), m_filepath(other.m_filepath), m_region(other.m_region), m_page(std::move(other.m_page)), m_width(other.m_width), m_height(other.m_height), 
+	m_channels(other.m_channels), m_guid(other.m_guid)
 {
 	other.m_id = 0;
 	other.m_filepath.clear();
@@ -96,8 +163,7 @@ void Texture::unbind() const
 
 SubTexture Texture::getSubTexture(unsigned int spriteIndex) const
 {
-	SubTexture sprite = { { 0.0f, 0.0f }, { 1.0f, 1.0f } };
-	return sprite;
+	return m_region;
 }
 
 
@@ -120,7 +186,10 @@ void Texture::destroy()
 {
 	if (!m_movedOrDestroyed)
 	{
-		glDeleteTextures(1, &m_id);
+		// A packed texture's OpenGL texture belongs to its page
+		if (!m_page)
+			glDeleteTextures(1, &m_id);
+		m_page.reset();
 		m_id = 0;
 		m_filepath.clear();
 		m_width = 0;
@@ -2,9 +2,12 @@
 #define Texture_H_
 
 #include <filesystem>
+#include <memory>
 
 #include <glm/glm.hpp>
 
+#include "renderer/texture/Image.h"
+
 
 
 
@@ -33,6 +36,28 @@ public:
 
 
 
+	/// <summary>
+	/// Creates a texture from an image that has already been decoded
+	/// </summary>
+	/// <param name="filepath">Specifies where the image was decoded from</param>
+	/// <param name="imageIn"></param>
+	/// <param name="GuidIn"></param>
+	Texture(const std::filesystem::path& filepath, const Image& imageIn, unsigned int GuidIn);
+
+
+
+	/// <summary>
+	/// Creates a texture that is a region of a texture page, the image must already have been added to the page
+	/// </summary>
+	/// <param name="filepath">Specifies where the image was decoded from</param>
+	/// <param name="pageIn">Specifies the page that holds the image</param>
+	/// <param name="positionIn">Specifies the bottom left corner of the image in the page</param>
+	/// <param name="sizeIn">Specifies the size of the image</param>
+	/// <param name="GuidIn"></param>
+	Texture(const std::filesystem::path& filepath, std::shared_ptr<class TexturePage> pageIn, const glm::uvec2& positionIn, const glm::uvec2& sizeIn, unsigned int GuidIn);
+
+
+
 	Texture(const Texture& other) = delete;
 
 
@@ -109,6 +134,14 @@ public:
 
 
 
+	/// <summary>
+	/// Checks if this texture is a region of a shared texture page
+	/// </summary>
+	/// <returns></returns>
+	bool isPacked() const { return m_page != nullptr; }
+
+
+
 	int getSlot() const { return m_slot; }
 
 
@@ -117,8 +150,25 @@ public:
 
 
 
+	/// <summary>
+	/// Gets this texture's OpenGL identifier
+	/// </summary>
+	/// <returns></returns>
+	unsigned int getNativeID() const { return m_id; }
+
+
+
 protected:
 
+	/// <summary>
+	/// Uploads the given image into a new OpenGL texture
+	/// </summary>
+	/// <param name="filepath"></param>
+	/// <param name="imageIn"></param>
+	void create(const std::filesystem::path& filepath, const Image& imageIn);
+
+
+
 	void destroy();
 
 
@@ -131,6 +181,16 @@ protected:
 
 	std::filesystem::path m_filepath;
 
+	/// <summary>
+	/// The part of the OpenGL texture that this texture covers, which is all of it unless this texture is packed
+	/// </summary>
+	SubTexture m_region = { { 0.0f, 0.0f }, { 1.0f, 1.0f } };
+
+	/// <summary>
+	/// The page that owns the OpenGL texture when this texture is packed
+	/// </summary>
+	std::shared_ptr<class TexturePage> m_page;
+
 	unsigned int m_width, m_height, m_channels, m_guid;
 }; 
 
@@ -0,0 +1,185 @@
+#include <vector>
+#include <algorithm>
+
+#include "renderer/texture/TextureArray.h"
+#include "renderer/texture/Texture.h"
+#include "renderer/texture/BindlessTexture.h"
+#include "renderer/RendererFondation.h"
+
+
+
+
+/// <summary>
+/// Creates immutable texture array storage with the same sampling state as Texture
+/// </summary>
+/// <param name="widthIn"></param>
+/// <param name="heightIn"></param>
+/// <param name="layersIn"></param>
+/// <returns></returns>
+unsigned int createGL_TextureArray(unsigned int widthIn, unsigned int heightIn, unsigned int layersIn)
+{
+	unsigned int id = 0;
+	glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &id);
+	glTextureStorage3D(id, 1, GL_RGBA8, widthIn, heightIn, layersIn);
+
+	glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+	glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	return id;
+}
+
+
+
+TextureArray::TextureArray(unsigned int widthIn, unsigned int heightIn, unsigned int capacityIn)
+	: m_width(widthIn), m_height(heightIn), m_layers(0), m_capacity(capacityIn)
+{
+	m_logger = Loggers::getLog();
+	GAME_ASSERT(m_width > 0 && m_height > 0 && m_capacity > 0);
+
+	m_id = createGL_TextureArray(m_width, m_height, m_capacity);
+	makeHandle();
+	m_logger->trace("Texture array '{0}' has been created for {1}x{2} textures", m_id, m_width, m_height);
+}
+
+
+
+TextureArray::TextureArray(TextureArray&& other) noexcept
+	: m_logger(other.m_logger), m_id(other.m_id), m_width(other.m_width), m_height(other.m_height), m_layers(other.m_layers), 
+	m_capacity(other.m_capacity), m_freeLayers(std::move(other.m_freeLayers)), m_handle(other.m_handle), m_movedOrDestroyed(other.m_movedOrDestroyed)
+{
+	other.m_id = 0;
+	other.m_handle = 0;
+	other.m_layers = 0;
+	other.m_capacity = 0;
+	other.m_movedOrDestroyed = true;
+}
+
+
+
+TextureArray::~TextureArray()
+{
+	destroy();
+}
+
+
+
+int TextureArray::add(const Texture& textureIn)
+{
+	if (textureIn.width() != m_width || textureIn.height() != m_height)
+	{
+		m_logger->error("Texture '{0}' is {1}x{2} and cannot be added to a {3}x{4} texture array", 
+			textureIn.location().string(), textureIn.width(), textureIn.height(), m_width, m_height);
+		return -1;
+	}
+
+	unsigned int layer = m_layers;
+	if (!m_freeLayers.empty())
+	{
+		layer = m_freeLayers.back();
+		m_freeLayers.pop_back();
+	}
+	else if (m_layers == m_capacity && !grow(m_capacity * 2))
+		return -1;
+	else
+		m_layers++;
+
+	// The copy is read back as RGBA so that RGB and RGBA textures can share an array
+	std::vector<unsigned char> pixels(static_cast<size_t>(m_width) * m_height * 4);
+	glGetTextureImage(textureIn.getNativeID(), 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLsizei>(pixels.size()), pixels.data());
+	glTextureSubImage3D(m_id, 0, 0, 0, layer, m_width, m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	return static_cast<int>(layer);
+}
+
+
+
+void TextureArray::remove(unsigned int layerIn)
+{
+	GAME_ASSERT(layerIn < m_layers);
+	GAME_ASSERT(std::find(m_freeLayers.begin(), m_freeLayers.end(), layerIn) == m_freeLayers.end());
+	m_freeLayers.push_back(layerIn);
+}
+
+
+
+void TextureArray::bind(unsigned int slot) const
+{
+	glBindTextureUnit(slot, m_id);
+}
+
+
+
+void TextureArray::unbind(unsigned int slot) const
+{
+	glBindTextureUnit(slot, 0);
+}
+
+
+
+bool TextureArray::grow(unsigned int capacityIn)
+{
+	int maxLayers = 0;
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+	unsigned int capacity = std::min(capacityIn, static_cast<unsigned int>(maxLayers));
+	if (capacity <= m_capacity)
+	{
+		m_logger->error("Texture array '{0}' is full, it already has the maximum of {1} layers", m_id, maxLayers);
+		return false;
+	}
+
+	// Storage is immutable so a larger array is made and the existing layers are copied on the GPU
+	unsigned int id = createGL_TextureArray(m_width, m_height, capacity);
+	if (m_layers > 0)
+		glCopyImageSubData(m_id, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, id, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, m_width, m_height, m_layers);
+
+	releaseHandle();
+	glDeleteTextures(1, &m_id);
+	m_id = id;
+	m_capacity = capacity;
+	makeHandle();
+	return true;
+}
+
+
+
+void TextureArray::makeHandle()
+{
+	if (!BindlessTexture::isSupported())
+		return;
+
+	m_handle = BindlessTexture::getHandle(m_id);
+	BindlessTexture::makeResident(m_handle);
+}
+
+
+
+void TextureArray::releaseHandle()
+{
+	if (m_handle == 0)
+		return;
+
+	BindlessTexture::makeNonResident(m_handle);
+	m_handle = 0;
+}
+
+
+
+void TextureArray::destroy()
+{
+	if (!m_movedOrDestroyed)
+	{
+		releaseHandle();
+		m_logger->trace("Texture array '{0}' has been deleted", m_id);
+		glDeleteTextures(1, &m_id);
+		m_id = 0;
+		m_layers = 0;
+		m_capacity = 0;
+		m_freeLayers.clear();
+		m_movedOrDestroyed = true;
+	}
+}
+
+
+
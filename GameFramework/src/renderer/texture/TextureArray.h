@@ -0,0 +1,191 @@
+#ifndef TextureArray_H_
+#define TextureArray_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// Where a texture has been packed into a texture array
+/// </summary>
+struct TextureArrayLayer
+{
+	/// <summary>
+	/// Index of the texture array in the asset librarian
+	/// </summary>
+	int array;
+
+	unsigned int layer;
+};
+
+
+
+/// <summary>
+/// A GL_TEXTURE_2D_ARRAY that holds copies of same-sized textures, one texture per layer
+/// <para>
+/// Quads that use any texture in the array can be drawn in the same batch because the layer is selected per vertex.
+/// When bindless textures are supported the array is also given a resident handle so it never has to be bound to a texture slot
+/// </para>
+/// </summary>
+class TextureArray
+{
+public:
+
+	static constexpr unsigned int DEFAULT_CAPACITY = 8;
+
+
+
+	/// <summary>
+	/// Creates a new texture array for textures of the given size
+	/// </summary>
+	/// <param name="widthIn">Specifies the width of every layer</param>
+	/// <param name="heightIn">Specifies the height of every layer</param>
+	/// <param name="capacityIn">Specifies the number of layers that storage is made for, the array grows if more are added</param>
+	TextureArray(unsigned int widthIn, unsigned int heightIn, unsigned int capacityIn = DEFAULT_CAPACITY);
+
+
+
+	TextureArray(const TextureArray& other) = delete;
+
+
+
+	TextureArray(TextureArray&& other) noexcept;
+
+
+
+	~TextureArray();
+
+
+
+	/// <summary>
+	/// Copies the given texture into a layer of this array, layers that were removed are reused before the array grows
+	/// </summary>
+	/// <param name="textureIn">Specifies the texture, which must be the same size as this array</param>
+	/// <returns>The new layer or -1 on failure</returns>
+	int add(const class Texture& textureIn);
+
+
+
+	/// <summary>
+	/// Frees the given layer so that the next texture that is added can take it
+	/// <para>Nothing may draw from the layer afterwards, its pixels are kept until another texture is copied over them</para>
+	/// </summary>
+	/// <param name="layerIn"></param>
+	void remove(unsigned int layerIn);
+
+
+
+	/// <summary>
+	/// Binds this texture array to the given texture slot
+	/// </summary>
+	/// <param name="slot">Specifies the texture slot</param>
+	void bind(unsigned int slot) const;
+
+
+
+	/// <summary>
+	/// Unbinds the texture array from the given texture slot
+	/// </summary>
+	/// <param name="slot">Specifies the texture slot</param>
+	void unbind(unsigned int slot) const;
+
+
+
+	/// <summary>
+	/// Gets the width of every layer
+	/// </summary>
+	/// <returns></returns>
+	unsigned int width() const { return m_width; }
+
+
+
+	/// <summary>
+	/// Gets the height of every layer
+	/// </summary>
+	/// <returns></returns>
+	unsigned int height() const { return m_height; }
+
+
+
+	/// <summary>
+	/// Gets the number of layers in use
+	/// </summary>
+	/// <returns></returns>
+	unsigned int layers() const { return m_layers - static_cast<unsigned int>(m_freeLayers.size()); }
+
+
+
+	/// <summary>
+	/// Gets this texture array's OpenGL texture identifier
+	/// </summary>
+	/// <returns></returns>
+	unsigned int getNativeID() const { return m_id; }
+
+
+
+	/// <summary>
+	/// Gets this texture array's resident bindless handle, or 0 if bindless textures are not supported
+	/// </summary>
+	/// <returns></returns>
+	uint64_t getHandle() const { return m_handle; }
+
+
+
+private:
+
+	/// <summary>
+	/// Moves all layers into new storage with at least the given number of layers
+	/// </summary>
+	/// <param name="capacityIn"></param>
+	/// <returns>True if this array was able to grow</returns>
+	bool grow(unsigned int capacityIn);
+
+
+
+	/// <summary>
+	/// Makes a new resident bindless handle for the current storage if bindless textures are supported
+	/// </summary>
+	void makeHandle();
+
+
+
+	/// <summary>
+	/// Makes the current bindless handle non-resident
+	/// </summary>
+	void releaseHandle();
+
+
+
+	void destroy();
+
+
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	unsigned int m_id = 0;
+
+	/// <summary>
+	/// m_layers counts every layer that has been written to, including the ones that have been removed since
+	/// </summary>
+	unsigned int m_width, m_height, m_layers, m_capacity;
+
+	/// <summary>
+	/// Layers below m_layers that have been removed and can be reused
+	/// </summary>
+	std::vector<unsigned int> m_freeLayers;
+
+	uint64_t m_handle = 0;
+
+	bool m_movedOrDestroyed = false;
+};
+
+
+#endif /* TextureArray_H_ */
+
+
+
@@ -20,6 +20,23 @@ TextureAtlas::TextureAtlas(const std::filesystem::path& filepath, const glm::uve
 
 
 
+TextureAtlas::TextureAtlas(const std::filesystem::path& filepath, const Image& imageIn, const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn, unsigned int GuidIn)
+	: Texture(filepath, imageIn, GuidIn), m_spriteSize(spriteSizeIn), m_spritePadding(spritePaddingIn)
+{
+	buildSubTextures();
+}
+
+
+
+TextureAtlas::TextureAtlas(const std::filesystem::path& filepath, std::shared_ptr<TexturePage> pageIn, const glm::uvec2& positionIn, const glm::uvec2& sizeIn, 
+	const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn, unsigned int GuidIn)
+	: Texture(filepath, std::move(pageIn), positionIn, sizeIn, GuidIn), m_spriteSize(spriteSizeIn), m_spritePadding(spritePaddingIn)
+{
+	buildSubTextures();
+}
+
+
+
 TextureAtlas::TextureAtlas(TextureAtlas&& other) noexcept
 	: Texture(std::move(other)), m_spriteSize(other.m_spriteSize), m_spritePadding(other.m_spritePadding)
 {
@@ -71,7 +88,9 @@ void TextureAtlas::buildSubTextures()
 			float miny = ((m_spriteSize.y + m_spritePadding.y) * y) / static_cast<float>(m_height);
 			float maxx = ((m_spriteSize.x + m_spritePadding.x) * x + m_spriteSize.x) / static_cast<float>(m_width);
 			float maxy = ((m_spriteSize.y + m_spritePadding.y) * y + m_spriteSize.y) / static_cast<float>(m_height);
-			SubTexture tex = { { minx, miny }, { maxx, maxy } };
+			// Packed atlases keep their grid inside of their region of the page
+			const glm::vec2 regionSize = m_region.max - m_region.min;
+			SubTexture tex = { m_region.min + glm::vec2(minx, miny) * regionSize, m_region.min + glm::vec2(maxx, maxy) * regionSize };
 			m_subTextures.push_back(tex);
 		}
 	}
@@ -22,6 +22,33 @@ public:
 
 
 
+	/// <summary>
+	/// Creates a texture atlas from an image that has already been decoded
+	/// </summary>
+	/// <param name="filepath">Specifies where the image was decoded from</param>
+	/// <param name="imageIn"></param>
+	/// <param name="spriteSizeIn"></param>
+	/// <param name="spritePaddingIn"></param>
+	/// <param name="GuidIn"></param>
+	TextureAtlas(const std::filesystem::path& filepath, const Image& imageIn, const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn, unsigned int GuidIn);
+
+
+
+	/// <summary>
+	/// Creates a texture atlas that is a region of a texture page, its sprite grid is kept inside of the region
+	/// </summary>
+	/// <param name="filepath">Specifies where the image was decoded from</param>
+	/// <param name="pageIn">Specifies the page that holds the image</param>
+	/// <param name="positionIn">Specifies the bottom left corner of the image in the page</param>
+	/// <param name="sizeIn">Specifies the size of the image</param>
+	/// <param name="spriteSizeIn"></param>
+	/// <param name="spritePaddingIn"></param>
+	/// <param name="GuidIn"></param>
+	TextureAtlas(const std::filesystem::path& filepath, std::shared_ptr<class TexturePage> pageIn, const glm::uvec2& positionIn, const glm::uvec2& sizeIn, 
+		const glm::uvec2& spriteSizeIn, const glm::uvec2& spritePaddingIn, unsigned int GuidIn);
+
+
+
 	TextureAtlas(const TextureAtlas& other) = delete;
 
 
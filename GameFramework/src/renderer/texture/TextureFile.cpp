@@ -0,0 +1,172 @@
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "renderer/texture/TextureFile.h"
+
+
+
+
+bool TextureFile::isCooked(const std::filesystem::path& filepathIn)
+{
+	return filepathIn.extension() == EXTENSION;
+}
+
+
+
+size_t TextureFile::levelSize(Format formatIn, unsigned int widthIn, unsigned int heightIn)
+{
+	const size_t blocks = static_cast<size_t>((widthIn + 3) / 4) * ((heightIn + 3) / 4);
+	switch (formatIn)
+	{
+	case Format::RGBA8:
+		return static_cast<size_t>(widthIn) * heightIn * 4;
+
+	case Format::BC1:
+		return blocks * 8;
+
+	case Format::BC3:
+	case Format::BC7:
+		return blocks * 16;
+
+	default:
+		return 0;
+	}
+}
+
+
+
+unsigned int TextureFile::numberOfLevels(unsigned int widthIn, unsigned int heightIn)
+{
+	unsigned int levels = 1;
+	for (unsigned int size = std::max(widthIn, heightIn); size > 1; size /= 2)
+		levels++;
+	return levels;
+}
+
+
+
+bool TextureFile::read(const std::filesystem::path& filepathIn, TextureFileHeader& headerOut, std::vector<TextureFileLevel>& levelsOut, 
+	unsigned char*& dataOut, std::string& errorOut)
+{
+	dataOut = nullptr;
+	std::ifstream textureFile(filepathIn, std::ios::binary);
+	if (!textureFile.is_open())
+	{
+		errorOut = "unable to open the file";
+		return false;
+	}
+
+	if (!textureFile.read(reinterpret_cast<char*>(&headerOut), sizeof(headerOut)))
+	{
+		errorOut = "the file is too small to hold a header";
+		return false;
+	}
+
+	if (std::memcmp(headerOut.magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		errorOut = "the file is not a cooked texture";
+		return false;
+	}
+
+	if (headerOut.version != VERSION)
+	{
+		errorOut = "unsupported version " + std::to_string(headerOut.version);
+		return false;
+	}
+
+	const Format format = static_cast<Format>(headerOut.format);
+	if (headerOut.format > static_cast<uint32_t>(Format::BC7))
+	{
+		errorOut = "unsupported format " + std::to_string(headerOut.format);
+		return false;
+	}
+
+	if (headerOut.width == 0 || headerOut.height == 0 || headerOut.numberOfLevels == 0 
+		|| headerOut.numberOfLevels > numberOfLevels(headerOut.width, headerOut.height))
+	{
+		errorOut = "the texture's size is not valid";
+		return false;
+	}
+
+	levelsOut.resize(headerOut.numberOfLevels);
+	if (!textureFile.read(reinterpret_cast<char*>(levelsOut.data()), static_cast<std::streamsize>(levelsOut.size() * sizeof(TextureFileLevel))))
+	{
+		errorOut = "the file is too small to hold every level";
+		return false;
+	}
+
+	// The levels are stored one after the other, so they are read with a single call and rebased onto the returned data
+	const uint64_t first = sizeof(TextureFileHeader) + levelsOut.size() * sizeof(TextureFileLevel);
+	uint64_t end = first;
+	for (unsigned int i = 0; i < headerOut.numberOfLevels; i++)
+	{
+		const unsigned int width = std::max(headerOut.width >> i, 1u);
+		const unsigned int height = std::max(headerOut.height >> i, 1u);
+		if (levelsOut[i].offset != end || levelsOut[i].size != levelSize(format, width, height))
+		{
+			errorOut = "level " + std::to_string(i) + " is not valid";
+			return false;
+		}
+		end += levelsOut[i].size;
+	}
+
+	dataOut = static_cast<unsigned char*>(std::malloc(static_cast<size_t>(end - first)));
+	if (dataOut == nullptr || !textureFile.read(reinterpret_cast<char*>(dataOut), static_cast<std::streamsize>(end - first)))
+	{
+		std::free(dataOut);
+		dataOut = nullptr;
+		errorOut = "the file is too small to hold every level";
+		return false;
+	}
+
+	for (TextureFileLevel& level : levelsOut)
+		level.offset -= first;
+	return true;
+}
+
+
+
+bool TextureFile::write(const std::filesystem::path& filepathIn, Format formatIn, unsigned int widthIn, unsigned int heightIn, 
+	const std::vector<std::vector<unsigned char>>& levelsIn, std::string& errorOut)
+{
+	TextureFileHeader header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.format = static_cast<uint32_t>(formatIn);
+	header.width = widthIn;
+	header.height = heightIn;
+	header.numberOfLevels = static_cast<uint32_t>(levelsIn.size());
+
+	std::vector<TextureFileLevel> levels(levelsIn.size());
+	uint64_t offset = sizeof(TextureFileHeader) + levels.size() * sizeof(TextureFileLevel);
+	for (size_t i = 0; i < levelsIn.size(); i++)
+	{
+		levels[i] = { offset, levelsIn[i].size() };
+		offset += levelsIn[i].size();
+	}
+
+	std::ofstream textureFile(filepathIn, std::ios::binary | std::ios::trunc);
+	if (!textureFile.is_open())
+	{
+		errorOut = "unable to open the file";
+		return false;
+	}
+
+	textureFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	textureFile.write(reinterpret_cast<const char*>(levels.data()), static_cast<std::streamsize>(levels.size() * sizeof(TextureFileLevel)));
+	for (const auto& level : levelsIn)
+		textureFile.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+
+	if (textureFile.fail())
+	{
+		errorOut = "unable to write the file";
+		return false;
+	}
+
+	return true;
+}
+
+
+
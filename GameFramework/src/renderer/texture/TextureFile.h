@@ -0,0 +1,178 @@
+#ifndef TextureFile_H_
+#define TextureFile_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+
+
+
+/// <summary>
+/// The header at the start of a cooked texture file
+/// <para>
+/// It is followed by one TextureFileLevel per mip level, largest first, and then the data of every level. Rows are stored 
+/// bottom first as OpenGL expects. All values are little-endian
+/// </para>
+/// </summary>
+struct TextureFileHeader
+{
+	char magic[4];
+
+	uint32_t version;
+
+	/// <summary>
+	/// How the texels are stored, see TextureFile::Format
+	/// </summary>
+	uint32_t format;
+
+	uint32_t width;
+
+	uint32_t height;
+
+	uint32_t numberOfLevels;
+
+	uint32_t reserved[2];
+};
+
+
+static_assert(sizeof(TextureFileHeader) == 32, "The texture file header is part of the file format and must not change size");
+
+
+
+/// <summary>
+/// Where one mip level's data is in a cooked texture file
+/// </summary>
+struct TextureFileLevel
+{
+	/// <summary>
+	/// Measured in bytes from the start of the file
+	/// </summary>
+	uint64_t offset;
+
+	uint64_t size;
+};
+
+
+static_assert(sizeof(TextureFileLevel) == 16, "The texture file level is part of the file format and must not change size");
+
+
+
+/// <summary>
+/// Reads and writes cooked textures, which hold a full mip chain that is either uncompressed or block compressed so it can be 
+/// uploaded without being decoded
+/// </summary>
+class TextureFile
+{
+public:
+
+	enum class Format : uint32_t
+	{
+		RGBA8 = 0,
+
+		/// <summary>
+		/// 4x4 blocks of 8 bytes, two 565 colors and 2 bit indices, with 1 bit alpha
+		/// </summary>
+		BC1 = 1,
+
+		/// <summary>
+		/// 4x4 blocks of 16 bytes, a BC1 color block after an interpolated alpha block
+		/// </summary>
+		BC3 = 2,
+
+		/// <summary>
+		/// 4x4 blocks of 16 bytes, written by external tools
+		/// </summary>
+		BC7 = 3
+	};
+
+
+
+	static constexpr char MAGIC[4] = { 'G', 'F', 'T', 'X' };
+
+	static constexpr uint32_t VERSION = 1;
+
+	/// <summary>
+	/// The file extension of cooked textures
+	/// </summary>
+	static constexpr const char* EXTENSION = ".gtex";
+
+
+
+	TextureFile() = delete;
+
+
+
+	/// <summary>
+	/// Checks if the given file is a cooked texture by its extension
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <returns></returns>
+	static bool isCooked(const std::filesystem::path& filepathIn);
+
+
+
+	/// <summary>
+	/// Checks if the given format is block compressed
+	/// </summary>
+	/// <param name="formatIn"></param>
+	/// <returns></returns>
+	static bool isCompressed(Format formatIn) { return formatIn != Format::RGBA8; }
+
+
+
+	/// <summary>
+	/// Gets the size of one mip level, measured in bytes
+	/// </summary>
+	/// <param name="formatIn"></param>
+	/// <param name="widthIn">Specifies the level's width</param>
+	/// <param name="heightIn">Specifies the level's height</param>
+	/// <returns></returns>
+	static size_t levelSize(Format formatIn, unsigned int widthIn, unsigned int heightIn);
+
+
+
+	/// <summary>
+	/// Gets the number of mip levels in a full chain down to 1x1
+	/// </summary>
+	/// <param name="widthIn"></param>
+	/// <param name="heightIn"></param>
+	/// <returns></returns>
+	static unsigned int numberOfLevels(unsigned int widthIn, unsigned int heightIn);
+
+
+
+	/// <summary>
+	/// Reads a whole cooked texture
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="headerOut">Filled in with the texture's header</param>
+	/// <param name="levelsOut">Filled in with where each level is, offsets are from the start of the returned data</param>
+	/// <param name="dataOut">Filled in with every level's data, it is allocated with malloc and owned by the caller</param>
+	/// <param name="errorOut">Describes what went wrong when the texture could not be read</param>
+	/// <returns>True if the texture was read</returns>
+	static bool read(const std::filesystem::path& filepathIn, TextureFileHeader& headerOut, std::vector<TextureFileLevel>& levelsOut, 
+		unsigned char*& dataOut, std::string& errorOut);
+
+
+
+	/// <summary>
+	/// Writes a cooked texture
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="formatIn"></param>
+	/// <param name="widthIn">Specifies the width of the first level</param>
+	/// <param name="heightIn">Specifies the height of the first level</param>
+	/// <param name="levelsIn">Specifies the data of each level, largest first</param>
+	/// <param name="errorOut">Describes what went wrong when the texture could not be written</param>
+	/// <returns>True if the texture was written</returns>
+	static bool write(const std::filesystem::path& filepathIn, Format formatIn, unsigned int widthIn, unsigned int heightIn, 
+		const std::vector<std::vector<unsigned char>>& levelsIn, std::string& errorOut);
+};
+
+
+#endif /* TextureFile_H_ */
+
+
+
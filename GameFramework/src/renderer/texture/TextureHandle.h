@@ -0,0 +1,89 @@
+#ifndef TextureHandle_H_
+#define TextureHandle_H_
+
+#include <cstdint>
+
+
+
+
+/// <summary>
+/// A 32-bit reference to a texture in the AssetLibrarian, which lets a texture be drawn without looking it up by name
+/// <para>
+/// The lower 20 bits hold the index of the librarian's texture slot and the upper 12 bits hold the slot's generation. 
+/// When a texture is removed its slot's generation changes, so handles to the old texture stop resolving instead of 
+/// referring to whatever texture takes the slot next
+/// </para>
+/// </summary>
+class TextureHandle
+{
+public:
+
+	static constexpr uint32_t INDEX_BITS = 20;
+
+	static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+	static constexpr uint32_t GENERATION_MASK = 0xFFF;
+
+
+
+	TextureHandle() = default;
+
+
+
+	/// <summary>
+	/// Makes a new handle, generation 0 is never given to a slot so a handle made from it is never valid
+	/// </summary>
+	/// <param name="indexIn">Specifies the index of the texture's slot</param>
+	/// <param name="generationIn">Specifies the generation of the texture's slot</param>
+	TextureHandle(uint32_t indexIn, uint32_t generationIn)
+		: m_value(((generationIn & GENERATION_MASK) << INDEX_BITS) | (indexIn & INDEX_MASK))
+	{}
+
+
+
+	/// <summary>
+	/// Checks if this handle was given out by the AssetLibrarian, it may still refer to a texture that has since been removed
+	/// </summary>
+	/// <returns></returns>
+	bool isValid() const { return generation() != 0; }
+
+
+
+	/// <summary>
+	/// Gets the index of the texture's slot in the AssetLibrarian
+	/// </summary>
+	/// <returns></returns>
+	uint32_t index() const { return m_value & INDEX_MASK; }
+
+
+
+	/// <summary>
+	/// Gets the generation of the texture's slot when this handle was made
+	/// </summary>
+	/// <returns></returns>
+	uint32_t generation() const { return m_value >> INDEX_BITS; }
+
+
+
+	uint32_t value() const { return m_value; }
+
+
+
+	bool operator==(const TextureHandle& other) const { return m_value == other.m_value; }
+
+
+
+	bool operator!=(const TextureHandle& other) const { return m_value != other.m_value; }
+
+
+
+private:
+
+	uint32_t m_value = 0;
+};
+
+
+#endif /* TextureHandle_H_ */
+
+
+
@@ -0,0 +1,86 @@
+#include "renderer/texture/TexturePage.h"
+#include "renderer/RendererFondation.h"
+
+
+
+
+TexturePage::TexturePage(unsigned int widthIn, unsigned int heightIn)
+	: m_packer(widthIn, heightIn)
+{
+	m_logger = Loggers::getLog();
+
+	glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
+	glTextureStorage2D(m_id, 1, GL_RGBA8, widthIn, heightIn);
+
+	glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	// New storage is undefined, the padding between images has to be transparent
+	const unsigned char clear[4] = { 0, 0, 0, 0 };
+	glClearTexImage(m_id, 0, GL_RGBA, GL_UNSIGNED_BYTE, clear);
+	m_logger->trace("Texture page '{0}' has been created, {1}x{2}", m_id, widthIn, heightIn);
+}
+
+
+
+TexturePage::~TexturePage()
+{
+	glDeleteTextures(1, &m_id);
+}
+
+
+
+bool TexturePage::add(const Image& imageIn, glm::uvec2& positionOut)
+{
+	if (imageIn.isCompressed() || imageIn.numberOfLevels() > 1)
+	{
+		m_logger->warn("Unable to add a cooked image to texture page '{0}', only single level RGB and RGBA images can be packed", m_id);
+		return false;
+	}
+
+	GLenum format = 0;
+	switch (imageIn.channels())
+	{
+	case 3:
+		format = GL_RGB;
+		break;
+
+	case 4:
+		format = GL_RGBA;
+		break;
+
+	default:
+		m_logger->warn("Unable to add a {0} channel image to texture page '{1}'", imageIn.channels(), m_id);
+		return false;
+	}
+
+	glm::uvec2 position;
+	if (!m_packer.insert(imageIn.width() + PADDING * 2, imageIn.height() + PADDING * 2, position))
+		return false;
+
+	// Rows of RGB images are not always 4 byte aligned
+	positionOut = position + glm::uvec2(PADDING, PADDING);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTextureSubImage2D(m_id, 0, positionOut.x, positionOut.y, imageIn.width(), imageIn.height(), format, GL_UNSIGNED_BYTE, imageIn.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	return true;
+}
+
+
+
+bool TexturePage::canHold(const Image& imageIn, unsigned int widthIn, unsigned int heightIn)
+{
+	if (!imageIn.isValid() || imageIn.isCompressed() || imageIn.numberOfLevels() > 1)
+		return false;
+
+	if (imageIn.channels() != 3 && imageIn.channels() != 4)
+		return false;
+
+	return imageIn.width() + PADDING * 2 <= widthIn && imageIn.height() + PADDING * 2 <= heightIn;
+}
+
+
+
@@ -0,0 +1,110 @@
+#ifndef TexturePage_H_
+#define TexturePage_H_
+
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include "renderer/texture/Image.h"
+#include "renderer/texture/SkylinePacker.h"
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// A large texture that small images are packed into, so textures that share a page can be drawn in the same batch 
+/// without using more than one texture slot
+/// <para>Images are never taken out of a page, the room an image was given stays used for as long as the page exists</para>
+/// </summary>
+class TexturePage
+{
+public:
+
+	/// <summary>
+	/// The number of transparent pixels kept around every packed image so neighbouring images never bleed into each other
+	/// </summary>
+	static constexpr unsigned int PADDING = 1;
+
+
+
+	/// <summary>
+	/// Creates a new empty page, this needs the OpenGL context
+	/// </summary>
+	/// <param name="widthIn"></param>
+	/// <param name="heightIn"></param>
+	TexturePage(unsigned int widthIn, unsigned int heightIn);
+
+
+
+	TexturePage(const TexturePage& other) = delete;
+
+
+
+	TexturePage(TexturePage&& other) = delete;
+
+
+
+	~TexturePage();
+
+
+
+	/// <summary>
+	/// Finds room for an image and copies it into this page
+	/// </summary>
+	/// <param name="imageIn"></param>
+	/// <param name="positionOut">Filled in with the bottom left corner of the image in this page</param>
+	/// <returns>True if the image was added, false if there is no room left for it</returns>
+	bool add(const Image& imageIn, glm::uvec2& positionOut);
+
+
+
+	/// <summary>
+	/// Checks if an image could be added to an empty page of the given size
+	/// </summary>
+	/// <param name="imageIn"></param>
+	/// <param name="widthIn">Specifies the width of the page</param>
+	/// <param name="heightIn">Specifies the height of the page</param>
+	/// <returns>True if the image's format can be packed and it fits, including its padding</returns>
+	static bool canHold(const Image& imageIn, unsigned int widthIn, unsigned int heightIn);
+
+
+
+	unsigned int width() const { return m_packer.width(); }
+
+
+
+	unsigned int height() const { return m_packer.height(); }
+
+
+
+	/// <summary>
+	/// Gets the fraction of this page that is covered by images and their padding
+	/// </summary>
+	/// <returns></returns>
+	float occupancy() const { return m_packer.occupancy(); }
+
+
+
+	/// <summary>
+	/// Gets this page's OpenGL identifier
+	/// </summary>
+	/// <returns></returns>
+	unsigned int getNativeID() const { return m_id; }
+
+
+
+private:
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	unsigned int m_id = 0;
+
+	SkylinePacker m_packer;
+};
+
+
+#endif /* TexturePage_H_ */
+
+
+
@@ -0,0 +1,198 @@
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <cstdio>
+
+#include "utilities/AssetCache.h"
+
+
+
+
+AssetCache::AssetCache(const std::filesystem::path& directoryIn, uintmax_t maxBytesIn)
+	: m_directory(directoryIn / ("v" + std::to_string(VERSION))), m_maxBytes(maxBytesIn)
+{
+	m_logger = Loggers::getLog();
+
+	std::error_code error;
+	std::filesystem::create_directories(m_directory, error);
+	if (error)
+		m_logger->warn("Unable to create the asset cache at '{0}': {1}", m_directory.string(), error.message());
+}
+
+
+
+AssetCache::~AssetCache()
+{
+	trim();
+}
+
+
+
+uint64_t AssetCache::hash(const void* dataIn, size_t sizeIn, uint64_t seedIn)
+{
+	const unsigned char* data = static_cast<const unsigned char*>(dataIn);
+	uint64_t hash = seedIn;
+	for (size_t i = 0; i < sizeIn; i++)
+	{
+		hash ^= data[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+
+
+bool AssetCache::readFile(const std::filesystem::path& filepathIn, std::vector<unsigned char>& dataOut)
+{
+	std::ifstream file(filepathIn, std::ios::in | std::ios::binary);
+	if (!file)
+		return false;
+
+	file.seekg(0, std::ios::end);
+	const std::streamoff size = file.tellg();
+	if (size < 0)
+		return false;
+
+	dataOut.resize(static_cast<size_t>(size));
+	file.seekg(0, std::ios::beg);
+	return static_cast<bool>(file.read(reinterpret_cast<char*>(dataOut.data()), size));
+}
+
+
+
+bool AssetCache::find(const std::string& kindIn, uint64_t keyIn, std::filesystem::path& entryOut)
+{
+	entryOut = entryPath(kindIn, keyIn);
+	std::error_code error;
+	if (!std::filesystem::is_regular_file(entryOut, error))
+	{
+		m_misses++;
+		return false;
+	}
+
+	// Entries that are used are the last to be trimmed
+	std::filesystem::last_write_time(entryOut, std::filesystem::file_time_type::clock::now(), error);
+	m_hits++;
+	return true;
+}
+
+
+
+bool AssetCache::read(const std::string& kindIn, uint64_t keyIn, std::vector<unsigned char>& dataOut)
+{
+	std::filesystem::path entry;
+	return find(kindIn, keyIn, entry) && readFile(entry, dataOut);
+}
+
+
+
+bool AssetCache::store(const std::string& kindIn, uint64_t keyIn, const std::function<bool(const std::filesystem::path&)>& writeIn)
+{
+	const std::filesystem::path entry = entryPath(kindIn, keyIn);
+	std::error_code error;
+	std::filesystem::create_directories(entry.parent_path(), error);
+
+	// The rename is the only step that makes the entry visible, so a half written entry is never read
+	std::filesystem::path temporary = entry;
+	temporary += ".tmp" + std::to_string(m_nextTemporary++) + "-" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+	if (!writeIn(temporary))
+	{
+		std::filesystem::remove(temporary, error);
+		m_logger->warn("Unable to store '{0}' in the asset cache", entry.string());
+		return false;
+	}
+
+	std::filesystem::rename(temporary, entry, error);
+	if (error)
+	{
+		std::filesystem::remove(temporary, error);
+		m_logger->warn("Unable to store '{0}' in the asset cache", entry.string());
+		return false;
+	}
+
+	m_stores++;
+	return true;
+}
+
+
+
+bool AssetCache::store(const std::string& kindIn, uint64_t keyIn, const void* dataIn, size_t sizeIn)
+{
+	return store(kindIn, keyIn, [dataIn, sizeIn](const std::filesystem::path& filepathIn)
+		{
+			std::ofstream file(filepathIn, std::ios::out | std::ios::binary | std::ios::trunc);
+			file.write(static_cast<const char*>(dataIn), static_cast<std::streamsize>(sizeIn));
+			return file.good();
+		});
+}
+
+
+
+void AssetCache::trim()
+{
+	struct Entry
+	{
+		std::filesystem::path path;
+
+		std::filesystem::file_time_type lastUsed;
+
+		uintmax_t size = 0;
+	};
+
+	std::vector<Entry> entries;
+	uintmax_t totalSize = 0;
+	std::error_code error;
+	for (auto it = std::filesystem::recursive_directory_iterator(m_directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+	{
+		if (!it->is_regular_file(error))
+			continue;
+
+		Entry entry;
+		entry.path = it->path();
+		entry.lastUsed = it->last_write_time(error);
+		entry.size = it->file_size(error);
+		totalSize += entry.size;
+		entries.push_back(std::move(entry));
+	}
+
+	if (totalSize <= m_maxBytes)
+		return;
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+	size_t removed = 0;
+	for (const Entry& entry : entries)
+	{
+		if (totalSize <= m_maxBytes)
+			break;
+
+		if (std::filesystem::remove(entry.path, error))
+		{
+			totalSize -= entry.size;
+			removed++;
+		}
+	}
+	m_logger->info("Removed {0} old entries from the asset cache", removed);
+}
+
+
+
+AssetCache::Statistics AssetCache::getStatistics() const
+{
+	Statistics statistics;
+	statistics.hits = m_hits;
+	statistics.misses = m_misses;
+	statistics.stores = m_stores;
+	return statistics;
+}
+
+
+
+std::filesystem::path AssetCache::entryPath(const std::string& kindIn, uint64_t keyIn) const
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(keyIn));
+	return m_directory / kindIn / name;
+}
+
+
+
@@ -0,0 +1,198 @@
+#ifndef AssetCache_H_
+#define AssetCache_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// A directory of assets that have already been decoded, compiled, or converted, keyed by a hash of their source
+/// <para>
+/// Each entry is named after the hash of the data it was made from, so an entry can never be used for a source that has
+/// changed, the changed source simply hashes to a new key. Entries are written to a temporary file and renamed into place,
+/// so entries can be stored from several threads at once and an interrupted write never leaves a partial entry behind
+/// </para>
+/// </summary>
+class AssetCache
+{
+public:
+
+	struct Statistics
+	{
+		size_t hits = 0;
+
+		size_t misses = 0;
+
+		size_t stores = 0;
+	};
+
+
+
+	/// <summary>
+	/// The FNV-1a offset basis, every key starts from it
+	/// </summary>
+	static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+
+
+	/// <summary>
+	/// The version of the cache's entries, changing it leaves every entry that has been cached behind
+	/// </summary>
+	static constexpr uint32_t VERSION = 1;
+
+
+
+	/// <summary>
+	/// Opens the given cache directory, it is created if it does not exist
+	/// </summary>
+	/// <param name="directoryIn"></param>
+	/// <param name="maxBytesIn">Specifies how large the cache can grow, the oldest entries are removed when the cache is closed</param>
+	explicit AssetCache(const std::filesystem::path& directoryIn, uintmax_t maxBytesIn = 256 * 1024 * 1024);
+
+
+
+	AssetCache(const AssetCache& other) = delete;
+
+
+
+	/// <summary>
+	/// Removes the oldest entries until the cache fits in its size limit
+	/// </summary>
+	~AssetCache();
+
+
+
+	/// <summary>
+	/// Hashes the given data with 64 bit FNV-1a
+	/// </summary>
+	/// <param name="dataIn"></param>
+	/// <param name="sizeIn"></param>
+	/// <param name="seedIn">Specifies the hash to continue from, so several pieces of data can be combined into one key</param>
+	/// <returns></returns>
+	static uint64_t hash(const void* dataIn, size_t sizeIn, uint64_t seedIn = HASH_SEED);
+
+
+
+	/// <summary>
+	/// Hashes the given string with 64 bit FNV-1a
+	/// </summary>
+	/// <param name="textIn"></param>
+	/// <param name="seedIn">Specifies the hash to continue from, so several pieces of data can be combined into one key</param>
+	/// <returns></returns>
+	static uint64_t hash(const std::string& textIn, uint64_t seedIn = HASH_SEED) { return hash(textIn.data(), textIn.size(), seedIn); }
+
+
+
+	/// <summary>
+	/// Reads the whole of the given file
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="dataOut"></param>
+	/// <returns>True if the file was read</returns>
+	static bool readFile(const std::filesystem::path& filepathIn, std::vector<unsigned char>& dataOut);
+
+
+
+	/// <summary>
+	/// Looks up an entry, entries that are found are marked as used so they are the last to be removed
+	/// </summary>
+	/// <param name="kindIn">Specifies the kind of asset, each kind is kept in its own folder</param>
+	/// <param name="keyIn">Specifies the hash of the entry's source</param>
+	/// <param name="entryOut">Filled in with the entry's location</param>
+	/// <returns>True if the entry is in the cache</returns>
+	bool find(const std::string& kindIn, uint64_t keyIn, std::filesystem::path& entryOut);
+
+
+
+	/// <summary>
+	/// Reads the whole of an entry
+	/// </summary>
+	/// <param name="kindIn">Specifies the kind of asset, each kind is kept in its own folder</param>
+	/// <param name="keyIn">Specifies the hash of the entry's source</param>
+	/// <param name="dataOut"></param>
+	/// <returns>True if the entry is in the cache and was read</returns>
+	bool read(const std::string& kindIn, uint64_t keyIn, std::vector<unsigned char>& dataOut);
+
+
+
+	/// <summary>
+	/// Stores an entry, replacing the entry with the same key if there is one
+	/// </summary>
+	/// <param name="kindIn">Specifies the kind of asset, each kind is kept in its own folder</param>
+	/// <param name="keyIn">Specifies the hash of the entry's source</param>
+	/// <param name="writeIn">Writes the entry to the file it is given, returning false if the entry could not be written</param>
+	/// <returns>True if the entry was stored</returns>
+	bool store(const std::string& kindIn, uint64_t keyIn, const std::function<bool(const std::filesystem::path&)>& writeIn);
+
+
+
+	/// <summary>
+	/// Stores an entry, replacing the entry with the same key if there is one
+	/// </summary>
+	/// <param name="kindIn">Specifies the kind of asset, each kind is kept in its own folder</param>
+	/// <param name="keyIn">Specifies the hash of the entry's source</param>
+	/// <param name="dataIn"></param>
+	/// <param name="sizeIn"></param>
+	/// <returns>True if the entry was stored</returns>
+	bool store(const std::string& kindIn, uint64_t keyIn, const void* dataIn, size_t sizeIn);
+
+
+
+	/// <summary>
+	/// Removes the least recently used entries until the cache is no larger than its size limit
+	/// </summary>
+	void trim();
+
+
+
+	const std::filesystem::path& getDirectory() const { return m_directory; }
+
+
+
+	/// <summary>
+	/// Gets the number of hits, misses, and stores since the cache was opened, it is safe to call from any thread
+	/// </summary>
+	/// <returns></returns>
+	Statistics getStatistics() const;
+
+
+
+private:
+
+	std::filesystem::path entryPath(const std::string& kindIn, uint64_t keyIn) const;
+
+
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	std::filesystem::path m_directory;
+
+	uintmax_t m_maxBytes = 0;
+
+	std::atomic<size_t> m_hits{ 0 };
+
+	std::atomic<size_t> m_misses{ 0 };
+
+	std::atomic<size_t> m_stores{ 0 };
+
+	/// <summary>
+	/// Gives every temporary file a unique name
+	/// </summary>
+	std::atomic<uint64_t> m_nextTemporary{ 0 };
+};
+
+
+#endif /* AssetCache_H_ */
+
+
+
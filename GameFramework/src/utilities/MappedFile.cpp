@@ -0,0 +1,130 @@
+#include "utilities/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	: m_data(other.m_data), m_size(other.m_size), m_mapping(other.m_mapping)
+{
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_mapping = nullptr;
+}
+
+
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		m_data = other.m_data;
+		m_size = other.m_size;
+		m_mapping = other.m_mapping;
+		other.m_data = nullptr;
+		other.m_size = 0;
+		other.m_mapping = nullptr;
+	}
+	return *this;
+}
+
+
+
+bool MappedFile::open(const std::filesystem::path& filepathIn, Access accessIn)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(filepathIn.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// The mapping keeps the file open, so the file's own handle is not needed once the mapping exists
+	const bool copyOnWrite = accessIn == Access::CopyOnWrite;
+	HANDLE mapping = CreateFileMappingW(file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+		return false;
+
+	void* data = MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+
+	m_data = data;
+	m_size = static_cast<size_t>(size.QuadPart);
+	m_mapping = mapping;
+#else
+	int file = ::open(filepathIn.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		::close(file);
+		return false;
+	}
+
+	// A private mapping is copy on write, so it can be writable even though the file was opened read only
+	const int protection = accessIn == Access::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+	void* data = mmap(nullptr, static_cast<size_t>(status.st_size), protection, MAP_PRIVATE, file, 0);
+	::close(file);
+	if (data == MAP_FAILED)
+		return false;
+
+	m_data = data;
+	m_size = static_cast<size_t>(status.st_size);
+#endif
+
+	return true;
+}
+
+
+
+void MappedFile::close()
+{
+	if (m_data == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+	munmap(m_data, m_size);
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping = nullptr;
+}
+
+
+
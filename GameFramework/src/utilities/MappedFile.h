@@ -0,0 +1,111 @@
+#ifndef MappedFile_H_
+#define MappedFile_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+
+
+
+/// <summary>
+/// A file that is mapped into memory, so its contents can be used in place without being read into a buffer
+/// </summary>
+class MappedFile
+{
+public:
+
+	enum class Access : uint8_t
+	{
+		/// <summary>
+		/// The mapped memory can only be read
+		/// </summary>
+		ReadOnly,
+
+		/// <summary>
+		/// The mapped memory can be written to, pages are copied the first time they are written and changes never reach the file
+		/// </summary>
+		CopyOnWrite
+	};
+
+
+
+	MappedFile() = default;
+
+
+
+	MappedFile(const MappedFile& other) = delete;
+
+
+
+	MappedFile(MappedFile&& other) noexcept;
+
+
+
+	~MappedFile();
+
+
+
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+
+
+	/// <summary>
+	/// Maps the whole of the given file into memory, any file that is already mapped is closed first
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="accessIn"></param>
+	/// <returns>True if the file was mapped</returns>
+	bool open(const std::filesystem::path& filepathIn, Access accessIn = Access::ReadOnly);
+
+
+
+	/// <summary>
+	/// Unmaps the file, every pointer into it becomes invalid
+	/// </summary>
+	void close();
+
+
+
+	/// <summary>
+	/// Checks if a file is mapped
+	/// </summary>
+	/// <returns></returns>
+	bool isOpen() const { return m_data != nullptr; }
+
+
+
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets the start of the mapped file
+	/// </summary>
+	/// <returns></returns>
+	void* data() const { return m_data; }
+
+
+
+	/// <summary>
+	/// Gets the size of the mapped file, measured in bytes
+	/// </summary>
+	/// <returns></returns>
+	size_t size() const { return m_size; }
+
+
+
+private:
+
+	void* m_data = nullptr;
+
+	size_t m_size = 0;
+
+	/// <summary>
+	/// The operating system's handle to the file mapping, only used on Windows
+	/// </summary>
+	void* m_mapping = nullptr;
+};
+
+
+#endif /* MappedFile_H_ */
+
+
+
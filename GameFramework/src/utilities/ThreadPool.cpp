@@ -0,0 +1,57 @@
+#include <algorithm>
+
+#include "utilities/ThreadPool.h"
+
+
+
+
+ThreadPool::ThreadPool(unsigned int numberOfThreadsIn)
+{
+	// The calling thread is usually busy as well, so by default it is left a hardware thread of its own
+	unsigned int numberOfThreads = numberOfThreadsIn;
+	if (numberOfThreads == 0)
+		numberOfThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+	m_workers.reserve(numberOfThreads);
+	for (unsigned int i = 0; i < numberOfThreads; i++)
+		m_workers.emplace_back(&ThreadPool::loop, this);
+}
+
+
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_quit = true;
+		m_jobs.clear();
+	}
+	m_signal.notify_all();
+
+	for (std::thread& worker : m_workers)
+		worker.join();
+}
+
+
+
+void ThreadPool::loop()
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_signal.wait(lock, [this]() { return m_quit || !m_jobs.empty(); });
+			if (m_quit)
+				return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+
+		job();
+	}
+}
+
+
+
@@ -0,0 +1,99 @@
+#ifndef ThreadPool_H_
+#define ThreadPool_H_
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+
+
+
+/// <summary>
+/// A fixed number of worker threads that run jobs from a shared queue in the order they were submitted
+/// </summary>
+class ThreadPool
+{
+public:
+
+	/// <summary>
+	/// Starts the given number of worker threads, or one less than the number of hardware threads if none is given
+	/// </summary>
+	/// <param name="numberOfThreadsIn"></param>
+	explicit ThreadPool(unsigned int numberOfThreadsIn = 0);
+
+
+
+	ThreadPool(const ThreadPool& other) = delete;
+
+
+
+	ThreadPool(ThreadPool&& other) = delete;
+
+
+
+	/// <summary>
+	/// Finishes the jobs that have already started and stops every worker thread, jobs that have not started are dropped
+	/// </summary>
+	~ThreadPool();
+
+
+
+	/// <summary>
+	/// Queues a job to be run on one of the worker threads
+	/// </summary>
+	/// <param name="jobIn"></param>
+	/// <returns>A future that holds the job's result, or the exception that it threw</returns>
+	template<typename Job>
+	auto submit(Job&& jobIn) -> std::future<std::invoke_result_t<std::decay_t<Job>>>
+	{
+		using Result = std::invoke_result_t<std::decay_t<Job>>;
+
+		// std::function needs a copyable target, so the task is shared
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(jobIn));
+		std::future<Result> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_jobs.emplace_back([task]() { (*task)(); });
+		}
+		m_signal.notify_one();
+		return result;
+	}
+
+
+
+	/// <summary>
+	/// Gets the number of worker threads
+	/// </summary>
+	/// <returns></returns>
+	unsigned int size() const { return static_cast<unsigned int>(m_workers.size()); }
+
+
+
+private:
+
+	void loop();
+
+
+
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_lock;
+
+	std::condition_variable m_signal;
+
+	std::deque<std::function<void()>> m_jobs;
+
+	bool m_quit = false;
+};
+
+
+#endif /* ThreadPool_H_ */
+
+
+
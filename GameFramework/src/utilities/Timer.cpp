@@ -1,13 +1,10 @@
-#include <SDL.h>
-#include <ctime>
-
 #include "Timer.h"
 
 
 
 
 Timer::Timer()
-	: m_tickStart(0), m_stopped(true)
+	: m_tickStart(), m_stopped(true)
 {}
 
 
@@ -15,7 +12,7 @@ Timer::Timer()
 void Timer::start() 
 {
 	m_stopped = false;
-	m_tickStart = SDL_GetTicks();
+	m_tickStart = Clock::now();
 }
 
 
@@ -23,21 +20,41 @@ void Timer::start()
 void Timer::stop() 
 {
 	m_stopped = true;
-	m_tickStart = 0;
+	m_tickStart = Clock::time_point();
 }
 
 
 
 float Timer::getSec() const 
 {
-	return getMil()/1000.0f;
+	return static_cast<float>(getElapsed());
 }
 
 
 
 unsigned int Timer::getMil() const 
 {
-	return m_stopped ? 0 : SDL_GetTicks() - m_tickStart;
+	return m_stopped ? 0 : static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_tickStart).count());
+}
+
+
+
+double Timer::getElapsed() const
+{
+	return m_stopped ? 0.0 : std::chrono::duration<double>(Clock::now() - m_tickStart).count();
+}
+
+
+
+double Timer::lap()
+{
+	if (m_stopped)
+		return 0.0;
+
+	const Clock::time_point now = Clock::now();
+	const double elapsed = std::chrono::duration<double>(now - m_tickStart).count();
+	m_tickStart = now;
+	return elapsed;
 }
 
 
@@ -3,6 +3,7 @@
 
 
 #include <stdint.h>
+#include <chrono>
 
 
 class Timer 
@@ -14,7 +15,7 @@ public:
 
 
 	/// <summary>
-	/// Starts this Timer that measures the number of ticks in milliseconds
+	/// Starts this Timer, which measures time with the highest resolution steady clock available
 	/// </summary>
 	void start();
 
@@ -43,11 +44,27 @@ public:
 
 
 
+	/// <summary>
+	/// Gets the number of seconds since this Timer was started without rounding to milliseconds
+	/// </summary>
+	/// <returns></returns>
+	double getElapsed() const;
+
+
+
+	/// <summary>
+	/// Gets the number of seconds since this Timer was started and then starts it again from that same instant, so no time is lost between laps
+	/// </summary>
+	/// <returns></returns>
+	double lap();
+
+
+
 	/// <summary>
 	/// Checks if this Timer is currently running
 	/// </summary>
 	/// <returns></returns>
-	bool isRunning() const { return m_stopped; }
+	bool isRunning() const { return !m_stopped; }
 
 
 
@@ -57,7 +74,11 @@ public:
 
 private:
 
-	unsigned int m_tickStart;
+	using Clock = std::chrono::steady_clock;
+
+
+
+	Clock::time_point m_tickStart;
 
 	bool m_stopped;
 };
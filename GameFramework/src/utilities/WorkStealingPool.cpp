@@ -0,0 +1,146 @@
+#include "utilities/WorkStealingPool.h"
+
+
+
+
+/// <summary>
+/// The pool and queue of the worker running on this thread
+/// </summary>
+static thread_local const WorkStealingPool* s_pool = nullptr;
+
+static thread_local size_t s_queue = 0;
+
+
+
+WorkStealingPool::WorkStealingPool(unsigned int numberOfThreadsIn)
+{
+	unsigned int numberOfThreads = numberOfThreadsIn;
+	if (numberOfThreads == 0)
+		numberOfThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+	for (unsigned int i = 0; i <= numberOfThreads; i++)
+		m_queues.push_back(std::make_unique<Queue>());
+
+	m_workers.reserve(numberOfThreads);
+	for (unsigned int i = 0; i < numberOfThreads; i++)
+		m_workers.emplace_back(&WorkStealingPool::loop, this, static_cast<size_t>(i));
+}
+
+
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepLock);
+		m_quit = true;
+	}
+	m_signal.notify_all();
+
+	for (std::thread& worker : m_workers)
+		worker.join();
+}
+
+
+
+void WorkStealingPool::submit(std::function<void()> jobIn)
+{
+	// The count is raised under the sleep lock so a worker can not miss it between checking and going to sleep, and before 
+	// the job can be seen so a thread that takes the job straight away never lowers the count below zero
+	{
+		std::lock_guard<std::mutex> lock(m_sleepLock);
+		m_queued++;
+	}
+
+	Queue& queue = *m_queues[ownQueue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.lock);
+		queue.jobs.push_back(std::move(jobIn));
+	}
+	m_signal.notify_one();
+	m_finished.notify_all();
+}
+
+
+
+void WorkStealingPool::wait(const std::atomic<size_t>& counterIn)
+{
+	const size_t queue = ownQueue();
+	while (counterIn > 0)
+	{
+		if (runOne(queue))
+			continue;
+
+		// Nothing to take means the last jobs are running on other threads, so this sleeps until one of them finishes
+		std::unique_lock<std::mutex> lock(m_sleepLock);
+		m_finished.wait(lock, [this, &counterIn]() { return counterIn == 0 || m_queued > 0; });
+	}
+}
+
+
+
+void WorkStealingPool::loop(size_t indexIn)
+{
+	s_pool = this;
+	s_queue = indexIn;
+	while (true)
+	{
+		if (runOne(indexIn))
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_sleepLock);
+		m_signal.wait(lock, [this]() { return m_quit || m_queued > 0; });
+		if (m_quit)
+			return;
+	}
+}
+
+
+
+bool WorkStealingPool::runOne(size_t indexIn)
+{
+	std::function<void()> job;
+	{
+		// The newest job on a thread's own queue is the one most likely to still be in its cache
+		Queue& own = *m_queues[indexIn];
+		std::lock_guard<std::mutex> lock(own.lock);
+		if (!own.jobs.empty())
+		{
+			job = std::move(own.jobs.back());
+			own.jobs.pop_back();
+		}
+	}
+
+	for (size_t i = 1; !job && i < m_queues.size(); i++)
+	{
+		Queue& other = *m_queues[(indexIn + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(other.lock);
+		if (!other.jobs.empty())
+		{
+			job = std::move(other.jobs.front());
+			other.jobs.pop_front();
+		}
+	}
+
+	if (!job)
+		return false;
+
+	m_queued--;
+	job();
+
+	// The job lowers its counter itself, so the waiting threads are woken once it has returned
+	{
+		std::lock_guard<std::mutex> lock(m_sleepLock);
+	}
+	m_finished.notify_all();
+	return true;
+}
+
+
+
+size_t WorkStealingPool::ownQueue() const
+{
+	return s_pool == this ? s_queue : m_queues.size() - 1;
+}
+
+
+
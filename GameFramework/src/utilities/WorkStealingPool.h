@@ -0,0 +1,175 @@
+#ifndef WorkStealingPool_H_
+#define WorkStealingPool_H_
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+
+
+
+/// <summary>
+/// Worker threads that each run jobs from their own queue and take jobs from the other queues once theirs is empty
+/// <para>
+/// Jobs submitted from a worker go on that worker's queue, so work that splits itself stays on the thread that made it
+/// until another thread runs out of work. A thread that waits for jobs to finish runs queued jobs while it waits, so 
+/// jobs can wait on the jobs they submit without using up the workers
+/// </para>
+/// </summary>
+class WorkStealingPool
+{
+public:
+
+	/// <summary>
+	/// Starts the given number of worker threads, or one less than the number of hardware threads if none is given
+	/// <para>The thread that waits on the pool makes up the last hardware thread</para>
+	/// </summary>
+	/// <param name="numberOfThreadsIn"></param>
+	explicit WorkStealingPool(unsigned int numberOfThreadsIn = 0);
+
+
+
+	WorkStealingPool(const WorkStealingPool& other) = delete;
+
+
+
+	WorkStealingPool(WorkStealingPool&& other) = delete;
+
+
+
+	/// <summary>
+	/// Finishes the jobs that have already started and stops every worker thread, jobs that have not started are dropped
+	/// </summary>
+	~WorkStealingPool();
+
+
+
+	/// <summary>
+	/// Queues a job, on the calling worker's own queue if it is called from a worker
+	/// </summary>
+	/// <param name="jobIn"></param>
+	void submit(std::function<void()> jobIn);
+
+
+
+	/// <summary>
+	/// Runs queued jobs on the calling thread until the given counter reaches zero, sleeping while there is nothing to take
+	/// </summary>
+	/// <param name="counterIn">Specifies the number of jobs that are left, each job lowers it once it has finished</param>
+	void wait(const std::atomic<size_t>& counterIn);
+
+
+
+	/// <summary>
+	/// Calls the given function over the range [0, countIn) in chunks, spread across the worker threads and the calling thread
+	/// </summary>
+	/// <typeparam name="Function">void(size_t begin, size_t end)</typeparam>
+	/// <param name="countIn">Specifies the size of the range</param>
+	/// <param name="chunkSizeIn">Specifies the smallest number of items each call is given</param>
+	/// <param name="functionIn"></param>
+	template<typename Function>
+	void parallelFor(size_t countIn, size_t chunkSizeIn, Function&& functionIn)
+	{
+		if (countIn == 0)
+			return;
+
+		// Each thread gets a few chunks so threads that finish early can take work from threads that do not
+		const size_t threads = static_cast<size_t>(size()) + 1;
+		const size_t chunkSize = std::max(std::max(chunkSizeIn, static_cast<size_t>(1)), (countIn + threads * 4 - 1) / (threads * 4));
+		const size_t numberOfChunks = (countIn + chunkSize - 1) / chunkSize;
+		if (numberOfChunks == 1)
+		{
+			functionIn(static_cast<size_t>(0), countIn);
+			return;
+		}
+
+		std::atomic<size_t> remaining{ numberOfChunks - 1 };
+		for (size_t chunk = 1; chunk < numberOfChunks; chunk++)
+		{
+			const size_t begin = chunk * chunkSize;
+			const size_t end = std::min(begin + chunkSize, countIn);
+			submit([&functionIn, &remaining, begin, end]()
+				{
+					functionIn(begin, end);
+					remaining--;
+				});
+		}
+
+		functionIn(static_cast<size_t>(0), std::min(chunkSize, countIn));
+		wait(remaining);
+	}
+
+
+
+	/// <summary>
+	/// Gets the number of worker threads
+	/// </summary>
+	/// <returns></returns>
+	unsigned int size() const { return static_cast<unsigned int>(m_workers.size()); }
+
+
+
+private:
+
+	struct Queue
+	{
+		std::mutex lock;
+
+		std::deque<std::function<void()>> jobs;
+	};
+
+
+
+	void loop(size_t indexIn);
+
+
+
+	/// <summary>
+	/// Runs one job, the newest job from the given queue or the oldest job from any other queue
+	/// </summary>
+	/// <param name="indexIn">Specifies the calling thread's own queue</param>
+	/// <returns>True if a job was run</returns>
+	bool runOne(size_t indexIn);
+
+
+
+	/// <summary>
+	/// Gets the calling thread's queue, threads that are not workers share the last queue
+	/// </summary>
+	/// <returns></returns>
+	size_t ownQueue() const;
+
+
+
+	std::vector<std::thread> m_workers;
+
+	/// <summary>
+	/// One queue per worker, then one queue for every other thread
+	/// </summary>
+	std::vector<std::unique_ptr<Queue>> m_queues;
+
+	std::atomic<size_t> m_queued{ 0 };
+
+	std::mutex m_sleepLock;
+
+	std::condition_variable m_signal;
+
+	/// <summary>
+	/// Wakes the threads waiting on a counter whenever a job is queued or finishes, it uses the sleep lock
+	/// </summary>
+	std::condition_variable m_finished;
+
+	std::atomic<bool> m_quit{ false };
+};
+
+
+#endif /* WorkStealingPool_H_ */
+
+
+
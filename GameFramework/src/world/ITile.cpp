@@ -3,15 +3,16 @@
 
 
 
-ITile::ITile(double x, double y, double w, double h, const Pos2N& spriteIn, EnumSide direction, bool opaqueIn, bool solidIn)
-	: m_pos(x, y), m_boundingBox(x, y, x + w, y + h), m_isOpaque(opaqueIn), m_isSolid(solidIn), m_passable(direction), m_sprite(spriteIn.u, spriteIn.v) 
+ITile::ITile(unsigned int spriteIn, EnumSide direction, bool opaqueIn, bool solidIn)
+	: m_sprite(static_cast<uint16_t>(spriteIn)), 
+	m_flags(static_cast<uint8_t>((opaqueIn ? OPAQUE_FLAG : 0) | (solidIn ? SOLID_FLAG : 0) | (static_cast<uint8_t>(direction) << PASSABLE_SHIFT)))
 {}
 
 
 
 bool ITile::canCollide() const 
 {
-	return m_isSolid;
+	return (m_flags & SOLID_FLAG) != 0;
 }
 
 
@@ -23,7 +24,7 @@ bool ITile::canCollide() const
  */
 void ITile::setCollide(bool stateIn) 
 {
-	m_isSolid = stateIn;
+	m_flags = static_cast<uint8_t>(stateIn ? (m_flags | SOLID_FLAG) : (m_flags & ~SOLID_FLAG));
 }
 
 
@@ -31,7 +32,7 @@ void ITile::setCollide(bool stateIn)
 //Checks if this Tile can be rendered
 bool ITile::isOpaque() const 
 {
-	return m_isOpaque;
+	return (m_flags & OPAQUE_FLAG) != 0;
 }
 
 
@@ -43,7 +44,7 @@ bool ITile::isOpaque() const
  */
 void ITile::setOpaque(bool stateIn)
 {
-	m_isOpaque = stateIn;
+	m_flags = static_cast<uint8_t>(stateIn ? (m_flags | OPAQUE_FLAG) : (m_flags & ~OPAQUE_FLAG));
 }
 
 
@@ -57,7 +58,7 @@ void ITile::setOpaque(bool stateIn)
  */
 bool ITile::isPassable(EnumSide direction) const 
 {
-	return m_passable == direction;
+	return static_cast<EnumSide>((m_flags & PASSABLE_MASK) >> PASSABLE_SHIFT) == direction;
 }
 
 
@@ -69,7 +70,7 @@ bool ITile::isPassable(EnumSide direction) const
  */
 bool ITile::isImpassable() const
 {
-	return m_passable == EnumSide::NONE;
+	return isPassable(EnumSide::NONE);
 }
 
 
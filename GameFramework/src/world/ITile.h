@@ -4,33 +4,42 @@
 
 
 
-#include "utilities/physics/AxisAlignedBB.h"
-#include "utilities/math/Pos2.hpp"
-#include "utilities/physics/TilePos.h"
+#include <cstdint>
 
+#include "utilities/physics/EnumSide.h"
 
 
 
+
+/*
+ * A compact tile record, the sprite and a bitfield of the tile's flags
+ *
+ * A Tile does not know where it is, its position and bounding box are worked out
+ * from its grid coordinates by the TileMap that holds it
+ */
 class ITile 
 {
 public:
 
-	ITile(double x, double y, double w, double h, const Pos2N& spriteIn, EnumSide direction, bool opaqueIn, bool solidIn);
+	ITile() = default;
 
 
 
-	//Gets this Tile's current position in Global-Space
-	const TilePos& getPos() const { return m_pos; }
+	ITile(unsigned int spriteIn, EnumSide direction, bool opaqueIn, bool solidIn);
 
 
 
-	//Gets this Tile's axis aligned bounding box
-	const AxisAlignedBB& getAabb() const { return m_boundingBox; }
+	//Gets this Tile's current sprite
+	unsigned int getSprite() const { return m_sprite; }
 
 
 
-	//Gets this Tile's current sprite
-	const Pos2N& getSprite() const { return m_sprite; }
+	/*
+	 * @param	spriteIn The Tile's new sprite
+	 *
+	 * Sets this Tile's sprite, the TileMap that holds it must be told that it has changed
+	 */
+	void setSprite(unsigned int spriteIn) { m_sprite = static_cast<uint16_t>(spriteIn); }
 
 
 
@@ -84,20 +93,33 @@ public:
 
 private:
 
-	TilePos m_pos;
+	static constexpr uint8_t OPAQUE_FLAG = 1 << 0;
+
+	static constexpr uint8_t SOLID_FLAG = 1 << 1;
+
+	static constexpr int PASSABLE_SHIFT = 2;
 
-	AxisAlignedBB m_boundingBox;
+	static constexpr uint8_t PASSABLE_MASK = 0x7 << PASSABLE_SHIFT;
 
-	bool m_isOpaque;
 
-	bool m_isSolid;
 
-	EnumSide m_passable;
+	uint16_t m_sprite = 0;
 
-	Pos2N m_sprite;
+	/*
+	 * Bit 0 is opaque, bit 1 is solid, and bits 2-4 hold the passable side
+	 */
+	uint8_t m_flags = 0;
+
+	/*
+	 * Keeps the padding byte zeroed since tiles are written to binary map files as they are
+	 */
+	uint8_t m_reserved = 0;
 };
 
 
+static_assert(sizeof(ITile) == 4, "A tile record should stay 4 bytes");
+
+
 #endif
 
 
@@ -0,0 +1,201 @@
+#include <fstream>
+#include <cstring>
+
+#include "world/MapFile.h"
+
+
+
+
+bool MapFile::isBinary(const std::filesystem::path& filepathIn)
+{
+	return filepathIn.extension() == BINARY_EXTENSION;
+}
+
+
+
+bool MapFile::readText(const std::filesystem::path& filepathIn, MapFileHeader& headerOut, std::vector<ITile>& tilesOut, std::string& errorOut)
+{
+	std::ifstream mapFile(filepathIn);
+	if (!mapFile.is_open())
+	{
+		errorOut = "unable to open the file";
+		return false;
+	}
+
+	std::memset(&headerOut, 0, sizeof(headerOut));
+	std::memcpy(headerOut.magic, MAGIC, sizeof(MAGIC));
+	headerOut.version = VERSION;
+	headerOut.numberOfLayers = 1;
+	headerOut.compression = static_cast<uint32_t>(Compression::None);
+
+	//Read the map size from the file
+	mapFile>>headerOut.width>>headerOut.height;
+	if (mapFile.fail() || headerOut.width < 0 || headerOut.height < 0)
+	{
+		errorOut = "unable to read element 'MAPSIZE'";
+		return false;
+	}
+
+	//Read the tile size from the file
+	mapFile>>headerOut.tileWidth>>headerOut.tileHeight;
+	if (mapFile.fail() || headerOut.tileWidth <= 0 || headerOut.tileHeight <= 0)
+	{
+		errorOut = "unable to read element 'TILESIZE'";
+		return false;
+	}
+
+	//Every tile exists from the start, tiles that fail to load are left as empty, non-opaque tiles
+	tilesOut.assign(numberOfTiles(headerOut), ITile());
+	for (ITile& tile : tilesOut)
+	{
+		int sprite = 0;
+		mapFile>>sprite;
+		if (mapFile.fail())
+		{
+			errorOut = "unable to read element 'TILESPRITE'";
+			return false;
+		}
+
+		tile = ITile(static_cast<unsigned int>(sprite), EnumSide::NONE, true, sprite > 1);
+	}
+
+	return true;
+}
+
+
+
+bool MapFile::readBinary(void* dataIn, size_t sizeIn, MapFileHeader& headerOut, ITile*& tilesOut, std::string& errorOut)
+{
+	if (dataIn == nullptr || sizeIn < sizeof(MapFileHeader))
+	{
+		errorOut = "the file is too small to hold a header";
+		return false;
+	}
+
+	std::memcpy(&headerOut, dataIn, sizeof(headerOut));
+	if (!validateHeader(headerOut, sizeIn, errorOut))
+		return false;
+
+	tilesOut = reinterpret_cast<ITile*>(static_cast<unsigned char*>(dataIn) + sizeof(MapFileHeader));
+	return true;
+}
+
+
+
+bool MapFile::readHeader(const std::filesystem::path& filepathIn, MapFileHeader& headerOut, std::string& errorOut)
+{
+	std::ifstream mapFile(filepathIn, std::ios::binary);
+	if (!mapFile.is_open())
+	{
+		errorOut = "unable to open the file";
+		return false;
+	}
+
+	std::error_code sizeError;
+	const uintmax_t size = std::filesystem::file_size(filepathIn, sizeError);
+	if (sizeError || size < sizeof(MapFileHeader) || !mapFile.read(reinterpret_cast<char*>(&headerOut), sizeof(headerOut)))
+	{
+		errorOut = "the file is too small to hold a header";
+		return false;
+	}
+
+	return validateHeader(headerOut, static_cast<size_t>(size), errorOut);
+}
+
+
+
+bool MapFile::writeBinary(const std::filesystem::path& filepathIn, const MapFileHeader& headerIn, const ITile* tilesIn, std::string& errorOut)
+{
+	MapFileHeader header = headerIn;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.compression = static_cast<uint32_t>(Compression::None);
+
+	std::ofstream mapFile(filepathIn, std::ios::binary | std::ios::trunc);
+	if (!mapFile.is_open())
+	{
+		errorOut = "unable to open the file";
+		return false;
+	}
+
+	mapFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	mapFile.write(reinterpret_cast<const char*>(tilesIn), static_cast<std::streamsize>(numberOfTiles(header) * sizeof(ITile)));
+	if (mapFile.fail())
+	{
+		errorOut = "unable to write the file";
+		return false;
+	}
+
+	return true;
+}
+
+
+
+size_t MapFile::tileOffset(const MapFileHeader& headerIn, int x, int y, int layer)
+{
+	const size_t index = (static_cast<size_t>(layer) * headerIn.height + y) * headerIn.width + x;
+	return sizeof(MapFileHeader) + index * sizeof(ITile);
+}
+
+
+
+bool MapFile::validateHeader(const MapFileHeader& headerIn, size_t sizeIn, std::string& errorOut)
+{
+	if (sizeIn < sizeof(MapFileHeader))
+	{
+		errorOut = "the file is too small to hold a header";
+		return false;
+	}
+
+	if (std::memcmp(headerIn.magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		errorOut = "the file is not a binary map";
+		return false;
+	}
+
+	if (headerIn.version != VERSION)
+	{
+		errorOut = "unsupported version " + std::to_string(headerIn.version);
+		return false;
+	}
+
+	if (headerIn.compression != static_cast<uint32_t>(Compression::None))
+	{
+		errorOut = "unsupported compression " + std::to_string(headerIn.compression);
+		return false;
+	}
+
+	if (headerIn.width < 0 || headerIn.height < 0 || headerIn.numberOfLayers == 0)
+	{
+		errorOut = "the map's size is not valid";
+		return false;
+	}
+
+	// Tile positions are found by dividing by the tile size
+	if (headerIn.tileWidth <= 0 || headerIn.tileHeight <= 0)
+	{
+		errorOut = "the map's tile size is not valid";
+		return false;
+	}
+
+	// The tiles are compared by division so a corrupt header can not overflow the number of bytes it needs
+	const size_t maxTiles = (sizeIn - sizeof(MapFileHeader)) / sizeof(ITile);
+	const size_t tilesPerLayer = static_cast<size_t>(headerIn.width) * static_cast<size_t>(headerIn.height);
+	if (tilesPerLayer > maxTiles || (tilesPerLayer > 0 && headerIn.numberOfLayers > maxTiles / tilesPerLayer))
+	{
+		errorOut = "the file is too small to hold every tile";
+		return false;
+	}
+
+	return true;
+}
+
+
+
+size_t MapFile::numberOfTiles(const MapFileHeader& headerIn)
+{
+	return static_cast<size_t>(headerIn.width) * static_cast<size_t>(headerIn.height) * headerIn.numberOfLayers;
+}
+
+
+
@@ -0,0 +1,180 @@
+#ifndef MapFile_H_
+#define MapFile_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "world/ITile.h"
+
+
+
+
+/// <summary>
+/// The header at the start of a binary map file
+/// <para>
+/// It is followed by the tile records of each layer, every layer is stored row by row and holds width * height records. 
+/// All values are little-endian
+/// </para>
+/// </summary>
+struct MapFileHeader
+{
+	char magic[4];
+
+	uint32_t version;
+
+	int32_t width;
+
+	int32_t height;
+
+	int32_t tileWidth;
+
+	int32_t tileHeight;
+
+	uint32_t numberOfLayers;
+
+	/// <summary>
+	/// How the tile records are compressed, see MapFile::Compression
+	/// </summary>
+	uint32_t compression;
+};
+
+
+static_assert(sizeof(MapFileHeader) == 32, "The map file header is part of the file format and must not change size");
+
+
+
+/// <summary>
+/// Reads and writes the binary map format and reads the older text map format
+/// <para>
+/// A binary map's tile records are laid out exactly like TileMap's tile storage, so a mapped file is used in place without 
+/// being parsed or copied
+/// </para>
+/// </summary>
+class MapFile
+{
+public:
+
+	enum class Compression : uint32_t
+	{
+		None = 0,
+
+		/// <summary>
+		/// Reserved for LZ4 compressed chunks, which are not supported yet
+		/// </summary>
+		LZ4 = 1
+	};
+
+
+
+	static constexpr char MAGIC[4] = { 'G', 'F', 'M', 'B' };
+
+	static constexpr uint32_t VERSION = 1;
+
+	/// <summary>
+	/// The file extension of binary maps, any other extension is read as a text map
+	/// </summary>
+	static constexpr const char* BINARY_EXTENSION = ".gmap";
+
+
+
+	MapFile() = delete;
+
+
+
+	/// <summary>
+	/// Checks if the given file is a binary map by its extension
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <returns></returns>
+	static bool isBinary(const std::filesystem::path& filepathIn);
+
+
+
+	/// <summary>
+	/// Reads a map in the text format, which is the map size, the tile size, then one sprite index per tile
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="headerOut">Filled in with the map's sizes, the text format always has one layer</param>
+	/// <param name="tilesOut">Filled in with the map's tiles, row by row</param>
+	/// <param name="errorOut">Describes what went wrong when the map could not be read</param>
+	/// <returns>True if the whole map was read</returns>
+	static bool readText(const std::filesystem::path& filepathIn, MapFileHeader& headerOut, std::vector<ITile>& tilesOut, std::string& errorOut);
+
+
+
+	/// <summary>
+	/// Checks that the given memory holds a complete binary map and finds its tile records
+	/// </summary>
+	/// <param name="dataIn">Specifies the start of the map file</param>
+	/// <param name="sizeIn">Specifies the size of the map file, measured in bytes</param>
+	/// <param name="headerOut">Filled in with a copy of the map's header</param>
+	/// <param name="tilesOut">Points to the first tile record of the first layer, inside of the given memory</param>
+	/// <param name="errorOut">Describes what went wrong when the map is not valid</param>
+	/// <returns>True if the map is valid</returns>
+	static bool readBinary(void* dataIn, size_t sizeIn, MapFileHeader& headerOut, ITile*& tilesOut, std::string& errorOut);
+
+
+
+	/// <summary>
+	/// Reads and checks only the header of a binary map, for maps whose tiles are read a piece at a time
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="headerOut">Filled in with a copy of the map's header</param>
+	/// <param name="errorOut">Describes what went wrong when the map is not valid</param>
+	/// <returns>True if the map is valid</returns>
+	static bool readHeader(const std::filesystem::path& filepathIn, MapFileHeader& headerOut, std::string& errorOut);
+
+
+
+	/// <summary>
+	/// Writes a binary map
+	/// </summary>
+	/// <param name="filepathIn"></param>
+	/// <param name="headerIn">Specifies the map's sizes, the magic, version, and compression are filled in</param>
+	/// <param name="tilesIn">Specifies every layer's tile records, one after the other</param>
+	/// <param name="errorOut">Describes what went wrong when the map could not be written</param>
+	/// <returns>True if the map was written</returns>
+	static bool writeBinary(const std::filesystem::path& filepathIn, const MapFileHeader& headerIn, const ITile* tilesIn, std::string& errorOut);
+
+
+
+	/// <summary>
+	/// Gets the number of tile records in a map with the given header
+	/// </summary>
+	/// <param name="headerIn"></param>
+	/// <returns></returns>
+	static size_t numberOfTiles(const MapFileHeader& headerIn);
+
+
+
+	/// <summary>
+	/// Gets the offset of a tile record from the start of a binary map, measured in bytes
+	/// </summary>
+	/// <param name="headerIn"></param>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	/// <param name="layer">Specifies the layer</param>
+	/// <returns></returns>
+	static size_t tileOffset(const MapFileHeader& headerIn, int x, int y, int layer);
+
+
+
+private:
+
+	/// <summary>
+	/// Checks that a binary map's header is supported and that a file of the given size can hold all of its tiles
+	/// </summary>
+	/// <param name="headerIn"></param>
+	/// <param name="sizeIn">Specifies the size of the whole file, measured in bytes</param>
+	/// <param name="errorOut"></param>
+	/// <returns></returns>
+	static bool validateHeader(const MapFileHeader& headerIn, size_t sizeIn, std::string& errorOut);
+};
+
+
+#endif /* MapFile_H_ */
+
+
+
@@ -1,19 +1,51 @@
 #include <iostream>
-#include <sstream>
-#include <fstream>
+#include <algorithm>
 
 #include "world/TileMap.h"
+#include "world/MapFile.h"
+#include "utilities/AssetCache.h"
+#include "renderer/screen/Camera.h"
 #include "utilities/math/Pos2.hpp"
 #include "utilities/physics/TilePos.h"
 
 
 
 
-TileMap::TileMap(const std::string &tagIn, const std::string &filePath)
-	: m_tag(tagIn), m_sizeMap(), m_sizeTile() 
+static uint32_t s_nextTileMapID = 1;
+
+
+
+TileMap::TileMap(const std::string &tagIn, const std::string &filePath, AssetCache* cacheIn)
+	: m_tag(tagIn), m_id(s_nextTileMapID++), m_sizeMap(), m_sizeTile() 
 {
 	m_logger = Loggers::getLog();
-	this->buildTileMap(filePath);
+	this->buildTileMap(filePath, cacheIn);
+}
+
+
+
+TileMap::TileMap(const std::string& tagIn, const std::string& filePath, const WorldStreamer::Settings& settingsIn)
+	: m_tag(tagIn), m_id(s_nextTileMapID++), m_sizeMap(), m_sizeTile()
+{
+	m_logger = Loggers::getLog();
+	if (!MapFile::isBinary(filePath))
+	{
+		m_logger->warn("Only binary maps can be streamed, world '{0}' will be loaded all at once", m_tag);
+		this->buildTileMap(filePath);
+		return;
+	}
+
+	MapFileHeader header;
+	std::string error;
+	if (!MapFile::readHeader(filePath, header, error))
+	{
+		m_logger->error("Unable to read map '{0}' at '{1}': {2}", m_tag, filePath, error);
+		return;
+	}
+
+	this->setSize(header);
+	m_streamer = std::make_unique<WorldStreamer>(filePath, header, settingsIn);
+	m_logger->info("World '{0}' is being streamed from '{1}'", m_tag, filePath);
 }
 
 
@@ -83,10 +115,41 @@ ITile* TileMap::getTile(const TilePos& posIn)
 
 ITile* TileMap::getTile(int x, int y) 
 {
-	if (x < 0 || x > this->width() || y < 0 || y > this->height()) 
+	return this->getTile(x, y, 0);
+}
+
+
+
+const ITile* TileMap::getTile(int x, int y) const
+{
+	return this->getTile(x, y, 0);
+}
+
+
+
+ITile* TileMap::getTile(int x, int y, int layer)
+{
+	return const_cast<ITile*>(static_cast<const TileMap*>(this)->getTile(x, y, layer));
+}
+
+
+
+const ITile* TileMap::getTile(int x, int y, int layer) const
+{
+	if (x < 0 || x >= this->width() || y < 0 || y >= this->height() || layer < 0 || layer >= m_numberOfLayers) 
 		return nullptr;
-	auto itr = m_tileMap.find({x, y});
-	return itr == m_tileMap.end() ? nullptr : &itr->second;
+
+	if (m_streamer)
+	{
+		const ITile* region = m_streamer->getRegion(static_cast<size_t>(y / CHUNK_SIZE) * m_sizeChunks.w + x / CHUNK_SIZE);
+		if (region == nullptr)
+			return nullptr;
+		return &region[(static_cast<size_t>(layer) * CHUNK_SIZE + y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE];
+	}
+
+	if (m_tiles == nullptr)
+		return nullptr;
+	return &m_tiles[(static_cast<size_t>(layer) * m_sizeMap.h + y) * m_sizeMap.w + x];
 }
 
 
@@ -121,69 +184,177 @@ ITile* TileMap::getOffsetTile(const TilePos& posIn, EnumSide direction)
 
 
 
-void TileMap::buildTileMap(const std::string &filePath)
+TilePos TileMap::getTilePos(int x, int y) const
 {
-	m_logger->info("Building World '{0}' at ''", m_tag, filePath);
+	return TilePos(x * static_cast<double>(m_sizeTile.w), y * static_cast<double>(m_sizeTile.h));
+}
+
 
-	std::ifstream mapFile(filePath);
-	if (!mapFile.is_open())
+
+AxisAlignedBB TileMap::getTileAabb(int x, int y) const
+{
+	double minX = x * static_cast<double>(m_sizeTile.w);
+	double minY = y * static_cast<double>(m_sizeTile.h);
+	return AxisAlignedBB(minX, minY, minX + m_sizeTile.w, minY + m_sizeTile.h);
+}
+
+
+
+void TileMap::setTileSprite(int x, int y, unsigned int spriteIn)
+{
+	ITile* tile = this->getTile(x, y);
+	if (tile == nullptr)
 	{
-		m_logger->error("Unable to load/find map '{0}' at '{1}'", m_tag, filePath);
+		m_logger->warn("Unable to set the sprite of tile ({0}, {1}) in world '{2}', it does not exist", x, y, m_tag);
 		return;
 	}
 
-	//Read the map size from the file
-	int mapWidth = 0;
-	mapFile>>mapWidth;
-	m_sizeMap.w = mapWidth;
-	int mapHeight = 0;
-	mapFile>>mapHeight;
-	m_sizeMap.h = mapHeight;
-	if (mapFile.fail()) 
-		m_logger->error("Unable to read map '{0}' at '{1}' in element 'MAPSIZE'", m_tag, filePath);
-
-	//Read the tile size from the file
-	int tileWidth = 0;
-	mapFile>>tileWidth;
-	m_sizeTile.w = tileWidth;
-	int tileHeight = 0;
-	mapFile>>tileHeight;
-	m_sizeTile.h = tileHeight;
-	if (mapFile.fail()) 
-		m_logger->error("Unable to read map '{0}' at '{1}' in element 'TILESIZE'", m_tag, filePath);
-
-	//Read the tile and add it to the tile map
-	for (int y = 0; y < m_sizeMap.h; y++) 
+	tile->setSprite(spriteIn);
+	this->markTileChanged(x, y);
+}
+
+
+
+void TileMap::markTileChanged(int x, int y)
+{
+	if (x < 0 || x >= this->width() || y < 0 || y >= this->height())
+		return;
+
+	const size_t index = static_cast<size_t>(y / CHUNK_SIZE) * m_sizeChunks.w + x / CHUNK_SIZE;
+	m_chunkRevisions[index]++;
+	if (m_streamer)
+		m_streamer->markChanged(index);
+}
+
+
+
+void TileMap::markChunkArrived(int chunkX, int chunkY)
+{
+	if (chunkX < 0 || chunkX >= m_sizeChunks.w || chunkY < 0 || chunkY >= m_sizeChunks.h)
+		return;
+
+	m_chunkRevisions[static_cast<size_t>(chunkY) * m_sizeChunks.w + chunkX]++;
+}
+
+
+
+bool TileMap::isChunkLoaded(int chunkX, int chunkY) const
+{
+	if (chunkX < 0 || chunkX >= m_sizeChunks.w || chunkY < 0 || chunkY >= m_sizeChunks.h)
+		return false;
+
+	if (m_streamer)
+		return m_streamer->getRegion(static_cast<size_t>(chunkY) * m_sizeChunks.w + chunkX) != nullptr;
+	return m_tiles != nullptr;
+}
+
+
+
+void TileMap::stream(const Camera& cameraIn)
+{
+	if (m_streamer)
+		m_streamer->update(*this, cameraIn.getVisibleMin(), cameraIn.getVisibleMax());
+}
+
+
+
+uint32_t TileMap::chunkRevision(int chunkX, int chunkY) const
+{
+	if (chunkX < 0 || chunkX >= m_sizeChunks.w || chunkY < 0 || chunkY >= m_sizeChunks.h)
+		return 0;
+
+	return m_chunkRevisions[static_cast<size_t>(chunkY) * m_sizeChunks.w + chunkX];
+}
+
+
+
+void TileMap::buildTileMap(const std::string &filePath, AssetCache* cacheIn)
+{
+	m_logger->info("Building World '{0}' at '{1}'", m_tag, filePath);
+
+	MapFileHeader header;
+	std::string error;
+	uint64_t key = 0;
+	std::vector<unsigned char> source;
+	std::filesystem::path entry;
+	if (cacheIn && !MapFile::isBinary(filePath) && AssetCache::readFile(filePath, source))
 	{
-		for (int x = 0; x < m_sizeMap.w; x++) 
+		// A text map that has been converted before is mapped from its binary copy in the cache instead of being parsed
+		key = AssetCache::hash(source.data(), source.size());
+		ITile* tiles = nullptr;
+		if (cacheIn->find("maps", key, entry) && m_mappedFile.open(entry, MappedFile::Access::CopyOnWrite))
 		{
-			bool opaque = true;
-			bool solid = false;
-			EnumSide pass = EnumSide::NONE;
-			Pos2N sprite(0, 0);
-
-			int index = 0;
-			mapFile>>index;
-			sprite.w = index;
-			if (mapFile.fail()) 
+			if (MapFile::readBinary(m_mappedFile.data(), m_mappedFile.size(), header, tiles, error))
 			{
-				m_logger->error("Unable to read map '{0}' at '{1}' in element 'TILESPRITE'", m_tag, filePath);
+				m_tiles = tiles;
+				this->setSize(header);
+				m_logger->info("World '{0}' has been built from the asset cache", m_tag);
 				return;
 			}
+			m_mappedFile.close();
+		}
+	}
+
+	if (MapFile::isBinary(filePath))
+	{
+		// The tile records are used straight from the mapped file, pages are only copied if a tile is changed
+		ITile* tiles = nullptr;
+		if (!m_mappedFile.open(filePath, MappedFile::Access::CopyOnWrite))
+		{
+			m_logger->error("Unable to load/find map '{0}' at '{1}'", m_tag, filePath);
+			return;
+		}
 
-			if (sprite.w > 1) 
-				solid = true;
-			m_tileMap.insert({
-				{ x, y }, 
-				ITile(x * static_cast<double>(m_sizeTile.w), y * static_cast<double>(m_sizeTile.h), m_sizeTile.w, m_sizeTile.h, sprite, pass, opaque, solid)
-			});
+		if (!MapFile::readBinary(m_mappedFile.data(), m_mappedFile.size(), header, tiles, error))
+		{
+			m_logger->error("Unable to read map '{0}' at '{1}': {2}", m_tag, filePath, error);
+			m_mappedFile.close();
+			return;
 		}
+		m_tiles = tiles;
 	}
+	else
+	{
+		// A text map that fails part way through keeps the tiles that were read, the rest are left empty
+		if (!MapFile::readText(filePath, header, m_tileStorage, error))
+			m_logger->error("Unable to read map '{0}' at '{1}': {2}", m_tag, filePath, error);
+
+		if (m_tileStorage.size() != MapFile::numberOfTiles(header))
+			return;
+		m_tiles = m_tileStorage.data();
+
+		if (!source.empty() && error.empty())
+		{
+			cacheIn->store("maps", key, [&header, this](const std::filesystem::path& entryIn)
+				{
+					std::string writeError;
+					return MapFile::writeBinary(entryIn, header, m_tileStorage.data(), writeError);
+				});
+		}
+	}
+
+	this->setSize(header);
 	m_logger->info("World '{0}' has been built", m_tag);
 }
 
 
 
+void TileMap::setSize(const MapFileHeader& headerIn)
+{
+	m_sizeMap.w = headerIn.width;
+	m_sizeMap.h = headerIn.height;
+	m_sizeTile.w = headerIn.tileWidth;
+	m_sizeTile.h = headerIn.tileHeight;
+	m_numberOfLayers = static_cast<int>(headerIn.numberOfLayers);
+
+	// Every chunk starts at revision 1 so a chunk that has never been built never matches
+	m_sizeChunks.w = (m_sizeMap.w + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	m_sizeChunks.h = (m_sizeMap.h + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	m_chunkRevisions.assign(static_cast<size_t>(m_sizeChunks.w) * m_sizeChunks.h, 1);
+}
+
+
+
 
 
 
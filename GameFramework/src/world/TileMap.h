@@ -5,20 +5,45 @@
 
 
 #include <string>
-#include <map>
 #include <memory>
+#include <vector>
+#include <cstdint>
 
 #include "ITile.h"
+#include "utilities/math/Pos2.hpp"
+#include "utilities/physics/TilePos.h"
+#include "utilities/physics/AxisAlignedBB.h"
+#include "utilities/MappedFile.h"
+#include "world/WorldStreamer.h"
 #include "utilities/Loggers.hpp"
 
 
 
 
+/// <summary>
+/// A grid of tiles stored row by row in one contiguous list, so any tile can be found with a single index
+/// <para>
+/// Maps are loaded from either the text format or the binary format, see MapFile. A binary map's tiles are used straight 
+/// from the memory mapped file, or a binary map can be streamed a chunk at a time around the camera, see WorldStreamer
+/// </para>
+/// </summary>
 class TileMap 
 {
 public:
 
-	TileMap(const std::string &tagIn, const std::string &filePath);
+	/// <summary>
+	/// The width and height of a chunk measured in tiles, each chunk is drawn as one cached mesh
+	/// </summary>
+	static constexpr int CHUNK_SIZE = 32;
+
+
+	/// <summary>
+	/// Creates a tile map that is loaded all at once
+	/// </summary>
+	/// <param name="tagIn"></param>
+	/// <param name="filePath">Path to the tile map file</param>
+	/// <param name="cacheIn">Specifies where converted text maps are cached, text maps are always parsed when it is null</param>
+	TileMap(const std::string &tagIn, const std::string &filePath, class AssetCache* cacheIn = nullptr);
 
 
 
@@ -26,6 +51,17 @@ public:
 
 
 
+	/// <summary>
+	/// Creates a tile map whose chunks are streamed in and out of memory around the camera
+	/// <para>Only binary maps can be streamed, any other map is loaded all at once</para>
+	/// </summary>
+	/// <param name="tagIn"></param>
+	/// <param name="filePath">Path to the binary map file</param>
+	/// <param name="settingsIn"></param>
+	TileMap(const std::string& tagIn, const std::string& filePath, const WorldStreamer::Settings& settingsIn);
+
+
+
 	TileMap(const TileMap &other) = delete;
 
 
@@ -108,6 +144,49 @@ public:
 
 
 
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets the Tile at the specified location or null if that Tile does not exist
+	/// </summary>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	/// <returns></returns>
+	const ITile* getTile(int x, int y) const;
+
+
+
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets the Tile at the specified location in the specified layer or null if that Tile does not exist
+	/// </summary>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	/// <param name="layer">Specifies the layer, layer 0 is the bottom layer</param>
+	/// <returns></returns>
+	ITile* getTile(int x, int y, int layer);
+
+
+
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets the Tile at the specified location in the specified layer or null if that Tile does not exist
+	/// </summary>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	/// <param name="layer">Specifies the layer, layer 0 is the bottom layer</param>
+	/// <returns></returns>
+	const ITile* getTile(int x, int y, int layer) const;
+
+
+
+	/// <summary>
+	/// Gets the number of tile layers in this TileMap
+	/// </summary>
+	/// <returns></returns>
+	int numberOfLayers() const { return m_numberOfLayers; }
+
+
+
 	/// <summary>
 	/// <para>nullable</para>
 	/// Gets the Tile at the specified location or null if that Tile does not exist
@@ -130,13 +209,142 @@ public:
 
 
 
+	/// <summary>
+	/// Gets the position in Global-Space of the Tile at the specified location
+	/// </summary>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	/// <returns></returns>
+	TilePos getTilePos(int x, int y) const;
+
+
+
+	/// <summary>
+	/// Gets the axis aligned bounding box in Global-Space of the Tile at the specified location
+	/// </summary>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	/// <returns></returns>
+	AxisAlignedBB getTileAabb(int x, int y) const;
+
+
+
+	/// <summary>
+	/// Changes the sprite of the Tile at the specified location
+	/// </summary>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	/// <param name="spriteIn">Specifies the new sprite</param>
+	void setTileSprite(int x, int y, unsigned int spriteIn);
+
+
+
+	/// <summary>
+	/// Marks the chunk that holds the specified location as changed so its mesh is rebuilt before it is drawn again
+	/// <para>This must be called after a Tile's appearance is changed through the pointer from TileMap::getTile</para>
+	/// </summary>
+	/// <param name="x">Specifies the X coordinate</param>
+	/// <param name="y">Specifies the Y coordinate</param>
+	void markTileChanged(int x, int y);
+
+
+
+	/// <summary>
+	/// Changes the revision of a streamed chunk that has just arrived so its mesh is built, without marking it as edited
+	/// <para>Only chunks marked through TileMap::markTileChanged are written back to the map file when they are evicted</para>
+	/// </summary>
+	/// <param name="chunkX">Specifies the chunk's X coordinate</param>
+	/// <param name="chunkY">Specifies the chunk's Y coordinate</param>
+	void markChunkArrived(int chunkX, int chunkY);
+
+
+
+	/// <summary>
+	/// Gets the number of chunks across this TileMap
+	/// </summary>
+	/// <returns></returns>
+	int chunksWide() const { return m_sizeChunks.w; }
+
+
+
+	/// <summary>
+	/// Gets the number of chunks down this TileMap
+	/// </summary>
+	/// <returns></returns>
+	int chunksHigh() const { return m_sizeChunks.h; }
+
+
+
+	/// <summary>
+	/// Gets the revision of the specified chunk, which changes every time a Tile in the chunk changes
+	/// </summary>
+	/// <param name="chunkX">Specifies the chunk's X coordinate</param>
+	/// <param name="chunkY">Specifies the chunk's Y coordinate</param>
+	/// <returns></returns>
+	uint32_t chunkRevision(int chunkX, int chunkY) const;
+
+
+
+	/// <summary>
+	/// Gets this TileMap's unique identifier, which is never reused by another TileMap
+	/// </summary>
+	/// <returns></returns>
+	uint32_t getID() const { return m_id; }
+
+
+
+	/// <summary>
+	/// Checks if the specified chunk's tiles are in memory, which is always the case unless this TileMap is streamed
+	/// </summary>
+	/// <param name="chunkX">Specifies the chunk's X coordinate</param>
+	/// <param name="chunkY">Specifies the chunk's Y coordinate</param>
+	/// <returns></returns>
+	bool isChunkLoaded(int chunkX, int chunkY) const;
+
+
+
+	/// <summary>
+	/// Checks if this TileMap's chunks are streamed
+	/// </summary>
+	/// <returns></returns>
+	bool isStreamed() const { return m_streamer != nullptr; }
+
+
+
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets the streamer that pages this TileMap's chunks, or null if this TileMap is not streamed
+	/// </summary>
+	/// <returns></returns>
+	const WorldStreamer* getStreamer() const { return m_streamer.get(); }
+
+
+
+	/// <summary>
+	/// Loads the chunks around the camera and releases distant chunks, this does nothing unless this TileMap is streamed
+	/// <para>Tiles in chunks that are not loaded can not be found, TileMap::getTile returns null for them</para>
+	/// </summary>
+	/// <param name="cameraIn"></param>
+	void stream(const class Camera& cameraIn);
+
+
+
 protected:
 
 	/// <summary>
 	/// Creates a tile map using the given filePath
 	/// </summary>
 	/// <param name="filePath">Path to the tile map file</param>
-	void buildTileMap(const std::string &filePath);
+	/// <param name="cacheIn">Specifies where converted text maps are cached, text maps are always parsed when it is null</param>
+	void buildTileMap(const std::string &filePath, class AssetCache* cacheIn = nullptr);
+
+
+
+	/// <summary>
+	/// Sets the map, tile, and chunk sizes from a map header
+	/// </summary>
+	/// <param name="headerIn"></param>
+	void setSize(const struct MapFileHeader& headerIn);
 
 
 
@@ -144,11 +352,38 @@ private:
 
 	std::string m_tag;
 
+	uint32_t m_id;
+
 	Pos2N m_sizeMap;
 
+	Pos2N m_sizeChunks;
+
+	std::vector<uint32_t> m_chunkRevisions;
+
 	Pos2N m_sizeTile;
 
-	std::map<std::pair<int, int>, ITile> m_tileMap;
+	/// <summary>
+	/// Every tile in row-major order, one layer after the other, the tile at (x, y) in layer 0 is at index y * width + x
+	/// <para>This points into either the tile storage or the mapped file</para>
+	/// </summary>
+	ITile* m_tiles = nullptr;
+
+	int m_numberOfLayers = 0;
+
+	/// <summary>
+	/// Holds the tiles of maps loaded from the text format
+	/// </summary>
+	std::vector<ITile> m_tileStorage;
+
+	/// <summary>
+	/// Holds the tiles of maps loaded from the binary format
+	/// </summary>
+	MappedFile m_mappedFile;
+
+	/// <summary>
+	/// Holds the tiles of streamed maps
+	/// </summary>
+	std::unique_ptr<WorldStreamer> m_streamer;
 
 	std::shared_ptr<spdlog::logger> m_logger;
 };
@@ -4,9 +4,9 @@
 #include <string>
 
 #include "renderer/Renderer.h"
-#include "utilities/physics/TilePos.h"
 #include "world/WorldStack.h"
 #include "world/TileMap.h"
+#include "utilities/AssetCache.h"
 
 
 
@@ -21,7 +21,14 @@ WorldStack::WorldStack()
 
 void WorldStack::pushMap(std::string tileSheetTag, std::string mapFilePath)
 {
-	m_worldStack.emplace_back(std::unique_ptr<TileMap>(new TileMap(tileSheetTag, mapFilePath)));
+	m_worldStack.emplace_back(std::unique_ptr<TileMap>(new TileMap(tileSheetTag, mapFilePath, m_assetCache.get())));
+}
+
+
+
+void WorldStack::pushStreamedMap(std::string tileSheetTag, std::string mapFilePath, const WorldStreamer::Settings& settingsIn)
+{
+	m_worldStack.emplace_back(std::unique_ptr<TileMap>(new TileMap(tileSheetTag, mapFilePath, settingsIn)));
 }
 
 
@@ -36,64 +43,25 @@ void WorldStack::popMap()
 
 
 
-void WorldStack::draw(const TilePos& cameraPos, const Pos2N& windowSize, Renderer& renderer)
+void WorldStack::draw(Renderer& renderer)
 {
-	/*TileMap* world = this->getWorld();
+	TileMap* world = this->getWorld();
 	if (world == nullptr) 
 	{
 		m_logger->critical("Null Pointer exception: Tried to render World, but world stack is empty!");
 		return;
 	}
 
-	//Calculate the top-left visible tile
-	Pos2N tileSize(world->tileWidth(), world->tileHeight());
-	Pos2N numberOfVisibleTiles(windowSize.w/tileSize.w + 1, windowSize.h/tileSize.h);
-	double offsetX = cameraPos.x()/tileSize.w;
-	double offsetY = cameraPos.y()/tileSize.h;
-	
-	//Keep the camera inside the World boundaries
-	if (offsetX < 0) 
-		offsetX = 0;
-
-	if (offsetY < 0) 
-		offsetY = 0;
+	renderer.drawTileMap(*world, world->getTag());
+}
 
-	if (offsetX > static_cast<double>(world->width()) - static_cast<double>(numberOfVisibleTiles.w))
-		offsetX = static_cast<double>(world->width()) - static_cast<double>(numberOfVisibleTiles.w);
 
-	if (offsetY > static_cast<double>(world->height()) - static_cast<double>(numberOfVisibleTiles.h))
-		offsetY = static_cast<double>(world->height()) - static_cast<double>(numberOfVisibleTiles.h);
 
-	Pos2D tileOffset(offsetX, offsetY);
-	//Over rendering is done to prevent artifacts along the edge of the screen
-	for (int y = -1; y < numberOfVisibleTiles.h; y++) 
-	{
-		for (int x = -1; x < numberOfVisibleTiles.w; x++) 
-		{
-			int xCord = x + static_cast<int>(tileOffset.x + 0.5);
-			int yCord = y + static_cast<int>(tileOffset.y + 0.5);
-			/*
-			 * This is to prevent the map from being indexed out of
-			 * also doing this can cause some tiles to be rendered more than once
-			 */
-			/*if (xCord < 0) 
-				xCord = 0;
-			else if (xCord > world->width()) 
-				xCord = world->width();
-
-			if (yCord < 0) 
-				yCord = 0;
-			else if (yCord > world->height()) 
-				yCord = world->height();
-
-			ITile *tile = world->getTile(xCord, yCord);
-
-			if (tile == nullptr) 
-				m_logger->warn("Null Pointer exception: Tried to get tile in WorldStack::draw, but tile does not exist");
-			else
-				renderer.drawSprite(world->getTag(), tile->getPos(), cameraPos, tile->getSprite(), false);
-		}
-	}*/
+void WorldStack::update(const Camera& cameraIn)
+{
+	TileMap* world = this->getWorld();
+	if (world != nullptr)
+		world->stream(cameraIn);
 }
 
 
@@ -10,6 +10,7 @@
 
 #include <utilities/Loggers.hpp>
 #include "utilities/math/Pos2.hpp"
+#include "world/WorldStreamer.h"
 
 
 
@@ -30,6 +31,14 @@ public:
 
 
 
+	/// <summary>
+	/// Keeps converted text maps in the given asset cache, so later launches map them instead of parsing them
+	/// </summary>
+	/// <param name="cacheIn">Specifies the asset cache, or null to stop caching</param>
+	void setAssetCache(std::shared_ptr<class AssetCache> cacheIn) { m_assetCache = std::move(cacheIn); }
+
+
+
 	/// <summary>
 	/// Adds a new map to the back of the stack
 	/// </summary>
@@ -39,6 +48,25 @@ public:
 
 
 
+	/// <summary>
+	/// Adds a new map to the back of the stack whose chunks are streamed in and out of memory around the camera
+	/// <para>Only binary maps can be streamed, any other map is loaded all at once</para>
+	/// </summary>
+	/// <param name="tileSheetTag">The map's/sprite sheet's tag</param>
+	/// <param name="mapFilePath">The location of the binary map</param>
+	/// <param name="settingsIn">Specifies the memory budget and how far around the camera chunks are loaded</param>
+	void pushStreamedMap(std::string tileSheetTag, std::string mapFilePath, const WorldStreamer::Settings& settingsIn = {});
+
+
+
+	/// <summary>
+	/// Streams the chunks of the active map around the camera, this does nothing unless the active map is streamed
+	/// </summary>
+	/// <param name="cameraIn"></param>
+	void update(const class Camera& cameraIn);
+
+
+
 	/// <summary>
 	/// Removes the back map from the stack
 	/// </summary>
@@ -47,12 +75,11 @@ public:
 
 
 	/// <summary>
-	/// Draws the active map to the screen
+	/// Draws the chunks of the active map that the renderer's camera can see, using the map's tag as the name of its tile sheet
+	/// <para>This must be called between Renderer::begin and Renderer::end</para>
 	/// </summary>
-	/// <param name="cameraPos">The position of the camera</param>
-	/// <param name="visibleTiles">Size of the window</param>
 	/// <param name="renderer">Reference to the Renderer</param>
-	void draw(const class TilePos& cameraPos, const Pos2N& windowSize, class Renderer& renderer);
+	void draw(class Renderer& renderer);
 
 
 
@@ -69,6 +96,8 @@ private:
 	std::vector<std::unique_ptr<class TileMap>> m_worldStack;
 
 	std::shared_ptr<spdlog::logger> m_logger;
+
+	std::shared_ptr<class AssetCache> m_assetCache;
 };
 
 
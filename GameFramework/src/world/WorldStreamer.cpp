@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cmath>
+
+#include "world/WorldStreamer.h"
+#include "world/TileMap.h"
+
+
+
+
+WorldStreamer::WorldStreamer(const std::filesystem::path& filepathIn, const MapFileHeader& headerIn, const Settings& settingsIn)
+	: m_filepath(filepathIn), m_header(headerIn), m_settings(settingsIn)
+{
+	m_logger = Loggers::getLog();
+	m_chunksWide = (m_header.width + TileMap::CHUNK_SIZE - 1) / TileMap::CHUNK_SIZE;
+	m_chunksHigh = (m_header.height + TileMap::CHUNK_SIZE - 1) / TileMap::CHUNK_SIZE;
+	m_regionTiles = static_cast<size_t>(TileMap::CHUNK_SIZE) * TileMap::CHUNK_SIZE * m_header.numberOfLayers;
+	m_regions.resize(static_cast<size_t>(m_chunksWide) * m_chunksHigh);
+
+	m_worker = std::thread(&WorldStreamer::loop, this);
+}
+
+
+
+WorldStreamer::~WorldStreamer()
+{
+	for (size_t index : m_resident)
+	{
+		Region& region = m_regions[index];
+		if (region.changed)
+			queue({ Job::Type::Store, index, std::move(region.tiles) });
+	}
+
+	// The worker finishes every queued store before it quits
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_quit = true;
+	}
+	m_signal.notify_all();
+	m_worker.join();
+}
+
+
+
+void WorldStreamer::update(TileMap& mapIn, const glm::vec2& visibleMinIn, const glm::vec2& visibleMaxIn)
+{
+	m_frame++;
+	const size_t regionBytes = m_regionTiles * sizeof(ITile);
+
+	std::vector<Job> loaded;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		loaded.swap(m_loaded);
+	}
+
+	for (Job& job : loaded)
+	{
+		Region& region = m_regions[job.index];
+		region.tiles = std::move(job.tiles);
+		region.pending = false;
+		region.lastUsed = m_frame;
+		m_resident.push_back(job.index);
+		m_statistics.regionsPending--;
+
+		// The new revision makes the renderer build the chunk's mesh the next time it is drawn, the region is not marked as changed 
+		// since nothing has been edited, so an empty region from a failed read is never written over the file
+		const int chunkX = static_cast<int>(job.index % m_chunksWide);
+		const int chunkY = static_cast<int>(job.index / m_chunksWide);
+		mapIn.markChunkArrived(chunkX, chunkY);
+	}
+
+	// The range is clamped as floats so a camera far outside of the map can not overflow the conversion
+	const float chunkWidth = static_cast<float>(m_header.tileWidth * TileMap::CHUNK_SIZE);
+	const float chunkHeight = static_cast<float>(m_header.tileHeight * TileMap::CHUNK_SIZE);
+	const float margin = static_cast<float>(m_settings.margin);
+	const int firstX = static_cast<int>(std::max(std::floor(visibleMinIn.x / chunkWidth) - margin, 0.0f));
+	const int firstY = static_cast<int>(std::max(std::floor(visibleMinIn.y / chunkHeight) - margin, 0.0f));
+	const int lastX = static_cast<int>(std::min(std::floor(visibleMaxIn.x / chunkWidth) + margin, static_cast<float>(m_chunksWide - 1)));
+	const int lastY = static_cast<int>(std::min(std::floor(visibleMaxIn.y / chunkHeight) + margin, static_cast<float>(m_chunksHigh - 1)));
+
+	m_requests.clear();
+	for (int chunkY = firstY; chunkY <= lastY; chunkY++)
+	{
+		for (int chunkX = firstX; chunkX <= lastX; chunkX++)
+		{
+			const size_t index = static_cast<size_t>(chunkY) * m_chunksWide + chunkX;
+			Region& region = m_regions[index];
+			region.lastUsed = m_frame;
+			if (!region.tiles && !region.pending)
+				m_requests.push_back(index);
+		}
+	}
+
+	// The regions closest to the middle of the view are loaded first
+	const glm::vec2 centre = (visibleMinIn + visibleMaxIn) * 0.5f / glm::vec2(chunkWidth, chunkHeight);
+	std::sort(m_requests.begin(), m_requests.end(), [&](size_t a, size_t b)
+	{
+		const glm::vec2 chunkA(static_cast<float>(a % m_chunksWide) + 0.5f, static_cast<float>(a / m_chunksWide) + 0.5f);
+		const glm::vec2 chunkB(static_cast<float>(b % m_chunksWide) + 0.5f, static_cast<float>(b / m_chunksWide) + 0.5f);
+		const glm::vec2 toA = chunkA - centre;
+		const glm::vec2 toB = chunkB - centre;
+		return glm::dot(toA, toA) < glm::dot(toB, toB);
+	});
+
+	for (size_t index : m_requests)
+	{
+		m_regions[index].pending = true;
+		m_statistics.regionsPending++;
+		queue({ Job::Type::Load, index, nullptr });
+	}
+
+	// Only regions that were not used this frame can be released, least recently used first
+	if (m_resident.size() * regionBytes > m_settings.memoryBudget)
+	{
+		std::sort(m_resident.begin(), m_resident.end(), [this](size_t a, size_t b) { return m_regions[a].lastUsed < m_regions[b].lastUsed; });
+
+		size_t evicted = 0;
+		while (evicted < m_resident.size() && (m_resident.size() - evicted) * regionBytes > m_settings.memoryBudget)
+		{
+			const size_t index = m_resident[evicted];
+			Region& region = m_regions[index];
+			if (region.lastUsed == m_frame)
+				break;
+
+			if (region.changed)
+			{
+				queue({ Job::Type::Store, index, std::move(region.tiles) });
+				m_statistics.regionsStored++;
+			}
+			region.tiles.reset();
+			region.changed = false;
+			evicted++;
+		}
+
+		m_resident.erase(m_resident.begin(), m_resident.begin() + evicted);
+		m_statistics.regionsEvicted += evicted;
+	}
+
+	m_statistics.regionsResident = m_resident.size();
+	m_statistics.bytesResident = m_resident.size() * regionBytes;
+}
+
+
+
+ITile* WorldStreamer::getRegion(size_t indexIn) const
+{
+	return indexIn < m_regions.size() ? m_regions[indexIn].tiles.get() : nullptr;
+}
+
+
+
+void WorldStreamer::markChanged(size_t indexIn)
+{
+	if (indexIn < m_regions.size() && m_regions[indexIn].tiles)
+		m_regions[indexIn].changed = true;
+}
+
+
+
+void WorldStreamer::loop()
+{
+	std::fstream mapFile(m_filepath, std::ios::in | std::ios::out | std::ios::binary);
+	const bool writable = mapFile.is_open();
+	if (!writable)
+	{
+		mapFile.open(m_filepath, std::ios::in | std::ios::binary);
+		m_logger->warn("Map '{0}' is read only, changes to its tiles will be lost when they are streamed out", m_filepath.string());
+	}
+
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_signal.wait(lock, [this]() { return m_quit || !m_jobs.empty(); });
+			if (m_jobs.empty())
+				return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+
+		if (job.type == Job::Type::Store)
+		{
+			if (writable && !transfer(mapFile, job))
+				m_logger->error("Unable to write region {0} of map '{1}'", job.index, m_filepath.string());
+			continue;
+		}
+
+		// A region that can not be read is still installed, as empty tiles, so it is not requested again every frame
+		job.tiles = std::make_unique<ITile[]>(m_regionTiles);
+		if (!transfer(mapFile, job))
+			m_logger->error("Unable to read region {0} of map '{1}'", job.index, m_filepath.string());
+
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_loaded.push_back(std::move(job));
+	}
+}
+
+
+
+bool WorldStreamer::transfer(std::fstream& fileIn, Job& jobIn)
+{
+	const int firstX = static_cast<int>(jobIn.index % m_chunksWide) * TileMap::CHUNK_SIZE;
+	const int firstY = static_cast<int>(jobIn.index / m_chunksWide) * TileMap::CHUNK_SIZE;
+	const int columns = std::min(TileMap::CHUNK_SIZE, m_header.width - firstX);
+	const int rows = std::min(TileMap::CHUNK_SIZE, m_header.height - firstY);
+	const std::streamsize rowBytes = static_cast<std::streamsize>(columns * sizeof(ITile));
+
+	fileIn.clear();
+	for (int layer = 0; layer < static_cast<int>(m_header.numberOfLayers); layer++)
+	{
+		for (int row = 0; row < rows; row++)
+		{
+			ITile* tiles = &jobIn.tiles[(static_cast<size_t>(layer) * TileMap::CHUNK_SIZE + row) * TileMap::CHUNK_SIZE];
+			const std::streamoff offset = static_cast<std::streamoff>(MapFile::tileOffset(m_header, firstX, firstY + row, layer));
+			if (jobIn.type == Job::Type::Load)
+			{
+				fileIn.seekg(offset);
+				fileIn.read(reinterpret_cast<char*>(tiles), rowBytes);
+			}
+			else
+			{
+				fileIn.seekp(offset);
+				fileIn.write(reinterpret_cast<const char*>(tiles), rowBytes);
+			}
+
+			if (fileIn.fail())
+				return false;
+		}
+	}
+
+	if (jobIn.type == Job::Type::Store)
+		fileIn.flush();
+	return true;
+}
+
+
+
+void WorldStreamer::queue(Job&& jobIn)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_jobs.push_back(std::move(jobIn));
+	}
+	m_signal.notify_one();
+}
+
+
+
@@ -0,0 +1,231 @@
+#ifndef WorldStreamer_H_
+#define WorldStreamer_H_
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+
+#include <glm/glm.hpp>
+
+#include "world/ITile.h"
+#include "world/MapFile.h"
+#include "utilities/Loggers.hpp"
+
+
+
+
+/// <summary>
+/// Pages the chunks of a binary map in and out of memory around the camera
+/// <para>
+/// Each chunk of the map is a region that is read from the map file on a worker thread. Regions under the camera are
+/// requested every frame, the least recently used regions are released once the resident regions go over the memory budget,
+/// and regions whose tiles were changed are written back to the map file before they are released
+/// </para>
+/// </summary>
+class WorldStreamer
+{
+public:
+
+	struct Settings
+	{
+		/// <summary>
+		/// The most memory that resident regions should use, measured in bytes
+		/// <para>Regions that can be seen are never released, so this can be exceeded when the budget is smaller than the view</para>
+		/// </summary>
+		size_t memoryBudget = 16 * 1024 * 1024;
+
+		/// <summary>
+		/// The number of chunks around the visible area that are loaded before they can be seen
+		/// </summary>
+		int margin = 1;
+	};
+
+
+
+	struct Statistics
+	{
+		size_t regionsResident = 0;
+
+		size_t regionsPending = 0;
+
+		size_t bytesResident = 0;
+
+		/// <summary>
+		/// The total number of regions that have been released
+		/// </summary>
+		size_t regionsEvicted = 0;
+
+		/// <summary>
+		/// The total number of changed regions that have been written back to the map file
+		/// </summary>
+		size_t regionsStored = 0;
+	};
+
+
+
+	/// <summary>
+	/// Starts streaming the given binary map, no region is resident until the first update
+	/// </summary>
+	/// <param name="filepathIn">Specifies the binary map's location</param>
+	/// <param name="headerIn">Specifies the binary map's header</param>
+	/// <param name="settingsIn"></param>
+	WorldStreamer(const std::filesystem::path& filepathIn, const MapFileHeader& headerIn, const Settings& settingsIn);
+
+
+
+	WorldStreamer(const WorldStreamer& other) = delete;
+
+
+
+	WorldStreamer(WorldStreamer&& other) = delete;
+
+
+
+	/// <summary>
+	/// Writes back every changed region and stops the worker thread
+	/// </summary>
+	~WorldStreamer();
+
+
+
+	/// <summary>
+	/// Requests the regions around the visible area, installs the regions that have finished loading, and releases
+	/// regions until the memory budget is met
+	/// </summary>
+	/// <param name="mapIn">Specifies the map being streamed, chunks that arrive are marked as changed so their meshes are rebuilt</param>
+	/// <param name="visibleMinIn">Specifies the top left of the visible area in Global-Space</param>
+	/// <param name="visibleMaxIn">Specifies the bottom right of the visible area in Global-Space</param>
+	void update(class TileMap& mapIn, const glm::vec2& visibleMinIn, const glm::vec2& visibleMaxIn);
+
+
+
+	/// <summary>
+	/// <para>nullable</para>
+	/// Gets a resident region's tiles, layer by layer, each layer is CHUNK_SIZE by CHUNK_SIZE tiles stored row by row
+	/// </summary>
+	/// <param name="indexIn">Specifies the chunk's index, chunkY * chunksWide + chunkX</param>
+	/// <returns>The region's tiles or null if the region is not resident</returns>
+	ITile* getRegion(size_t indexIn) const;
+
+
+
+	/// <summary>
+	/// Marks a region as changed so it is written back to the map file before it is released
+	/// </summary>
+	/// <param name="indexIn">Specifies the chunk's index, chunkY * chunksWide + chunkX</param>
+	void markChanged(size_t indexIn);
+
+
+
+	const Statistics& getStatistics() const { return m_statistics; }
+
+
+
+private:
+
+	struct Region
+	{
+		std::unique_ptr<ITile[]> tiles;
+
+		uint64_t lastUsed = 0;
+
+		bool pending = false;
+
+		bool changed = false;
+	};
+
+
+
+	struct Job
+	{
+		enum class Type : uint8_t
+		{
+			Load,
+			Store
+		};
+
+		Type type = Type::Load;
+
+		size_t index = 0;
+
+		std::unique_ptr<ITile[]> tiles;
+	};
+
+
+
+	/// <summary>
+	/// The worker thread's loop, it runs jobs in the order they were queued so a region's store always finishes before it is loaded again
+	/// </summary>
+	void loop();
+
+
+
+	/// <summary>
+	/// Reads or writes one region of the map file, row by row
+	/// </summary>
+	/// <param name="fileIn"></param>
+	/// <param name="jobIn"></param>
+	/// <returns>True if every row was read or written</returns>
+	bool transfer(std::fstream& fileIn, Job& jobIn);
+
+
+
+	void queue(Job&& jobIn);
+
+
+
+	std::shared_ptr<spdlog::logger> m_logger;
+
+	std::filesystem::path m_filepath;
+
+	MapFileHeader m_header;
+
+	Settings m_settings;
+
+	Statistics m_statistics;
+
+	int m_chunksWide = 0;
+
+	int m_chunksHigh = 0;
+
+	/// <summary>
+	/// The number of tiles in each region, every layer is a full chunk even at the edges of the map
+	/// </summary>
+	size_t m_regionTiles = 0;
+
+	uint64_t m_frame = 0;
+
+	std::vector<Region> m_regions;
+
+	std::vector<size_t> m_resident;
+
+	std::vector<size_t> m_requests;
+
+
+
+	std::thread m_worker;
+
+	std::mutex m_lock;
+
+	std::condition_variable m_signal;
+
+	std::deque<Job> m_jobs;
+
+	/// <summary>
+	/// Loaded regions waiting to be installed by the next update
+	/// </summary>
+	std::vector<Job> m_loaded;
+
+	bool m_quit = false;
+};
+
+
+#endif /* WorldStreamer_H_ */
+
+
+
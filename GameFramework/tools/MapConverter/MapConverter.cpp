@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "world/MapFile.h"
+
+
+
+
+/*
+Converts a text tile map into the binary map format so it can be memory mapped when it is loaded
+
+Usage: MapConverter <input.map> [output.gmap]
+
+When no output is given the output is written next to the input with the binary extension
+*/
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::printf("Usage: MapConverter <input.map> [output%s]\n", MapFile::BINARY_EXTENSION);
+		return 1;
+	}
+
+	const std::filesystem::path input(argv[1]);
+	std::filesystem::path output = argc > 2 ? std::filesystem::path(argv[2]) : input;
+	if (argc <= 2)
+		output.replace_extension(MapFile::BINARY_EXTENSION);
+
+	using Clock = std::chrono::high_resolution_clock;
+	MapFileHeader header;
+	std::vector<ITile> tiles;
+	std::string error;
+
+	auto start = Clock::now();
+	if (!MapFile::readText(input, header, tiles, error))
+	{
+		std::printf("Unable to read '%s': %s\n", input.string().c_str(), error.c_str());
+		return 1;
+	}
+	const double readTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	start = Clock::now();
+	if (!MapFile::writeBinary(output, header, tiles.data(), error))
+	{
+		std::printf("Unable to write '%s': %s\n", output.string().c_str(), error.c_str());
+		return 1;
+	}
+	const double writeTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	std::printf("Converted '%s' to '%s'\n", input.string().c_str(), output.string().c_str());
+	std::printf("  %dx%d tiles, %u layer(s), %zu bytes\n", header.width, header.height, header.numberOfLayers, 
+		sizeof(MapFileHeader) + tiles.size() * sizeof(ITile));
+	std::printf("  read %.3f ms, write %.3f ms\n", readTime, writeTime);
+	return 0;
+}
+
+
+
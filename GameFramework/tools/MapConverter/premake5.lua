@@ -0,0 +1,28 @@
+project "MapConverter"
+	kind "ConsoleApp"
+	language "C++"
+
+	targetdir ("%{wks.location}/dist/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/imt/" .. outputdir .. "/%{prj.name}")
+
+	files 
+	{ 
+		"MapConverter.cpp",
+		"%{wks.location}/GameFramework/src/world/MapFile.h",
+		"%{wks.location}/GameFramework/src/world/MapFile.cpp",
+		"%{wks.location}/GameFramework/src/world/ITile.h",
+		"%{wks.location}/GameFramework/src/world/ITile.cpp"
+	}
+
+	includedirs
+	{ 
+		"%{includes.GameFramework}"
+	}
+
+	filter "system:windows"
+		cppdialect "C++17"
+		staticruntime "On"
+		systemversion "latest"
+
+	filter "configurations:Release"
+		optimize "On"
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "BlockCompression.h"
+
+
+
+
+static uint16_t toRGB565(const float* colorIn)
+{
+	const int r = std::clamp(static_cast<int>(colorIn[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+	const int g = std::clamp(static_cast<int>(colorIn[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+	const int b = std::clamp(static_cast<int>(colorIn[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+
+
+static void fromRGB565(uint16_t colorIn, int* colorOut)
+{
+	const int r = (colorIn >> 11) & 31;
+	const int g = (colorIn >> 5) & 63;
+	const int b = colorIn & 31;
+	colorOut[0] = (r << 3) | (r >> 2);
+	colorOut[1] = (g << 2) | (g >> 4);
+	colorOut[2] = (b << 3) | (b >> 2);
+}
+
+
+
+std::vector<unsigned char> BlockCompression::encodeBC1(const unsigned char* rgbaIn, unsigned int widthIn, unsigned int heightIn)
+{
+	const unsigned int blocksWide = (widthIn + 3) / 4;
+	const unsigned int blocksHigh = (heightIn + 3) / 4;
+	std::vector<unsigned char> blocks(static_cast<size_t>(blocksWide) * blocksHigh * 8);
+
+	unsigned char block[16 * 4];
+	for (unsigned int y = 0; y < blocksHigh; y++)
+	{
+		for (unsigned int x = 0; x < blocksWide; x++)
+		{
+			fetchBlock(rgbaIn, widthIn, heightIn, x, y, block);
+			encodeColorBlock(block, true, &blocks[(static_cast<size_t>(y) * blocksWide + x) * 8]);
+		}
+	}
+	return blocks;
+}
+
+
+
+std::vector<unsigned char> BlockCompression::encodeBC3(const unsigned char* rgbaIn, unsigned int widthIn, unsigned int heightIn)
+{
+	const unsigned int blocksWide = (widthIn + 3) / 4;
+	const unsigned int blocksHigh = (heightIn + 3) / 4;
+	std::vector<unsigned char> blocks(static_cast<size_t>(blocksWide) * blocksHigh * 16);
+
+	unsigned char block[16 * 4];
+	for (unsigned int y = 0; y < blocksHigh; y++)
+	{
+		for (unsigned int x = 0; x < blocksWide; x++)
+		{
+			unsigned char* out = &blocks[(static_cast<size_t>(y) * blocksWide + x) * 16];
+			fetchBlock(rgbaIn, widthIn, heightIn, x, y, block);
+			encodeAlphaBlock(block, out);
+			encodeColorBlock(block, false, out + 8);
+		}
+	}
+	return blocks;
+}
+
+
+
+void BlockCompression::encodeColorBlock(const unsigned char* blockIn, bool allowTransparentIn, unsigned char* out)
+{
+	// Only the texels that will be visible decide the endpoints
+	bool transparent = false;
+	int count = 0;
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; i++)
+	{
+		if (allowTransparentIn && blockIn[i * 4 + 3] < 128)
+		{
+			transparent = true;
+			continue;
+		}
+
+		for (int c = 0; c < 3; c++)
+			mean[c] += blockIn[i * 4 + c];
+		count++;
+	}
+
+	if (count == 0)
+	{
+		// Three color mode with every texel on index 3, which is transparent black
+		const uint8_t bytes[8] = { 0, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF };
+		std::memcpy(out, bytes, 8);
+		return;
+	}
+
+	for (int c = 0; c < 3; c++)
+		mean[c] /= count;
+
+	// The principal axis of the colors is found with a few power iterations on their covariance
+	float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; i++)
+	{
+		if (allowTransparentIn && blockIn[i * 4 + 3] < 128)
+			continue;
+
+		const float r = blockIn[i * 4 + 0] - mean[0];
+		const float g = blockIn[i * 4 + 1] - mean[1];
+		const float b = blockIn[i * 4 + 2] - mean[2];
+		covariance[0] += r * r;
+		covariance[1] += r * g;
+		covariance[2] += r * b;
+		covariance[3] += g * g;
+		covariance[4] += g * b;
+		covariance[5] += b * b;
+	}
+
+	float axis[3] = { 1.0f, 1.0f, 1.0f };
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		const float r = axis[0] * covariance[0] + axis[1] * covariance[1] + axis[2] * covariance[2];
+		const float g = axis[0] * covariance[1] + axis[1] * covariance[3] + axis[2] * covariance[4];
+		const float b = axis[0] * covariance[2] + axis[1] * covariance[4] + axis[2] * covariance[5];
+		const float length = std::max({ std::fabs(r), std::fabs(g), std::fabs(b) });
+		if (length <= 0.0f)
+			break;
+
+		axis[0] = r / length;
+		axis[1] = g / length;
+		axis[2] = b / length;
+	}
+
+	float minProjection = 0.0f, maxProjection = 0.0f;
+	bool first = true;
+	for (int i = 0; i < 16; i++)
+	{
+		if (allowTransparentIn && blockIn[i * 4 + 3] < 128)
+			continue;
+
+		const float projection = (blockIn[i * 4 + 0] - mean[0]) * axis[0] + (blockIn[i * 4 + 1] - mean[1]) * axis[1] + (blockIn[i * 4 + 2] - mean[2]) * axis[2];
+		minProjection = first ? projection : std::min(minProjection, projection);
+		maxProjection = first ? projection : std::max(maxProjection, projection);
+		first = false;
+	}
+
+	const float lengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+	float endpointA[3], endpointB[3];
+	for (int c = 0; c < 3; c++)
+	{
+		endpointA[c] = mean[c] + axis[c] * maxProjection / lengthSquared;
+		endpointB[c] = mean[c] + axis[c] * minProjection / lengthSquared;
+	}
+
+	uint16_t color0 = toRGB565(endpointA);
+	uint16_t color1 = toRGB565(endpointB);
+
+	// Four color mode needs color0 > color1 and three color mode needs color0 <= color1
+	if (transparent ? color0 > color1 : color0 < color1)
+		std::swap(color0, color1);
+
+	int palette[4][3];
+	fromRGB565(color0, palette[0]);
+	fromRGB565(color1, palette[1]);
+	const int numberOfColors = transparent ? 3 : 4;
+	for (int c = 0; c < 3; c++)
+	{
+		if (transparent)
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+		else
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+	}
+
+	uint32_t indices = 0;
+	if (color0 != color1 || transparent)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			uint32_t best = 3;
+			if (!transparent || blockIn[i * 4 + 3] >= 128)
+			{
+				int bestError = -1;
+				for (int entry = 0; entry < numberOfColors; entry++)
+				{
+					const int r = blockIn[i * 4 + 0] - palette[entry][0];
+					const int g = blockIn[i * 4 + 1] - palette[entry][1];
+					const int b = blockIn[i * 4 + 2] - palette[entry][2];
+					const int error = r * r + g * g + b * b;
+					if (bestError < 0 || error < bestError)
+					{
+						bestError = error;
+						best = static_cast<uint32_t>(entry);
+					}
+				}
+			}
+			indices |= best << (i * 2);
+		}
+	}
+
+	out[0] = static_cast<unsigned char>(color0 & 0xFF);
+	out[1] = static_cast<unsigned char>(color0 >> 8);
+	out[2] = static_cast<unsigned char>(color1 & 0xFF);
+	out[3] = static_cast<unsigned char>(color1 >> 8);
+	for (int i = 0; i < 4; i++)
+		out[4 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);
+}
+
+
+
+void BlockCompression::encodeAlphaBlock(const unsigned char* blockIn, unsigned char* out)
+{
+	int alpha0 = 0, alpha1 = 255;
+	for (int i = 0; i < 16; i++)
+	{
+		alpha0 = std::max(alpha0, static_cast<int>(blockIn[i * 4 + 3]));
+		alpha1 = std::min(alpha1, static_cast<int>(blockIn[i * 4 + 3]));
+	}
+
+	out[0] = static_cast<unsigned char>(alpha0);
+	out[1] = static_cast<unsigned char>(alpha1);
+	uint64_t indices = 0;
+	if (alpha0 != alpha1)
+	{
+		// Eight alpha mode, index 0 and 1 are the endpoints and 2-7 are spaced evenly between them
+		int palette[8] = { alpha0, alpha1 };
+		for (int entry = 1; entry < 7; entry++)
+			palette[entry + 1] = ((7 - entry) * alpha0 + entry * alpha1) / 7;
+
+		for (int i = 0; i < 16; i++)
+		{
+			uint64_t best = 0;
+			int bestError = 256;
+			for (int entry = 0; entry < 8; entry++)
+			{
+				const int error = std::abs(blockIn[i * 4 + 3] - palette[entry]);
+				if (error < bestError)
+				{
+					bestError = error;
+					best = static_cast<uint64_t>(entry);
+				}
+			}
+			indices |= best << (i * 3);
+		}
+	}
+
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);
+}
+
+
+
+void BlockCompression::fetchBlock(const unsigned char* rgbaIn, unsigned int widthIn, unsigned int heightIn, unsigned int blockX, unsigned int blockY, unsigned char* blockOut)
+{
+	for (unsigned int y = 0; y < 4; y++)
+	{
+		const unsigned int sourceY = std::min(blockY * 4 + y, heightIn - 1);
+		for (unsigned int x = 0; x < 4; x++)
+		{
+			const unsigned int sourceX = std::min(blockX * 4 + x, widthIn - 1);
+			std::memcpy(&blockOut[(y * 4 + x) * 4], &rgbaIn[(static_cast<size_t>(sourceY) * widthIn + sourceX) * 4], 4);
+		}
+	}
+}
+
+
+
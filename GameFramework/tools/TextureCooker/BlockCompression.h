@@ -0,0 +1,78 @@
+#ifndef BlockCompression_H_
+#define BlockCompression_H_
+
+#include <cstdint>
+#include <vector>
+
+
+
+
+/// <summary>
+/// Encodes RGBA8 images into BC1 and BC3 blocks
+/// <para>
+/// Each 4x4 block's endpoints are taken from the extremes of its colors along their principal axis, then every texel picks
+/// the closest palette entry. Texels past the edge of an image repeat the last row or column
+/// </para>
+/// </summary>
+class BlockCompression
+{
+public:
+
+	BlockCompression() = delete;
+
+
+
+	/// <summary>
+	/// Encodes an image as BC1, texels with an alpha below 128 become fully transparent
+	/// </summary>
+	/// <param name="rgbaIn">Specifies the image's texels, four bytes each</param>
+	/// <param name="widthIn"></param>
+	/// <param name="heightIn"></param>
+	/// <returns>8 bytes per 4x4 block, row by row</returns>
+	static std::vector<unsigned char> encodeBC1(const unsigned char* rgbaIn, unsigned int widthIn, unsigned int heightIn);
+
+
+
+	/// <summary>
+	/// Encodes an image as BC3, which keeps 8 levels of alpha per block
+	/// </summary>
+	/// <param name="rgbaIn">Specifies the image's texels, four bytes each</param>
+	/// <param name="widthIn"></param>
+	/// <param name="heightIn"></param>
+	/// <returns>16 bytes per 4x4 block, row by row</returns>
+	static std::vector<unsigned char> encodeBC3(const unsigned char* rgbaIn, unsigned int widthIn, unsigned int heightIn);
+
+
+
+private:
+
+	/// <summary>
+	/// Writes one 8 byte color block
+	/// </summary>
+	/// <param name="blockIn">Specifies the block's 16 texels, four bytes each</param>
+	/// <param name="allowTransparentIn">Specifies if transparent texels may use BC1's three color mode</param>
+	/// <param name="out"></param>
+	static void encodeColorBlock(const unsigned char* blockIn, bool allowTransparentIn, unsigned char* out);
+
+
+
+	/// <summary>
+	/// Writes one 8 byte alpha block
+	/// </summary>
+	/// <param name="blockIn">Specifies the block's 16 texels, four bytes each</param>
+	/// <param name="out"></param>
+	static void encodeAlphaBlock(const unsigned char* blockIn, unsigned char* out);
+
+
+
+	/// <summary>
+	/// Copies a 4x4 block out of an image, repeating the edge texels past the edge of the image
+	/// </summary>
+	static void fetchBlock(const unsigned char* rgbaIn, unsigned int widthIn, unsigned int heightIn, unsigned int blockX, unsigned int blockY, unsigned char* blockOut);
+};
+
+
+#endif /* BlockCompression_H_ */
+
+
+
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "BlockCompression.h"
+#include "renderer/texture/Image.h"
+#include "renderer/texture/TextureFile.h"
+
+
+
+
+/*
+Halves an RGBA8 level, each texel is the average of the 2x2 texels above it and odd edges repeat their last row or column
+*/
+static std::vector<unsigned char> downsample(const std::vector<unsigned char>& levelIn, unsigned int widthIn, unsigned int heightIn)
+{
+	const unsigned int width = widthIn > 1 ? widthIn / 2 : 1;
+	const unsigned int height = heightIn > 1 ? heightIn / 2 : 1;
+	std::vector<unsigned char> level(static_cast<size_t>(width) * height * 4);
+	for (unsigned int y = 0; y < height; y++)
+	{
+		const unsigned int y0 = std::min(y * 2, heightIn - 1);
+		const unsigned int y1 = std::min(y * 2 + 1, heightIn - 1);
+		for (unsigned int x = 0; x < width; x++)
+		{
+			const unsigned int x0 = std::min(x * 2, widthIn - 1);
+			const unsigned int x1 = std::min(x * 2 + 1, widthIn - 1);
+			for (unsigned int c = 0; c < 4; c++)
+			{
+				const unsigned int sum = levelIn[(static_cast<size_t>(y0) * widthIn + x0) * 4 + c] + levelIn[(static_cast<size_t>(y0) * widthIn + x1) * 4 + c] +
+					levelIn[(static_cast<size_t>(y1) * widthIn + x0) * 4 + c] + levelIn[(static_cast<size_t>(y1) * widthIn + x1) * 4 + c];
+				level[(static_cast<size_t>(y) * width + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+			}
+		}
+	}
+	return level;
+}
+
+
+
+/*
+Cooks an image into the engine's texture format so it can be uploaded without being decoded
+
+Usage: TextureCooker <input.png> [output.gtex] [--format rgba8|bc1|bc3|auto] [--no-mips]
+
+The auto format picks BC1 for images whose alpha is only ever fully opaque or fully transparent and BC3 for everything
+else. When no output is given the output is written next to the input with the cooked extension
+*/
+int main(int argc, char** argv)
+{
+	std::filesystem::path input;
+	std::filesystem::path output;
+	std::string formatName = "auto";
+	bool mipmaps = true;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+			formatName = argv[++i];
+		else if (std::strcmp(argv[i], "--no-mips") == 0)
+			mipmaps = false;
+		else if (input.empty())
+			input = argv[i];
+		else if (output.empty())
+			output = argv[i];
+	}
+
+	if (input.empty() || (formatName != "rgba8" && formatName != "bc1" && formatName != "bc3" && formatName != "auto"))
+	{
+		std::printf("Usage: TextureCooker <input.png> [output%s] [--format rgba8|bc1|bc3|auto] [--no-mips]\n", TextureFile::EXTENSION);
+		return 1;
+	}
+
+	if (output.empty())
+	{
+		output = input;
+		output.replace_extension(TextureFile::EXTENSION);
+	}
+
+	using Clock = std::chrono::high_resolution_clock;
+	auto start = Clock::now();
+	Image image = Image::load(input);
+	if (!image.isValid() || image.isCompressed())
+	{
+		std::printf("Unable to read '%s'\n", input.string().c_str());
+		return 1;
+	}
+	const double readTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	const unsigned int width = image.width();
+	const unsigned int height = image.height();
+	const size_t numberOfTexels = static_cast<size_t>(width) * height;
+	std::vector<std::vector<unsigned char>> levels(1, std::vector<unsigned char>(numberOfTexels * 4));
+	bool binaryAlpha = true;
+	for (size_t i = 0; i < numberOfTexels; i++)
+	{
+		const unsigned char* texel = image.data() + i * image.channels();
+		unsigned char* rgba = &levels[0][i * 4];
+		for (unsigned int c = 0; c < 4; c++)
+		{
+			if (image.channels() >= 3)
+				rgba[c] = c < image.channels() ? texel[c] : 255;
+			else
+				rgba[c] = c < 3 ? texel[0] : (image.channels() == 2 ? texel[1] : 255);
+		}
+		binaryAlpha = binaryAlpha && (rgba[3] == 0 || rgba[3] == 255);
+	}
+
+	TextureFile::Format format = TextureFile::Format::RGBA8;
+	if (formatName == "bc1" || (formatName == "auto" && binaryAlpha))
+		format = TextureFile::Format::BC1;
+	else if (formatName == "bc3" || formatName == "auto")
+		format = TextureFile::Format::BC3;
+
+	start = Clock::now();
+	const unsigned int numberOfLevels = mipmaps ? TextureFile::numberOfLevels(width, height) : 1;
+	for (unsigned int level = 1; level < numberOfLevels; level++)
+	{
+		const unsigned int levelWidth = std::max(width >> (level - 1), 1u);
+		const unsigned int levelHeight = std::max(height >> (level - 1), 1u);
+		levels.push_back(downsample(levels.back(), levelWidth, levelHeight));
+	}
+
+	size_t cookedSize = 0;
+	for (unsigned int level = 0; level < numberOfLevels; level++)
+	{
+		const unsigned int levelWidth = std::max(width >> level, 1u);
+		const unsigned int levelHeight = std::max(height >> level, 1u);
+		if (format == TextureFile::Format::BC1)
+			levels[level] = BlockCompression::encodeBC1(levels[level].data(), levelWidth, levelHeight);
+		else if (format == TextureFile::Format::BC3)
+			levels[level] = BlockCompression::encodeBC3(levels[level].data(), levelWidth, levelHeight);
+		cookedSize += levels[level].size();
+	}
+	const double cookTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	start = Clock::now();
+	std::string error;
+	if (!TextureFile::write(output, format, width, height, levels, error))
+	{
+		std::printf("Unable to write '%s': %s\n", output.string().c_str(), error.c_str());
+		return 1;
+	}
+	const double writeTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	static const char* formatNames[] = { "RGBA8", "BC1", "BC3", "BC7" };
+	std::printf("Cooked '%s' to '%s'\n", input.string().c_str(), output.string().c_str());
+	std::printf("  %ux%u %s, %u level(s), %zu bytes of texels from %zu\n", width, height, formatNames[static_cast<uint32_t>(format)], 
+		numberOfLevels, cookedSize, numberOfTexels * 4);
+	std::printf("  read %.3f ms, cook %.3f ms, write %.3f ms\n", readTime, cookTime, writeTime);
+	return 0;
+}
@@ -0,0 +1,32 @@
+project "TextureCooker"
+	kind "ConsoleApp"
+	language "C++"
+
+	targetdir ("%{wks.location}/dist/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/imt/" .. outputdir .. "/%{prj.name}")
+
+	files 
+	{ 
+		"TextureCooker.cpp",
+		"BlockCompression.h",
+		"BlockCompression.cpp",
+		"%{wks.location}/GameFramework/src/renderer/texture/Image.h",
+		"%{wks.location}/GameFramework/src/renderer/texture/Image.cpp",
+		"%{wks.location}/GameFramework/src/renderer/texture/TextureFile.h",
+		"%{wks.location}/GameFramework/src/renderer/texture/TextureFile.cpp",
+		"%{wks.location}/depd/stb/stb_image/stb_image.cpp"
+	}
+
+	includedirs
+	{ 
+		"%{includes.GameFramework}",
+		"%{includes.stb_image}"
+	}
+
+	filter "system:windows"
+		cppdialect "C++17"
+		staticruntime "On"
+		systemversion "latest"
+
+	filter "configurations:Release"
+		optimize "On"
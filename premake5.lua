@@ -21,4 +21,7 @@ include "depd/glad"
 include "depd/glm-0.9.9.8"
 include "depd/ImGui"
 include "GameFramework"
+include "GameFramework/benchmark"
+include "GameFramework/tools/MapConverter"
+include "GameFramework/tools/TextureCooker"
 include "BlockForge"
\ No newline at end of file